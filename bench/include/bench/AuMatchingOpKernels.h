@@ -0,0 +1,35 @@
+#ifndef _BENCH_AUMATCHINGOPKERNELS_H_
+#define _BENCH_AUMATCHINGOPKERNELS_H_
+
+//APP
+#include <app/calcul/AuMatchingOp.h>
+
+
+namespace bench{
+
+	/// @brief Acces aux noyaux de calcul prives de app::calcul::AuMatchingOp
+	class AuMatchingOpKernels
+	{
+	public:
+
+		/// @brief
+		static double GetScore( double refAngle, double angle, double distance )
+		{
+			return app::calcul::AuMatchingOp::_getScore( refAngle, angle, distance );
+		}
+
+		/// @brief
+		static int FindIndex(
+			const ign::geometry::LineString & ls, 
+			size_t startIndex,
+			const ign::geometry::Point & refPoint,
+			double angle,
+			double searchDistance
+		) {
+			return app::calcul::AuMatchingOp::_findIndex( ls, startIndex, refPoint, angle, searchDistance );
+		}
+	};
+
+}
+
+#endif
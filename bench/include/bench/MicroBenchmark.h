@@ -0,0 +1,138 @@
+#ifndef _BENCH_MICROBENCHMARK_H_
+#define _BENCH_MICROBENCHMARK_H_
+
+//STL
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+//BENCH
+#include <bench/PerfCounters.h>
+
+
+namespace bench{
+
+	/// @brief Empeche le compilateur d'eliminer le calcul d'une valeur non utilisee
+	template< typename T >
+	inline void doNotOptimize( T const& value )
+	{
+		asm volatile( "" : : "r,m"( value ) : "memory" );
+	}
+
+	/// @brief Etat d'une execution de micro-benchmark : fournit les arguments de la
+	/// fixture et pilote la boucle chronometree.
+	class MicroBenchmarkState
+	{
+	public:
+
+		/// @brief
+		/// @param maxIterations Nombre d'iterations de la boucle chronometree
+		/// @param vArgs Arguments de la fixture
+		/// @param counters Compteurs materiels actives en meme temps que le chronometre
+		/// (optionnel)
+		MicroBenchmarkState( 
+			size_t maxIterations, 
+			std::vector< long > const& vArgs,
+			PerfCounters* counters = 0
+		);
+
+		/// @brief Argument de la fixture
+		long arg( size_t i ) const;
+
+		/// @brief A appeler en condition de boucle : demarre le chronometre au
+		/// premier appel et l'arrete apres la derniere iteration
+		bool keepRunning();
+
+		/// @brief Suspend le chronometre (preparation des donnees d'une iteration)
+		void pauseTiming();
+
+		/// @brief Relance le chronometre
+		void resumeTiming();
+
+		/// @brief Nombre d'elements traites par iteration (debit reporte en items/s)
+		void setItemsPerIteration( size_t items );
+
+		/// @brief
+		size_t iterations() const { return _maxIterations; }
+
+		/// @brief Duree chronometree (secondes)
+		double elapsed() const { return _elapsed; }
+
+		/// @brief
+		size_t itemsPerIteration() const { return _itemsPerIteration; }
+
+	private:
+		//--
+		typedef std::chrono::steady_clock                  clock;
+		//--
+		size_t                                             _maxIterations;
+		//--
+		size_t                                             _iteration;
+		//--
+		std::vector< long >                                _vArgs;
+		//--
+		clock::time_point                                  _start;
+		//--
+		double                                             _elapsed;
+		//--
+		bool                                               _running;
+		//--
+		size_t                                             _itemsPerIteration;
+		//--
+		PerfCounters*                                      _counters;
+	};
+
+	//--
+	typedef std::function< void ( MicroBenchmarkState & ) > MicroBenchmarkFunction;
+
+	/// @brief Registre de micro-benchmarks parametres. Chaque benchmark est execute
+	/// pour chacun de ses jeux d'arguments, le nombre d'iterations etant calibre pour
+	/// atteindre une duree minimale de mesure.
+	class MicroBenchmarkRegistry
+	{
+	public:
+
+		/// @brief Enregistre un benchmark
+		/// @param name Nom du benchmark
+		/// @param vArgNames Noms des arguments de la fixture
+		/// @param vvArgs Jeux d'arguments
+		/// @param function Corps du benchmark
+		void add(
+			std::string const& name,
+			std::vector< std::string > const& vArgNames,
+			std::vector< std::vector< long > > const& vvArgs,
+			MicroBenchmarkFunction function
+		);
+
+		/// @brief Execute les benchmarks dont le nom contient filter
+		/// @param filter Filtre sur le nom des benchmarks
+		/// @param minTime Duree minimale de mesure (secondes)
+		/// @param os Flux de sortie du rapport
+		/// @param counters Si non nul, les compteurs materiels sont reportes par
+		/// iteration a cote des temps
+		/// @return nombre de benchmarks executes
+		size_t run(
+			std::string const& filter,
+			double minTime,
+			std::ostream & os,
+			PerfCounters* counters = 0
+		) const;
+
+	private:
+		//--
+		struct Entry
+		{
+			std::string                                    name;
+			std::vector< std::string >                     vArgNames;
+			std::vector< std::vector< long > >             vvArgs;
+			MicroBenchmarkFunction                         function;
+		};
+		//--
+		std::vector< Entry >                               _vEntries;
+	};
+
+}
+
+#endif
@@ -0,0 +1,93 @@
+#ifndef _BENCH_PERFCOUNTERS_H_
+#define _BENCH_PERFCOUNTERS_H_
+
+//STL
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+
+namespace bench{
+
+	/// @brief Valeurs des compteurs materiels (-1 si le compteur n'est pas disponible)
+	struct PerfCounterValues
+	{
+		//--
+		enum Counter {
+			CYCLES,
+			INSTRUCTIONS,
+			CACHE_MISSES,
+			BRANCH_MISSES,
+			PAGE_FAULTS,
+			NUM_COUNTERS
+		};
+
+		//--
+		int64_t                                            values[NUM_COUNTERS];
+
+		/// @brief
+		PerfCounterValues()
+		{
+			for ( size_t i = 0 ; i < NUM_COUNTERS ; ++i ) values[i] = -1;
+		}
+
+		/// @brief
+		static const char* Name( size_t counter );
+
+		/// @brief Instructions par cycle (-1 si non disponible)
+		double ipc() const;
+
+		/// @brief Ecrit les valeurs separees par des espaces
+		void write( std::ostream & os ) const;
+
+		/// @brief Lit les valeurs ecrites par write
+		void read( std::istream & is );
+	};
+
+	/// @brief Compteurs materiels (cycles, instructions, defauts de cache, erreurs de
+	/// prediction de branchement) et logiciels (defauts de page) du processus courant,
+	/// collectes via perf_event_open (Linux). Les compteurs s'accumulent entre les
+	/// appels a enable et disable. Les compteurs que le noyau refuse d'ouvrir
+	/// (perf_event_paranoid, machine virtuelle...) sont simplement ignores. Les
+	/// compteurs forment un groupe : ils sont programmes, demarres et lus ensemble.
+	class PerfCounters
+	{
+	public:
+
+		/// @brief
+		PerfCounters();
+
+		/// @brief
+		~PerfCounters();
+
+		/// @brief Indique si au moins un compteur a pu etre ouvert
+		bool isAvailable() const;
+
+		/// @brief Remet les compteurs a zero
+		void reset();
+
+		/// @brief Demarre le comptage
+		void enable();
+
+		/// @brief Suspend le comptage
+		void disable();
+
+		/// @brief Valeurs accumulees (corrigees du multiplexage)
+		PerfCounterValues read() const;
+
+	private:
+		//--
+		int                                                _vFd[PerfCounterValues::NUM_COUNTERS];
+		//-- meneur du groupe (premier compteur ouvert)
+		int                                                _leaderFd;
+
+	private:
+		//--
+		PerfCounters( PerfCounters const& );
+		//--
+		PerfCounters& operator=( PerfCounters const& );
+	};
+
+}
+
+#endif
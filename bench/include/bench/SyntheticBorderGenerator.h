@@ -0,0 +1,76 @@
+#ifndef _BENCH_SYNTHETICBORDERGENERATOR_H_
+#define _BENCH_SYNTHETICBORDERGENERATOR_H_
+
+//STL
+#include <vector>
+
+//SOCLE
+#include <ign/geometry.h>
+
+
+namespace bench{
+
+	/// @brief Parametres de generation d'un jeu de donnees frontalier synthetique
+	struct SyntheticBorderParameters
+	{
+		/// @brief Nombre (approximatif) d'unites administratives
+		size_t                                             numAu;
+		/// @brief Nombre (approximatif) de sommets de la frontiere dentelee
+		size_t                                             numBoundaryVertices;
+		/// @brief Cote d'une cellule de la grille d'unites administratives
+		double                                             cellSize;
+		/// @brief Amplitude de la dentelure de la frontiere (en fraction de cellSize, < 0.5)
+		double                                             jaggedness;
+		/// @brief Decalage de la frontiere internationale par rapport aux unites administratives
+		double                                             boundaryOffset;
+		/// @brief Amplitude du bruit aleatoire applique aux sommets de la frontiere internationale
+		double                                             boundaryNoise;
+		/// @brief Graine du generateur aleatoire
+		unsigned int                                       seed;
+
+		/// @brief
+		SyntheticBorderParameters():
+			numAu( 1000 ),
+			numBoundaryVertices( 10000 ),
+			cellSize( 1000 ),
+			jaggedness( 0.2 ),
+			boundaryOffset( 5 ),
+			boundaryNoise( 2 ),
+			seed( 42 )
+		{
+		}
+	};
+
+	/// @brief Jeu de donnees frontalier synthetique.
+	/// Le pays est un rectangle dont le cote ouest est une cote et dont le cote
+	/// est est une frontiere dentelee. Il est pave par une grille d'unites
+	/// administratives en accostage parfait avec le landmask. La frontiere
+	/// internationale (cotes sud, est et nord) et la cote sont decalees et bruitees
+	/// par rapport au landmask.
+	struct SyntheticBorderDataset
+	{
+		//--
+		ign::geometry::MultiPolygon                        landmask;
+		//--
+		ign::geometry::LineString                          coastline;
+		//--
+		ign::geometry::LineString                          boundary;
+		//--
+		std::vector< ign::geometry::MultiPolygon >         vAu;
+	};
+
+	/// @brief Generateur de jeux de donnees frontaliers synthetiques reproductibles
+	class SyntheticBorderGenerator
+	{
+	public:
+
+		/// @brief Genere un jeu de donnees (deterministe pour une graine donnee)
+		static void Generate(
+			SyntheticBorderParameters const& params,
+			SyntheticBorderDataset & dataset
+		);
+	};
+
+}
+
+#endif
@@ -0,0 +1,53 @@
+#ifndef _BENCH_KERNELFIXTURES_H_
+#define _BENCH_KERNELFIXTURES_H_
+
+//STL
+#include <vector>
+
+//SOCLE
+#include <ign/geometry.h>
+
+
+namespace bench{
+
+	/// @brief Anneau (ferme) approximant un cercle dont les sommets sont bruites
+	/// radialement
+	/// @param numPoints Nombre de sommets distincts
+	/// @param radius Rayon
+	/// @param noise Amplitude du bruit radial
+	/// @param seed Graine du generateur aleatoire
+	/// @param xCenter Abscisse du centre
+	ign::geometry::LineString makeRing(
+		size_t numPoints,
+		double radius,
+		double noise,
+		unsigned int seed,
+		double xCenter = 0
+	);
+
+	/// @brief Copie de ls dont numParts portions sont decalees de offset : les
+	/// portions non decalees touchent ls, les autres non
+	ign::geometry::LineString makePartiallyShiftedCopy(
+		ign::geometry::LineString const& ls,
+		size_t numParts,
+		double offset
+	);
+
+	/// @brief Decoupe ls en numGroups parties consecutives (partageant leurs extremites)
+	void splitIntoParts(
+		ign::geometry::LineString const& ls,
+		size_t numGroups,
+		std::vector< ign::geometry::LineString > & vParts
+	);
+
+	/// @brief Alignement de numPolygons polygones disjoints dont le contour est un
+	/// anneau de ringSize sommets
+	ign::geometry::MultiPolygon makeMultiPolygon(
+		size_t numPolygons,
+		size_t ringSize,
+		unsigned int seed
+	);
+
+}
+
+#endif
@@ -0,0 +1,44 @@
+#ifndef _BENCH_SYNTHETICCONTEXT_H_
+#define _BENCH_SYNTHETICCONTEXT_H_
+
+//STL
+#include <string>
+
+//APP
+#include <app/io/MemoryDataSource.h>
+
+//BENCH
+#include <bench/SyntheticBorderGenerator.h>
+
+
+namespace bench{
+
+	/// @brief Noms des tables de la source de donnees en memoire
+	struct SyntheticTables
+	{
+		static std::string Landmask() { return "landmask"; }
+		static std::string Boundary() { return "international_boundary_line"; }
+		static std::string Area() { return "administrative_unit_area"; }
+		static std::string Coast() { return "administrative_unit_area_coast"; }
+		static std::string NoCoast() { return "administrative_unit_area_nocoast"; }
+	};
+
+	/// @brief Renseigne les parametres EPG et les parametres du theme (valeurs
+	/// par defaut de theme_parameters.ini) pour un traitement sur les tables
+	/// synthetiques et initialise les logs dans logDirectory.
+	void initSyntheticContext(
+		std::string const& countryCode,
+		std::string const& logDirectory
+	);
+
+	/// @brief Charge un jeu de donnees synthetique dans une source de donnees
+	/// en memoire (sous les noms de SyntheticTables).
+	void loadSyntheticDataset(
+		SyntheticBorderDataset const& dataset,
+		std::string const& countryCode,
+		app::io::MemoryDataSource & dataSource
+	);
+
+}
+
+#endif
@@ -0,0 +1,268 @@
+//STL
+#include <chrono>
+#include <cstdio>
+#include <iomanip>
+
+//SYSTEM
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+//BOOST
+#include <boost/filesystem.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/program_options.hpp>
+
+//EPG
+#include <epg/tools/StringTools.h>
+
+//APP
+#include <app/calcul/AuMatchingOp.h>
+#include <app/calcul/InitLandmaskCoastOp.h>
+#include <app/calcul/InitLandmaskNoCoastOp.h>
+#include <app/io/DataSourceManager.h>
+#include <app/utils/createCoastNoCoastTables.h>
+
+//BENCH
+#include <bench/PerfCounters.h>
+#include <bench/SyntheticBorderGenerator.h>
+#include <bench/syntheticContext.h>
+
+namespace po = boost::program_options;
+
+namespace {
+
+    //-- chronometre et compteurs materiels (optionnels) d'une phase
+    class PhaseRecorder
+    {
+    public:
+        //--
+        PhaseRecorder( bench::PerfCounters* counters ): _counters( counters ) {}
+
+        //--
+        void begin()
+        {
+            if ( _counters ) {
+                _counters->reset();
+                _counters->enable();
+            }
+            _start = std::chrono::steady_clock::now();
+        }
+
+        //--
+        double end( std::string const& phase )
+        {
+            double const elapsed = std::chrono::duration< double >( std::chrono::steady_clock::now() - _start ).count();
+            if ( _counters ) {
+                _counters->disable();
+                _vPhases.push_back( std::make_pair( phase, _counters->read() ) );
+            }
+            return elapsed;
+        }
+
+        //--
+        void write( std::ostream & os ) const
+        {
+            for ( size_t i = 0 ; i < _vPhases.size() ; ++i ) {
+                os << "\n" << _vPhases[i].first << " ";
+                _vPhases[i].second.write( os );
+            }
+        }
+
+    private:
+        //--
+        bench::PerfCounters*                                                  _counters;
+        //--
+        std::chrono::steady_clock::time_point                                 _start;
+        //--
+        std::vector< std::pair< std::string, bench::PerfCounterValues > >     _vPhases;
+    };
+
+    //--
+    std::string runScenario(
+        bench::SyntheticBorderParameters const& params,
+        std::string const& countryCode,
+        std::string const& logDirectory,
+        bool withCounters
+    ) {
+        bench::initSyntheticContext( countryCode, logDirectory );
+
+        app::io::MemoryDataSource* dataSource = new app::io::MemoryDataSource();
+        app::io::DataSourceManagerS::getInstance()->setDataSource( dataSource );
+
+        // compteurs par phase et compteurs de l'ensemble du traitement
+        bench::PerfCounters phaseCounters, runCounters;
+        PhaseRecorder recorder( withCounters ? &phaseCounters : 0 );
+        PhaseRecorder runRecorder( withCounters ? &runCounters : 0 );
+        runRecorder.begin();
+
+        recorder.begin();
+        bench::SyntheticBorderDataset dataset;
+        bench::SyntheticBorderGenerator::Generate( params, dataset );
+        bench::loadSyntheticDataset( dataset, countryCode, *dataSource );
+        double const generationTime = recorder.end( "gen" );
+
+        size_t const numAu = dataset.vAu.size();
+        size_t const numBoundaryVertices = dataset.boundary.numPoints();
+        dataset = bench::SyntheticBorderDataset();
+
+        recorder.begin();
+        app::utils::createCoastTable();
+        app::calcul::InitLandmaskCoastOp::Compute( countryCode, false );
+        double const time610 = recorder.end( "610" );
+
+        recorder.begin();
+        app::utils::createNoCoastTable();
+        app::calcul::InitLandmaskNoCoastOp::Compute( countryCode, false );
+        double const time620 = recorder.end( "620" );
+
+        recorder.begin();
+        app::calcul::AuMatchingOp::Compute( countryCode, false );
+        double const time630 = recorder.end( "630" );
+
+        runRecorder.end( "total" );
+
+        std::ostringstream ss;
+        ss << std::fixed << std::setprecision(3)
+            << numAu << " " << numBoundaryVertices << " " 
+            << generationTime << " " << time610 << " " << time620 << " " << time630;
+        recorder.write( ss );
+        runRecorder.write( ss );
+        return ss.str();
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    std::string     sizes = "1000:10000,10000:100000,100000:1000000,1000000:10000000";
+    std::string     logDirectory = "bench_log";
+    std::string     countryCode = "xx";
+    bool            withCounters = false;
+    bench::SyntheticBorderParameters params;
+
+    po::options_description desc("Allowed options");
+    desc.add_options()
+        ("help", "produce help message")
+        ("sizes", po::value< std::string >(&sizes)                          , "list of numAu:numBoundaryVertices (comma separated)" )
+        ("cell-size", po::value< double >(&params.cellSize)                 , "administrative unit cell size" )
+        ("jaggedness", po::value< double >(&params.jaggedness)              , "boundary jaggedness (fraction of cell size)" )
+        ("offset", po::value< double >(&params.boundaryOffset)              , "international boundary offset" )
+        ("noise", po::value< double >(&params.boundaryNoise)                , "international boundary noise" )
+        ("seed", po::value< unsigned int >(&params.seed)                    , "random seed" )
+        ("log", po::value< std::string >(&logDirectory)                     , "log directory" )
+        ("counters", po::bool_switch(&withCounters)                         , "report hardware counters per phase (perf_event_open)" )
+    ;
+
+    po::variables_map vm;
+    po::store( po::parse_command_line(argc, argv, desc), vm );
+    po::notify( vm );
+
+    if ( vm.count( "help" ) ) {
+        std::cout << desc << std::endl;
+        return 1;
+    }
+
+    boost::filesystem::create_directories( logDirectory );
+
+    std::vector< std::string > vSizes;
+    epg::tools::StringTools::Split( sizes, ",", vSizes );
+
+    std::cout << std::setw(10) << "num_au" << std::setw(12) << "num_vertex" 
+        << std::setw(12) << "gen_s" << std::setw(12) << "610_s" << std::setw(12) << "620_s" << std::setw(12) << "630_s" 
+        << std::setw(14) << "peak_rss_mb" << std::endl;
+
+    std::ostringstream ssCounters;
+    int returnValue = 0;
+    for ( size_t i = 0 ; i < vSizes.size() ; ++i ) {
+        std::vector< std::string > vSize;
+        epg::tools::StringTools::Split( vSizes[i], ":", vSize );
+        if ( vSize.size() != 2 ) {
+            std::cerr << "invalid size '" << vSizes[i] << "'" << std::endl;
+            return 1;
+        }
+        params.numAu = boost::lexical_cast< size_t >( vSize[0] );
+        params.numBoundaryVertices = boost::lexical_cast< size_t >( vSize[1] );
+
+        // chaque taille est traitee dans un processus dedie afin de mesurer
+        // son pic memoire de maniere isolee
+        int fd[2];
+        if ( pipe( fd ) != 0 ) {
+            std::cerr << "pipe failed" << std::endl;
+            return 1;
+        }
+
+        pid_t pid = fork();
+        if ( pid == 0 ) {
+            close( fd[0] );
+            std::string const scenarioDirectory = logDirectory + "/" + vSizes[i];
+            boost::filesystem::create_directories( scenarioDirectory );
+            std::freopen( ( scenarioDirectory + "/stdout.txt" ).c_str(), "w", stdout );
+
+            std::string result;
+            int status = 0;
+            try {
+                result = runScenario( params, countryCode, scenarioDirectory, withCounters );
+            } catch( ign::Exception &e ) {
+                result = std::string( "error " ) + e.diagnostic();
+                status = 1;
+            } catch( std::exception &e ) {
+                result = std::string( "error " ) + e.what();
+                status = 1;
+            }
+            std::fflush( stdout );
+            ssize_t written = write( fd[1], result.c_str(), result.size() );
+            close( fd[1] );
+            _exit( written < 0 ? 1 : status );
+        }
+        close( fd[1] );
+
+        std::string result;
+        char buffer[256];
+        ssize_t n;
+        while ( ( n = read( fd[0], buffer, sizeof(buffer) ) ) > 0 ) result.append( buffer, n );
+        close( fd[0] );
+
+        int status = 0;
+        struct rusage usage;
+        wait4( pid, &status, 0, &usage );
+
+        if ( !WIFEXITED(status) || WEXITSTATUS(status) != 0 ) {
+            std::cerr << vSizes[i] << " : " << result << std::endl;
+            returnValue = 1;
+            continue;
+        }
+
+        std::istringstream is( result );
+        size_t numAu, numVertex;
+        double timeGen, time610, time620, time630;
+        is >> numAu >> numVertex >> timeGen >> time610 >> time620 >> time630;
+
+        std::cout << std::fixed << std::setprecision(3)
+            << std::setw(10) << numAu << std::setw(12) << numVertex 
+            << std::setw(12) << timeGen << std::setw(12) << time610 << std::setw(12) << time620 << std::setw(12) << time630
+            << std::setw(14) << usage.ru_maxrss / 1024. << std::endl;
+
+        std::string phase;
+        while ( is >> phase ) {
+            bench::PerfCounterValues values;
+            values.read( is );
+            ssCounters << std::setw(10) << numAu << std::setw(8) << phase;
+            for ( size_t c = 0 ; c < bench::PerfCounterValues::NUM_COUNTERS ; ++c ) {
+                ssCounters << std::setw(16);
+                if ( values.values[c] < 0 ) ssCounters << "-";
+                else ssCounters << values.values[c];
+            }
+            if ( values.ipc() < 0 ) ssCounters << std::setw(8) << "-" << std::endl;
+            else ssCounters << std::setw(8) << std::fixed << std::setprecision(2) << values.ipc() << std::endl;
+        }
+    }
+
+    if ( withCounters ) {
+        std::cout << std::endl << std::setw(10) << "num_au" << std::setw(8) << "phase";
+        for ( size_t c = 0 ; c < bench::PerfCounterValues::NUM_COUNTERS ; ++c )
+            std::cout << std::setw(16) << bench::PerfCounterValues::Name( c );
+        std::cout << std::setw(8) << "ipc" << std::endl << ssCounters.str();
+    }
+
+    return returnValue;
+}
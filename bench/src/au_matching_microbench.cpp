@@ -0,0 +1,311 @@
+//STL
+#include <iostream>
+
+//BOOST
+#include <boost/program_options.hpp>
+
+//APP
+#include <app/detail/extractNotTouchingParts.h>
+#include <app/detail/getSubString.h>
+#include <app/detail/refining.h>
+#include <app/tools/MonotonicArena.h>
+#include <app/tools/SegmentIndexedGeometry.h>
+
+//BENCH
+#include <bench/AuMatchingOpKernels.h>
+#include <bench/kernelFixtures.h>
+#include <bench/MicroBenchmark.h>
+
+namespace po = boost::program_options;
+
+namespace {
+
+    //-- tailles d'anneau x nombre de groupes
+    std::vector< std::vector< long > > ringGroupArgs()
+    {
+        std::vector< std::vector< long > > vvArgs;
+        long const vRingSizes[] = { 64, 1024, 16384 };
+        long const vGroups[] = { 1, 8 };
+        for ( long ringSize : vRingSizes )
+            for ( long groups : vGroups )
+                vvArgs.push_back( { ringSize, groups } );
+        return vvArgs;
+    }
+
+    //-- decalage (> seuil de contact de 0.1) des portions non touchantes
+    double const SHIFT = 1.;
+
+    //--
+    void registerExtractNotTouchingParts( bench::MicroBenchmarkRegistry & registry )
+    {
+        registry.add( "detail::extractNotTouchingParts<LineString>", { "ring_size", "groups" }, ringGroupArgs(),
+            []( bench::MicroBenchmarkState & state ) {
+                ign::geometry::LineString ring = bench::makeRing( state.arg(0), 1000, 1, 1 );
+                std::vector< ign::geometry::LineString > vParts;
+                bench::splitIntoParts( bench::makePartiallyShiftedCopy( ring, 4, SHIFT ), state.arg(1), vParts );
+
+                app::tools::SegmentIndexedGeometryCollection refGeom;
+                for ( size_t i = 0 ; i < vParts.size() ; ++i ) refGeom.addGeometry( &vParts[i], i );
+
+                while ( state.keepRunning() ) {
+                    std::pmr::vector< std::pair< int, int > > vNotTouchingParts;
+                    std::pmr::vector< int > vTouchingPoints;
+                    app::detail::extractNotTouchingParts( &refGeom, ring, vNotTouchingParts, &vTouchingPoints );
+                    bench::doNotOptimize( vNotTouchingParts );
+                }
+                state.setItemsPerIteration( ring.numPoints() );
+            }
+        );
+
+        registry.add( "detail::extractNotTouchingParts<LineString,arena>", { "ring_size", "groups" }, ringGroupArgs(),
+            []( bench::MicroBenchmarkState & state ) {
+                ign::geometry::LineString ring = bench::makeRing( state.arg(0), 1000, 1, 1 );
+                std::vector< ign::geometry::LineString > vParts;
+                bench::splitIntoParts( bench::makePartiallyShiftedCopy( ring, 4, SHIFT ), state.arg(1), vParts );
+
+                app::tools::SegmentIndexedGeometryCollection refGeom;
+                for ( size_t i = 0 ; i < vParts.size() ; ++i ) refGeom.addGeometry( &vParts[i], i );
+
+                app::tools::MonotonicArena arena;
+                while ( state.keepRunning() ) {
+                    app::tools::MonotonicArena::Scope arenaScope( arena );
+                    std::pmr::vector< std::pair< int, int > > vNotTouchingParts( arena.resource() );
+                    std::pmr::vector< int > vTouchingPoints( arena.resource() );
+                    app::detail::extractNotTouchingParts( &refGeom, ring, vNotTouchingParts, &vTouchingPoints );
+                    bench::doNotOptimize( vNotTouchingParts );
+                }
+                state.setItemsPerIteration( ring.numPoints() );
+            }
+        );
+
+        registry.add( "detail::extractNotTouchingParts<Polygon>", { "ring_size", "groups" }, ringGroupArgs(),
+            []( bench::MicroBenchmarkState & state ) {
+                ign::geometry::LineString ring = bench::makeRing( state.arg(0), 1000, 1, 2 );
+                ign::geometry::Polygon polygon( ring );
+                std::vector< ign::geometry::LineString > vParts;
+                bench::splitIntoParts( bench::makePartiallyShiftedCopy( ring, 4, SHIFT ), state.arg(1), vParts );
+
+                app::tools::SegmentIndexedGeometryCollection refGeom;
+                for ( size_t i = 0 ; i < vParts.size() ; ++i ) refGeom.addGeometry( &vParts[i], i );
+
+                while ( state.keepRunning() ) {
+                    std::vector< std::vector< std::pair< int, int > > > vNotTouchingParts;
+                    std::vector< std::vector< int > > vTouchingPoints;
+                    app::detail::extractNotTouchingParts( &refGeom, polygon, vNotTouchingParts, &vTouchingPoints );
+                    bench::doNotOptimize( vNotTouchingParts );
+                }
+                state.setItemsPerIteration( ring.numPoints() );
+            }
+        );
+
+        registry.add( "detail::extractNotTouchingParts<MultiPolygon>", { "ring_size", "polygons" }, { { 64, 16 }, { 1024, 16 }, { 1024, 128 } },
+            []( bench::MicroBenchmarkState & state ) {
+                ign::geometry::MultiPolygon mp = bench::makeMultiPolygon( state.arg(1), state.arg(0), 3 );
+                std::vector< ign::geometry::LineString > vShifted;
+                for ( size_t i = 0 ; i < mp.numGeometries() ; ++i )
+                    vShifted.push_back( bench::makePartiallyShiftedCopy( mp.polygonN(i).exteriorRing(), 4, SHIFT ) );
+
+                app::tools::SegmentIndexedGeometryCollection refGeom;
+                for ( size_t i = 0 ; i < vShifted.size() ; ++i ) refGeom.addGeometry( &vShifted[i], i );
+
+                while ( state.keepRunning() ) {
+                    std::vector< std::vector< std::vector< std::pair< int, int > > > > vNotTouchingParts;
+                    std::vector< std::vector< std::vector< int > > > vTouchingPoints;
+                    app::detail::extractNotTouchingParts( &refGeom, mp, vNotTouchingParts, &vTouchingPoints );
+                    bench::doNotOptimize( vNotTouchingParts );
+                }
+                state.setItemsPerIteration( state.arg(0) * state.arg(1) );
+            }
+        );
+    }
+
+    //--
+    void registerSubStringAndRefining( bench::MicroBenchmarkRegistry & registry )
+    {
+        registry.add( "detail::getSubString", { "ring_size", "segments" }, { { 1024, 16 }, { 1024, 512 }, { 16384, 8192 } },
+            []( bench::MicroBenchmarkState & state ) {
+                ign::geometry::LineString ring = bench::makeRing( state.arg(0), 1000, 1, 4 );
+                // la sous-chaine chevauche le point de fermeture de l'anneau
+                int const start = static_cast< int >( state.arg(0) - state.arg(1) / 2 );
+                int const end = static_cast< int >( ( start + state.arg(1) ) % state.arg(0) );
+
+                while ( state.keepRunning() ) {
+                    ign::geometry::LineString subString = app::detail::getSubString( std::make_pair( start, end ), ring );
+                    bench::doNotOptimize( subString );
+                }
+                state.setItemsPerIteration( state.arg(1) );
+            }
+        );
+
+        registry.add( "detail::refine", { "ring_size" }, { { 64 }, { 1024 }, { 16384 } },
+            []( bench::MicroBenchmarkState & state ) {
+                ign::geometry::LineString const ring = bench::makeRing( state.arg(0), 1000, 1, 5 );
+                // point au milieu du dernier segment : pire cas du parcours
+                ign::geometry::Point const& a = ring.pointN( ring.numSegments()-1 );
+                ign::geometry::Point const& b = ring.pointN( ring.numSegments() );
+                ign::geometry::Point const point( ( a.x() + b.x() ) / 2, ( a.y() + b.y() ) / 2 );
+
+                while ( state.keepRunning() ) {
+                    state.pauseTiming();
+                    ign::geometry::LineString ls = ring;
+                    state.resumeTiming();
+                    app::detail::refine( ls, point, 0.1 );
+                    bench::doNotOptimize( ls );
+                }
+                state.setItemsPerIteration( ring.numSegments() );
+            }
+        );
+
+        registry.add( "detail::refineAreaWithLsEndings", { "ring_size", "polygons" }, { { 64, 16 }, { 1024, 16 }, { 1024, 128 } },
+            []( bench::MicroBenchmarkState & state ) {
+                ign::geometry::MultiPolygon const mp = bench::makeMultiPolygon( state.arg(1), state.arg(0), 6 );
+                // une ligne par polygone dont les extremites tombent au milieu de segments
+                // du contour
+                ign::geometry::MultiLineString mls;
+                for ( size_t i = 0 ; i < mp.numGeometries() ; ++i ) {
+                    ign::geometry::LineString const& ring = mp.polygonN(i).exteriorRing();
+                    size_t const n = ring.numSegments();
+                    ign::geometry::LineString ls;
+                    for ( size_t k : { n/4, 3*n/4 } ) {
+                        ign::geometry::Point const& a = ring.pointN( k );
+                        ign::geometry::Point const& b = ring.pointN( k+1 );
+                        ls.addPoint( ign::geometry::Point( ( a.x() + b.x() ) / 2, ( a.y() + b.y() ) / 2 ) );
+                    }
+                    mls.addGeometry( ls );
+                }
+
+                while ( state.keepRunning() ) {
+                    state.pauseTiming();
+                    ign::geometry::MultiPolygon mpCopy = mp;
+                    state.resumeTiming();
+                    app::detail::refineAreaWithLsEndings( mls, mpCopy );
+                    bench::doNotOptimize( mpCopy );
+                }
+                state.setItemsPerIteration( mls.numGeometries() * 2 );
+            }
+        );
+    }
+
+    //--
+    void registerSegmentIndexedGeometry( bench::MicroBenchmarkRegistry & registry )
+    {
+        registry.add( "tools::SegmentIndexedGeometry/build", { "segments" }, { { 1024 }, { 16384 }, { 262144 } },
+            []( bench::MicroBenchmarkState & state ) {
+                ign::geometry::LineString const ring = bench::makeRing( state.arg(0), 1000, 1, 7 );
+                while ( state.keepRunning() ) {
+                    app::tools::SegmentIndexedGeometry indexedGeom( &ring );
+                    bench::doNotOptimize( indexedGeom );
+                }
+                state.setItemsPerIteration( ring.numSegments() );
+            }
+        );
+
+        registry.add( "tools::SegmentIndexedGeometry/distance", { "segments" }, { { 1024 }, { 16384 }, { 262144 } },
+            []( bench::MicroBenchmarkState & state ) {
+                ign::geometry::LineString const ring = bench::makeRing( state.arg(0), 1000, 1, 8 );
+                ign::geometry::LineString const query = bench::makePartiallyShiftedCopy( ring, 4, SHIFT );
+                app::tools::SegmentIndexedGeometry indexedGeom( &ring );
+
+                size_t k = 0;
+                while ( state.keepRunning() ) {
+                    std::pair< double, std::set< int > > result = indexedGeom.distance( query.pointN( k ), 0.1 );
+                    bench::doNotOptimize( result );
+                    if ( ++k == query.numPoints() ) k = 0;
+                }
+                state.setItemsPerIteration( 1 );
+            }
+        );
+
+        registry.add( "tools::SegmentIndexedGeometryCollection/distance", { "segments", "groups" }, { { 16384, 1 }, { 16384, 16 }, { 16384, 256 } },
+            []( bench::MicroBenchmarkState & state ) {
+                ign::geometry::LineString const ring = bench::makeRing( state.arg(0), 1000, 1, 9 );
+                ign::geometry::LineString const query = bench::makePartiallyShiftedCopy( ring, 4, SHIFT );
+                std::vector< ign::geometry::LineString > vParts;
+                bench::splitIntoParts( ring, state.arg(1), vParts );
+
+                app::tools::SegmentIndexedGeometryCollection indexedGeoms;
+                for ( size_t i = 0 ; i < vParts.size() ; ++i ) indexedGeoms.addGeometry( &vParts[i], i );
+
+                size_t k = 0;
+                while ( state.keepRunning() ) {
+                    std::pair< double, std::set< int > > result = indexedGeoms.distance( query.pointN( k ), 0.1 );
+                    bench::doNotOptimize( result );
+                    if ( ++k == query.numPoints() ) k = 0;
+                }
+                state.setItemsPerIteration( 1 );
+            }
+        );
+    }
+
+    //--
+    void registerAuMatchingOpKernels( bench::MicroBenchmarkRegistry & registry )
+    {
+        registry.add( "AuMatchingOp::_getScore", {}, {},
+            []( bench::MicroBenchmarkState & state ) {
+                std::vector< double > vAngles;
+                for ( size_t i = 0 ; i < 1024 ; ++i ) vAngles.push_back( M_PI * i / 1024 );
+
+                size_t k = 0;
+                while ( state.keepRunning() ) {
+                    double score = bench::AuMatchingOpKernels::GetScore( M_PI_2, vAngles[k], 0.5 * k );
+                    bench::doNotOptimize( score );
+                    k = ( k + 1 ) & 1023;
+                }
+                state.setItemsPerIteration( 1 );
+            }
+        );
+
+        registry.add( "AuMatchingOp::_findIndex", { "ring_size", "search_vertices" }, { { 1024, 4 }, { 1024, 32 }, { 16384, 256 } },
+            []( bench::MicroBenchmarkState & state ) {
+                ign::geometry::LineString const ring = bench::makeRing( state.arg(0), 1000, 5, 10 );
+                double const vertexSpacing = 2 * M_PI * 1000 / state.arg(0);
+                double const searchDistance = vertexSpacing * state.arg(1);
+                size_t const startIndex = ring.numPoints() / 2;
+                ign::geometry::Point const& refPoint = ring.pointN( startIndex );
+
+                while ( state.keepRunning() ) {
+                    int index = bench::AuMatchingOpKernels::FindIndex( ring, startIndex, refPoint, M_PI_2, searchDistance );
+                    bench::doNotOptimize( index );
+                }
+                state.setItemsPerIteration( 2 * state.arg(1) );
+            }
+        );
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    std::string     filter = "";
+    double          minTime = 0.5;
+    bool            withCounters = false;
+
+    po::options_description desc("Allowed options");
+    desc.add_options()
+        ("help", "produce help message")
+        ("filter", po::value< std::string >(&filter)                        , "run only benchmarks whose name contains this string" )
+        ("min-time", po::value< double >(&minTime)                          , "minimum measured time per benchmark (seconds)" )
+        ("counters", po::bool_switch(&withCounters)                         , "report hardware counters (perf_event_open)" )
+    ;
+
+    po::variables_map vm;
+    po::store( po::parse_command_line(argc, argv, desc), vm );
+    po::notify( vm );
+
+    if ( vm.count( "help" ) ) {
+        std::cout << desc << std::endl;
+        return 1;
+    }
+
+    bench::MicroBenchmarkRegistry registry;
+    registerExtractNotTouchingParts( registry );
+    registerSubStringAndRefining( registry );
+    registerSegmentIndexedGeometry( registry );
+    registerAuMatchingOpKernels( registry );
+
+    bench::PerfCounters counters;
+    if ( withCounters && !counters.isAvailable() )
+        std::cerr << "hardware counters are not available (see /proc/sys/kernel/perf_event_paranoid)" << std::endl;
+
+    size_t count = registry.run( filter, minTime, std::cout, withCounters ? &counters : 0 );
+    return count > 0 ? 0 : 1;
+}
@@ -0,0 +1,169 @@
+// BENCH
+#include <bench/MicroBenchmark.h>
+
+// STL
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+
+namespace bench{
+
+    ///
+	///
+	///
+    MicroBenchmarkState::MicroBenchmarkState( 
+        size_t maxIterations, 
+        std::vector< long > const& vArgs,
+        PerfCounters* counters
+    ):
+        _maxIterations( maxIterations ),
+        _iteration( 0 ),
+        _vArgs( vArgs ),
+        _elapsed( 0 ),
+        _running( false ),
+        _itemsPerIteration( 0 ),
+        _counters( counters )
+    {
+    }
+
+    ///
+	///
+	///
+    long MicroBenchmarkState::arg( size_t i ) const
+    {
+        return _vArgs.at( i );
+    }
+
+    ///
+	///
+	///
+    bool MicroBenchmarkState::keepRunning()
+    {
+        if ( _iteration == 0 ) resumeTiming();
+        if ( _iteration++ < _maxIterations ) return true;
+        pauseTiming();
+        return false;
+    }
+
+    ///
+	///
+	///
+    void MicroBenchmarkState::pauseTiming()
+    {
+        if ( !_running ) return;
+        _elapsed += std::chrono::duration< double >( clock::now() - _start ).count();
+        if ( _counters ) _counters->disable();
+        _running = false;
+    }
+
+    ///
+	///
+	///
+    void MicroBenchmarkState::resumeTiming()
+    {
+        if ( _running ) return;
+        if ( _counters ) _counters->enable();
+        _start = clock::now();
+        _running = true;
+    }
+
+    ///
+	///
+	///
+    void MicroBenchmarkState::setItemsPerIteration( size_t items )
+    {
+        _itemsPerIteration = items;
+    }
+
+    ///
+	///
+	///
+    void MicroBenchmarkRegistry::add(
+        std::string const& name,
+        std::vector< std::string > const& vArgNames,
+        std::vector< std::vector< long > > const& vvArgs,
+        MicroBenchmarkFunction function
+    ) {
+        Entry entry;
+        entry.name = name;
+        entry.vArgNames = vArgNames;
+        entry.vvArgs = vvArgs.empty() ? std::vector< std::vector< long > >( 1 ) : vvArgs;
+        entry.function = function;
+        _vEntries.push_back( entry );
+    }
+
+    ///
+	///
+	///
+    size_t MicroBenchmarkRegistry::run(
+        std::string const& filter,
+        double minTime,
+        std::ostream & os,
+        PerfCounters* counters
+    ) const {
+        os << std::left << std::setw(64) << "benchmark" << std::right
+            << std::setw(12) << "iterations" << std::setw(16) << "ns/op" << std::setw(16) << "items/s";
+        if ( counters ) {
+            os << std::setw(10) << "ipc";
+            for ( size_t c = PerfCounterValues::CACHE_MISSES ; c < PerfCounterValues::NUM_COUNTERS ; ++c )
+                os << std::setw(18) << std::string( PerfCounterValues::Name( c ) ) + "/op";
+        }
+        os << std::endl;
+
+        size_t count = 0;
+        for ( size_t i = 0 ; i < _vEntries.size() ; ++i ) {
+            Entry const& entry = _vEntries[i];
+            for ( size_t j = 0 ; j < entry.vvArgs.size() ; ++j ) {
+                std::ostringstream ssName;
+                ssName << entry.name;
+                for ( size_t k = 0 ; k < entry.vvArgs[j].size() ; ++k ) {
+                    ssName << "/";
+                    if ( k < entry.vArgNames.size() ) ssName << entry.vArgNames[k] << ":";
+                    ssName << entry.vvArgs[j][k];
+                }
+                std::string const name = ssName.str();
+                if ( !filter.empty() && name.find( filter ) == std::string::npos ) continue;
+
+                // calibration : on augmente le nombre d'iterations jusqu'a atteindre minTime
+                size_t iterations = 1;
+                MicroBenchmarkState state( iterations, entry.vvArgs[j], counters );
+                while ( true ) {
+                    state = MicroBenchmarkState( iterations, entry.vvArgs[j], counters );
+                    if ( counters ) counters->reset();
+                    entry.function( state );
+                    if ( state.elapsed() >= minTime || iterations >= 1000000000 ) break;
+
+                    double multiplier = state.elapsed() > 0 ? 1.4 * minTime / state.elapsed() : 10;
+                    multiplier = std::min( 10., std::max( 2., multiplier ) );
+                    iterations = static_cast< size_t >( iterations * multiplier );
+                }
+
+                double const nsPerOp = state.elapsed() * 1e9 / state.iterations();
+                os << std::left << std::setw(64) << name << std::right
+                    << std::setw(12) << state.iterations()
+                    << std::setw(16) << std::fixed << std::setprecision(1) << nsPerOp;
+                if ( state.itemsPerIteration() > 0 )
+                    os << std::setw(16) << std::scientific << std::setprecision(3)
+                        << state.itemsPerIteration() * state.iterations() / state.elapsed();
+                else if ( counters )
+                    os << std::setw(16) << "-";
+                if ( counters ) {
+                    PerfCounterValues const values = counters->read();
+                    os << std::fixed << std::setprecision(2);
+                    if ( values.ipc() < 0 ) os << std::setw(10) << "-";
+                    else os << std::setw(10) << values.ipc();
+                    os << std::setprecision(3);
+                    for ( size_t c = PerfCounterValues::CACHE_MISSES ; c < PerfCounterValues::NUM_COUNTERS ; ++c ) {
+                        if ( values.values[c] < 0 ) os << std::setw(18) << "-";
+                        else os << std::setw(18) << static_cast< double >( values.values[c] ) / state.iterations();
+                    }
+                }
+                os << std::defaultfloat << std::endl;
+                ++count;
+            }
+        }
+        return count;
+    }
+
+}
@@ -0,0 +1,165 @@
+// BENCH
+#include <bench/PerfCounters.h>
+
+// STL
+#include <cstring>
+
+// SYSTEM
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+
+namespace bench{
+namespace detail{
+
+    ///
+	///
+	///
+    int openCounter( uint32_t type, uint64_t config, int groupFd )
+    {
+        struct perf_event_attr attr;
+        std::memset( &attr, 0, sizeof( attr ) );
+        attr.size = sizeof( attr );
+        attr.type = type;
+        attr.config = config;
+        // seul le meneur du groupe est desactive : les autres compteurs le suivent
+        attr.disabled = groupFd < 0 ? 1 : 0;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        return static_cast< int >( syscall( __NR_perf_event_open, &attr, 0, -1, groupFd, 0 ) );
+    }
+}
+
+    ///
+	///
+	///
+    const char* PerfCounterValues::Name( size_t counter )
+    {
+        static const char* vNames[NUM_COUNTERS] = { "cycles", "instructions", "cache_misses", "branch_misses", "page_faults" };
+        return vNames[counter];
+    }
+
+    ///
+	///
+	///
+    double PerfCounterValues::ipc() const
+    {
+        if ( values[CYCLES] <= 0 || values[INSTRUCTIONS] < 0 ) return -1;
+        return static_cast< double >( values[INSTRUCTIONS] ) / values[CYCLES];
+    }
+
+    ///
+	///
+	///
+    void PerfCounterValues::write( std::ostream & os ) const
+    {
+        for ( size_t i = 0 ; i < NUM_COUNTERS ; ++i ) os << ( i > 0 ? " " : "" ) << values[i];
+    }
+
+    ///
+	///
+	///
+    void PerfCounterValues::read( std::istream & is )
+    {
+        for ( size_t i = 0 ; i < NUM_COUNTERS ; ++i ) is >> values[i];
+    }
+
+    ///
+	///
+	///
+    PerfCounters::PerfCounters():
+        _leaderFd( -1 )
+    {
+        static const uint32_t vTypes[PerfCounterValues::NUM_COUNTERS] = { 
+            PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_SOFTWARE 
+        };
+        static const uint64_t vConfigs[PerfCounterValues::NUM_COUNTERS] = { 
+            PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES, PERF_COUNT_SW_PAGE_FAULTS 
+        };
+
+        // le premier compteur ouvert mene le groupe : les compteurs sont demarres,
+        // arretes et lus ensemble et portent donc sur le meme intervalle
+        for ( size_t i = 0 ; i < PerfCounterValues::NUM_COUNTERS ; ++i ) {
+            _vFd[i] = detail::openCounter( vTypes[i], vConfigs[i], _leaderFd );
+            if ( _leaderFd < 0 ) _leaderFd = _vFd[i];
+        }
+    }
+
+    ///
+	///
+	///
+    PerfCounters::~PerfCounters()
+    {
+        for ( size_t i = 0 ; i < PerfCounterValues::NUM_COUNTERS ; ++i )
+            if ( _vFd[i] >= 0 ) close( _vFd[i] );
+    }
+
+    ///
+	///
+	///
+    bool PerfCounters::isAvailable() const
+    {
+        return _leaderFd >= 0;
+    }
+
+    ///
+	///
+	///
+    void PerfCounters::reset()
+    {
+        if ( _leaderFd >= 0 ) ioctl( _leaderFd, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP );
+    }
+
+    ///
+	///
+	///
+    void PerfCounters::enable()
+    {
+        if ( _leaderFd >= 0 ) ioctl( _leaderFd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP );
+    }
+
+    ///
+	///
+	///
+    void PerfCounters::disable()
+    {
+        if ( _leaderFd >= 0 ) ioctl( _leaderFd, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP );
+    }
+
+    ///
+	///
+	///
+    PerfCounterValues PerfCounters::read() const
+    {
+        PerfCounterValues counterValues;
+        if ( _leaderFd < 0 ) return counterValues;
+
+        // nr, time_enabled, time_running, puis une valeur par compteur du groupe
+        // dans l'ordre d'ouverture
+        uint64_t buffer[3 + PerfCounterValues::NUM_COUNTERS];
+        ssize_t const size = ::read( _leaderFd, buffer, sizeof( buffer ) );
+        if ( size < static_cast< ssize_t >( 3 * sizeof( uint64_t ) ) ) return counterValues;
+        if ( size < static_cast< ssize_t >( ( 3 + buffer[0] ) * sizeof( uint64_t ) ) ) return counterValues;
+
+        size_t index = 0;
+        for ( size_t i = 0 ; i < PerfCounterValues::NUM_COUNTERS && index < buffer[0] ; ++i ) {
+            if ( _vFd[i] < 0 ) continue;
+
+            uint64_t const value = buffer[3 + index++];
+            if ( buffer[2] == 0 ) {
+                counterValues.values[i] = 0;
+            } else {
+                // correction du multiplexage du groupe par le noyau
+                counterValues.values[i] = static_cast< int64_t >( 
+                    static_cast< double >( value ) * buffer[1] / buffer[2] 
+                );
+            }
+        }
+        return counterValues;
+    }
+
+}
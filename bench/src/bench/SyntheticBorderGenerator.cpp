@@ -0,0 +1,110 @@
+// BENCH
+#include <bench/SyntheticBorderGenerator.h>
+
+// STL
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+
+namespace bench{
+
+    ///
+	///
+	///
+    void SyntheticBorderGenerator::Generate(
+        SyntheticBorderParameters const& params,
+        SyntheticBorderDataset & dataset
+    ) {
+        std::mt19937 generator( params.seed );
+        std::uniform_real_distribution< double > jagDistribution( -params.jaggedness, params.jaggedness );
+        std::uniform_real_distribution< double > noiseDistribution( -params.boundaryNoise, params.boundaryNoise );
+
+        size_t const nx = std::max< size_t >( 1, static_cast< size_t >( std::ceil( std::sqrt( static_cast< double >( params.numAu ) ) ) ) );
+        size_t const ny = std::max< size_t >( 1, ( params.numAu + nx - 1 ) / nx );
+        size_t const numJagPerRow = std::max< size_t >( 1, params.numBoundaryVertices / ny );
+
+        double const s = params.cellSize;
+        double const width = nx * s;
+        double const height = ny * s;
+
+        // sommets de la frontiere dentelee (cote est) pour chaque ligne de la grille,
+        // extremites de ligne exclues
+        std::vector< std::vector< ign::geometry::Point > > vvJag( ny );
+        for ( size_t r = 0 ; r < ny ; ++r ) {
+            for ( size_t k = 1 ; k <= numJagPerRow ; ++k ) {
+                double y = r * s + s * k / ( numJagPerRow + 1 );
+                vvJag[r].push_back( ign::geometry::Point( width + jagDistribution( generator ) * s, y ) );
+            }
+        }
+
+        // landmask : contour du pays (sens trigonometrique)
+        ign::geometry::LineString landmaskRing;
+        for ( size_t c = 0 ; c < nx ; ++c ) 
+            landmaskRing.addPoint( ign::geometry::Point( c * s, 0 ) );
+        for ( size_t r = 0 ; r < ny ; ++r ) {
+            landmaskRing.addPoint( ign::geometry::Point( width, r * s ) );
+            for ( size_t k = 0 ; k < vvJag[r].size() ; ++k )
+                landmaskRing.addPoint( vvJag[r][k] );
+        }
+        for ( size_t c = nx ; c > 0 ; --c ) 
+            landmaskRing.addPoint( ign::geometry::Point( c * s, height ) );
+        for ( size_t r = ny ; r > 0 ; --r ) 
+            landmaskRing.addPoint( ign::geometry::Point( 0, r * s ) );
+        landmaskRing.addPoint( landmaskRing.startPoint() );
+
+        dataset.landmask = ign::geometry::MultiPolygon();
+        dataset.landmask.addGeometry( ign::geometry::Polygon( landmaskRing ) );
+
+        // cote (cote ouest) et frontiere internationale (cotes sud, est et nord),
+        // decalees vers l'exterieur et bruitees
+        double const offset = params.boundaryOffset;
+
+        dataset.coastline = ign::geometry::LineString();
+        for ( size_t r = ny+1 ; r > 0 ; --r ) {
+            double y = ( r == ny+1 ) ? height + offset : ( r == 1 ) ? -offset : (r-1) * s + noiseDistribution( generator );
+            dataset.coastline.addPoint( ign::geometry::Point( -offset + noiseDistribution( generator ), y ) );
+        }
+        dataset.coastline.startPoint() = ign::geometry::Point( -offset, height + offset );
+        dataset.coastline.endPoint() = ign::geometry::Point( -offset, -offset );
+
+        dataset.boundary = ign::geometry::LineString();
+        dataset.boundary.addPoint( ign::geometry::Point( -offset, -offset ) );
+        for ( size_t c = 1 ; c < nx ; ++c ) 
+            dataset.boundary.addPoint( ign::geometry::Point( c * s + noiseDistribution( generator ), -offset + noiseDistribution( generator ) ) );
+        for ( size_t r = 0 ; r < ny ; ++r ) {
+            double y = ( r == 0 ) ? -offset : r * s + noiseDistribution( generator );
+            dataset.boundary.addPoint( ign::geometry::Point( width + offset + noiseDistribution( generator ), y ) );
+            for ( size_t k = 0 ; k < vvJag[r].size() ; ++k ) 
+                dataset.boundary.addPoint( ign::geometry::Point( vvJag[r][k].x() + offset + noiseDistribution( generator ), vvJag[r][k].y() + noiseDistribution( generator ) ) );
+        }
+        dataset.boundary.addPoint( ign::geometry::Point( width + offset, height + offset ) );
+        for ( size_t c = nx-1 ; c > 0 ; --c ) 
+            dataset.boundary.addPoint( ign::geometry::Point( c * s + noiseDistribution( generator ), height + offset + noiseDistribution( generator ) ) );
+        dataset.boundary.addPoint( ign::geometry::Point( -offset, height + offset ) );
+
+        // pavage en unites administratives (les cellules de la derniere colonne suivent
+        // la frontiere dentelee)
+        dataset.vAu.clear();
+        dataset.vAu.reserve( nx * ny );
+        for ( size_t r = 0 ; r < ny ; ++r ) {
+            for ( size_t c = 0 ; c < nx ; ++c ) {
+                ign::geometry::LineString ring;
+                ring.addPoint( ign::geometry::Point( c * s, r * s ) );
+                ring.addPoint( ign::geometry::Point( (c+1) * s, r * s ) );
+                if ( c == nx-1 ) {
+                    for ( size_t k = 0 ; k < vvJag[r].size() ; ++k )
+                        ring.addPoint( vvJag[r][k] );
+                }
+                ring.addPoint( ign::geometry::Point( (c+1) * s, (r+1) * s ) );
+                ring.addPoint( ign::geometry::Point( c * s, (r+1) * s ) );
+                ring.addPoint( ring.startPoint() );
+
+                ign::geometry::MultiPolygon mp;
+                mp.addGeometry( ign::geometry::Polygon( ring ) );
+                dataset.vAu.push_back( mp );
+            }
+        }
+    }
+
+}
@@ -0,0 +1,90 @@
+// BENCH
+#include <bench/kernelFixtures.h>
+
+// STL
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+
+namespace bench{
+
+    ///
+	///
+	///
+    ign::geometry::LineString makeRing(
+        size_t numPoints,
+        double radius,
+        double noise,
+        unsigned int seed,
+        double xCenter
+    ) {
+        std::mt19937 generator( seed );
+        std::uniform_real_distribution< double > noiseDistribution( -noise, noise );
+
+        ign::geometry::LineString ring;
+        for ( size_t i = 0 ; i < numPoints ; ++i ) {
+            double const theta = 2 * M_PI * i / numPoints;
+            double const r = radius + noiseDistribution( generator );
+            ring.addPoint( ign::geometry::Point( xCenter + r * std::cos( theta ), r * std::sin( theta ) ) );
+        }
+        ring.addPoint( ring.startPoint() );
+        return ring;
+    }
+
+    ///
+	///
+	///
+    ign::geometry::LineString makePartiallyShiftedCopy(
+        ign::geometry::LineString const& ls,
+        size_t numParts,
+        double offset
+    ) {
+        size_t const numBlocks = std::max< size_t >( 1, 2 * numParts );
+        size_t const blockSize = std::max< size_t >( 1, ls.numPoints() / numBlocks );
+
+        ign::geometry::LineString copy;
+        for ( size_t i = 0 ; i < ls.numPoints() ; ++i ) {
+            ign::geometry::Point const& pt = ls.pointN( i );
+            bool const isShifted = ( ( i / blockSize ) % 2 ) == 1;
+            copy.addPoint( isShifted ? ign::geometry::Point( pt.x(), pt.y() + offset ) : pt );
+        }
+        return copy;
+    }
+
+    ///
+	///
+	///
+    void splitIntoParts(
+        ign::geometry::LineString const& ls,
+        size_t numGroups,
+        std::vector< ign::geometry::LineString > & vParts
+    ) {
+        size_t const numSegments = ls.numSegments();
+        numGroups = std::max< size_t >( 1, std::min( numGroups, numSegments ) );
+
+        for ( size_t g = 0 ; g < numGroups ; ++g ) {
+            size_t const start = g * numSegments / numGroups;
+            size_t const end = ( g + 1 ) * numSegments / numGroups;
+            ign::geometry::LineString part;
+            for ( size_t i = start ; i <= end ; ++i )
+                part.addPoint( ls.pointN( i ) );
+            vParts.push_back( part );
+        }
+    }
+
+    ///
+	///
+	///
+    ign::geometry::MultiPolygon makeMultiPolygon(
+        size_t numPolygons,
+        size_t ringSize,
+        unsigned int seed
+    ) {
+        ign::geometry::MultiPolygon mp;
+        for ( size_t i = 0 ; i < numPolygons ; ++i )
+            mp.addGeometry( ign::geometry::Polygon( makeRing( ringSize, 100, 1, seed + i, 300. * i ) ) );
+        return mp;
+    }
+
+}
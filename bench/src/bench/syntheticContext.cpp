@@ -0,0 +1,119 @@
+// BENCH
+#include <bench/syntheticContext.h>
+
+// EPG
+#include <epg/Context.h>
+#include <epg/log/EpgLogger.h>
+#include <epg/params/EpgParameters.h>
+
+// APP
+#include <app/params/ThemeParameters.h>
+
+
+namespace bench{
+
+    ///
+	///
+	///
+    void initSyntheticContext(
+        std::string const& countryCode,
+        std::string const& logDirectory
+    ) {
+        epg::Context* context = epg::ContextS::getInstance();
+        context->setLogDirectory( logDirectory );
+
+        epg::log::EpgLoggerS::getInstance()->setDevOfstream( logDirectory+"/au_matching_bench.log" );
+
+        epg::params::EpgParameters* epgParams = epg::params::EpgParametersS::getInstance();
+        epgParams->setParameter( ID, ign::data::String("objectid") );
+        epgParams->setParameter( GEOM, ign::data::String("geom") );
+        epgParams->setParameter( COUNTRY_CODE, ign::data::String("country") );
+        epgParams->setParameter( BOUNDARY_TYPE, ign::data::String("boundary_type") );
+        epgParams->setParameter( TYPE_COASTLINE, ign::data::String("coastline_sea_limit") );
+        epgParams->setParameter( TARGET_BOUNDARY_TABLE, ign::data::String(SyntheticTables::Boundary()) );
+        epgParams->setParameter( AREA_TABLE, ign::data::String(SyntheticTables::Area()) );
+
+        app::params::ThemeParameters* themeParameters = app::params::ThemeParametersS::getInstance();
+        themeParameters->setParameter( AREA_TABLE_INIT, ign::data::String(SyntheticTables::Area()) );
+        themeParameters->setParameter( LANDMASK_TABLE, ign::data::String(SyntheticTables::Landmask()) );
+        themeParameters->setParameter( COAST_TABLE, ign::data::String(SyntheticTables::Coast()) );
+        themeParameters->setParameter( NOCOAST_TABLE, ign::data::String(SyntheticTables::NoCoast()) );
+        themeParameters->setParameter( GEOMETRY_CACHE_DIRECTORY, ign::data::String("") );
+        themeParameters->setParameter( INTERMEDIATE_TABLES, ign::data::String("database") );
+        themeParameters->setParameter( LAND_COVER_TYPE, ign::data::String("land_cover_type") );
+        themeParameters->setParameter( TYPE_LAND_AREA, ign::data::String("land_area") );
+        themeParameters->setParameter( COUNTRY_CODE_W, ign::data::String(countryCode) );
+        themeParameters->setParameter( AU_BOUNDARY_MAX_DIST, ign::data::String("80") );
+        themeParameters->setParameter( AU_BOUNDARY_SEARCH_DIST, ign::data::String("80") );
+        themeParameters->setParameter( AU_BOUNDARY_SNAP_DIST, ign::data::String("2") );
+        themeParameters->setParameter( AU_COAST_MAX_DIST, ign::data::String("300") );
+        themeParameters->setParameter( AU_COAST_SEARCH_DIST, ign::data::String("50") );
+        themeParameters->setParameter( AU_COAST_SNAP_DIST, ign::data::String("5") );
+        themeParameters->setParameter( AU_SEGMENT_MIN_LENGTH, ign::data::String("2") );
+        themeParameters->setParameter( AU_FEATURE_TIME_BUDGET, ign::data::String("0") );
+        themeParameters->setParameter( AU_PIPELINE_QUEUE_SIZE, ign::data::String("64") );
+        themeParameters->setParameter( AU_SPATIAL_ORDER, ign::data::String("1") );
+        themeParameters->setParameter( AU_BOUNDARY_TILE_SIZE, ign::data::String("500") );
+        themeParameters->setParameter( AU_BOUNDARY_TILE_CACHE_SIZE, ign::data::String("1024") );
+        themeParameters->setParameter( AU_MANIFEST_DIRECTORY, ign::data::String("") );
+        themeParameters->setParameter( AU_CHECKPOINT_DIRECTORY, ign::data::String("") );
+        themeParameters->setParameter( AU_CHECKPOINT_INTERVAL, ign::data::String("500") );
+        themeParameters->setParameter( AU_RESUME, ign::data::String("0") );
+        themeParameters->setParameter( AU_SHARD_COUNT, ign::data::String("1") );
+        themeParameters->setParameter( AU_TARGET_IDS, ign::data::String("") );
+        themeParameters->setParameter( AU_TARGET_BBOX, ign::data::String("") );
+        themeParameters->setParameter( AU_TARGET_SOURCE_TABLE, ign::data::String("") );
+        themeParameters->setParameter( AU_PREFILTER_CHECK, ign::data::String("0") );
+        themeParameters->setParameter( ALLOCATION_TRACKING, ign::data::String("0") );
+        themeParameters->setParameter( ALLOCATION_TRACKING_TOP_K, ign::data::String("20") );
+    }
+
+    ///
+	///
+	///
+    void loadSyntheticDataset(
+        SyntheticBorderDataset const& dataset,
+        std::string const& countryCode,
+        app::io::MemoryDataSource & dataSource
+    ) {
+        epg::params::EpgParameters const& epgParams = epg::ContextS::getInstance()->getEpgParameters();
+        std::string const countryCodeName = epgParams.getValue( COUNTRY_CODE ).toString();
+        std::string const boundaryTypeName = epgParams.getValue( BOUNDARY_TYPE ).toString();
+
+        app::params::ThemeParameters* themeParameters = app::params::ThemeParametersS::getInstance();
+        std::string const landCoverTypeName = themeParameters->getValue( LAND_COVER_TYPE ).toString();
+        std::string const landAreaValue = themeParameters->getValue( TYPE_LAND_AREA ).toString();
+
+        //--
+        dataSource.clearTable( SyntheticTables::Landmask() );
+        ign::feature::Feature fLandmask;
+        fLandmask.setGeometry( dataset.landmask );
+        fLandmask.setAttribute( countryCodeName, ign::data::String(countryCode) );
+        fLandmask.setAttribute( landCoverTypeName, ign::data::String(landAreaValue) );
+        dataSource.createFeature( SyntheticTables::Landmask(), fLandmask );
+
+        //--
+        dataSource.clearTable( SyntheticTables::Boundary() );
+        ign::feature::Feature fCoast;
+        fCoast.setGeometry( dataset.coastline );
+        fCoast.setAttribute( countryCodeName, ign::data::String(countryCode) );
+        fCoast.setAttribute( boundaryTypeName, ign::data::String(epgParams.getValue( TYPE_COASTLINE ).toString()) );
+        dataSource.createFeature( SyntheticTables::Boundary(), fCoast );
+
+        ign::feature::Feature fBoundary;
+        fBoundary.setGeometry( dataset.boundary );
+        fBoundary.setAttribute( countryCodeName, ign::data::String(countryCode+"#zz") );
+        fBoundary.setAttribute( boundaryTypeName, ign::data::String("international_boundary") );
+        dataSource.createFeature( SyntheticTables::Boundary(), fBoundary );
+
+        //--
+        dataSource.clearTable( SyntheticTables::Area() );
+        for ( size_t i = 0 ; i < dataset.vAu.size() ; ++i ) {
+            ign::feature::Feature fAu;
+            fAu.setGeometry( dataset.vAu[i] );
+            fAu.setAttribute( countryCodeName, ign::data::String(countryCode) );
+            dataSource.createFeature( SyntheticTables::Area(), fAu );
+        }
+    }
+
+}
@@ -0,0 +1,70 @@
+#ifndef _APP_CALCUL_AUMATCHINGINDEXES_H_
+#define _APP_CALCUL_AUMATCHINGINDEXES_H_
+
+//STL
+#include <string>
+#include <vector>
+
+//SOCLE
+#include <ign/geometry.h>
+#include <ign/geometry/index/QuadTree.h>
+
+//EPG
+#include <epg/tools/MultiLineStringTool.h>
+
+//APP
+#include <app/tools/LocalTileCache.h>
+#include <app/tools/SegmentIndexedGeometry.h>
+
+namespace app{
+namespace calcul{
+
+	/// @brief Structures preparees de l'etape 630 qui ne dependent que du pays :
+	/// outil des contours de frontiere, portions hors cotes et frontieres fermees
+	/// indexees. Un objet cree par l'appelant et transmis a AuMatchingOp::Compute
+	/// conserve ces structures d'un appel a l'autre pour un meme pays (traitement
+	/// de plusieurs niveaux administratifs). Elles sont reconstruites si le pays
+	/// change et liberees a la destruction de l'objet.
+	struct AuMatchingIndexes {
+
+		/// @brief
+		AuMatchingIndexes();
+
+		/// @brief
+		~AuMatchingIndexes();
+
+		/// @brief Libere les structures
+		void clear();
+
+		//-- pays des structures (vide si elles ne sont pas construites)
+		std::string                                        countryCode;
+		//--
+		epg::tools::MultiLineStringTool*                   mlsToolBoundary;
+		//-- extractions locales de mlsToolBoundary par tuiles (AU_BOUNDARY_TILE_SIZE)
+		tools::LocalTileCache*                             localBoundary;
+		//-- contours a partir desquels est construit mlsToolBoundary (mode multi-processus)
+		ign::geometry::MultiLineString                     mLsBoundaryContours;
+		//--
+		ign::geometry::MultiLineString                     mLsLandmaskNoCoasts;
+		//--
+		tools::SegmentIndexedGeometryCollection*           indexedLandmaskNoCoasts;
+		//--
+		std::vector< ign::geometry::LineString >           vMergedBoundaryLs;
+		//--
+		std::vector< tools::SegmentIndexedGeometryInterface* > vMergedBoundaryIndexedLs;
+		//--
+		ign::geometry::index::QuadTree< size_t >           qTreeClosedBoundary;
+
+	private:
+
+		//-- non copiable
+		AuMatchingIndexes( AuMatchingIndexes const& );
+
+		//--
+		AuMatchingIndexes& operator=( AuMatchingIndexes const& );
+	};
+
+}
+}
+
+#endif
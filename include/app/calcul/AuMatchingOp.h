@@ -1,22 +1,49 @@
 #ifndef _APP_CALCUL_AUMATCHINGOP_H_
 #define _APP_CALCUL_AUMATCHINGOP_H_
 
+//STL
+#include <cstdint>
+#include <utility>
+
 //EPG
 #include <epg/log/EpgLogger.h>
 #include <epg/log/ShapeLogger.h>
 #include <epg/tools/MultiLineStringTool.h>
-#include <ome2/feature/sql/NotDestroyedTools.h>
 
 //APP
+#include <app/calcul/AuMatchingIndexes.h>
+#include <app/io/DataSource.h>
+#include <app/io/GeometryCache.h>
+#include <app/tools/DiagnosticWriter.h>
+#include <app/tools/LocalTileCache.h>
+#include <app/tools/MonotonicArena.h>
 #include <app/tools/SegmentIndexedGeometry.h>
+#include <app/tools/TimeBudget.h>
+
+namespace bench{
+	class AuMatchingOpKernels;
+}
 
 namespace app{
 namespace calcul{
 
+	class AuMatchingSharding;
+	class AuMatchingSweep;
+	class ContextBundle;
+
 	/// @brief Classe consacrée à la mise en cohérence des surfaces
 	/// administratives avec les frontières.
 	class AuMatchingOp {
 
+		//-- acces aux noyaux de calcul pour les micro-benchmarks
+		friend class ::bench::AuMatchingOpKernels;
+		//-- repartition du traitement entre processus (AU_SHARD_COUNT)
+		friend class AuMatchingSharding;
+		//-- balayage de parametres
+		friend class AuMatchingSweep;
+		//-- extraction et rejeu du contexte de calcul d'une unite administrative
+		friend class ContextBundle;
+
 	public:
 
 		/// @brief Lance la reconstruction des surfaces administratives frontalières.
@@ -25,35 +52,80 @@ namespace calcul{
 		/// supérieurs seront dérivés par fusion des échelons inférieurs.
 		/// @param countryCode Code pays simple
 		/// @param verbose Mode verbeux
+		/// @param sharedIndexes Structures preparees conservees par l'appelant d'un
+		/// appel a l'autre (traitement de plusieurs niveaux administratifs d'un meme
+		/// pays) ; a defaut, elles sont construites puis liberees par l'appel. Elles
+		/// ne sont pas utilisees par une relance ciblee.
 		static void Compute(
 			std::string countryCode, 
-			bool verbose
+			bool verbose,
+			AuMatchingIndexes* sharedIndexes = 0
 		);
 
+		/// @brief Chemin du point de reprise du traitement d'un pays (vide si
+		/// le parametre AU_CHECKPOINT_DIRECTORY n'est pas renseigne)
+		static std::string CheckpointPath(
+			std::string const& countryCode
+		);
+
+	private:
+
+		//-- anomalies comptees lors du traitement des unites administratives
+		enum Anomaly {
+			CLOSED_BOUNDARY_NOT_FOUND,
+			PARTS_NOT_MATCHING,
+			PATH_NOT_FOUND,
+			RING_ERROR,
+			EMPTY_RESULT,
+			INVALID_RESULT,
+			POINT_NOT_PROJECTED,
+			NUM_ANOMALIES
+		};
+
 	private:
 		//--
-		ign::feature::sql::FeatureStorePostgis*            _fsNoCoast;
+		io::DataSource*                                    _dataSource;
 		//--
-		ign::feature::sql::FeatureStorePostgis*            _fsArea;
+		std::string                                        _noCoastTableName;
 		//--
-		ign::feature::sql::FeatureStorePostgis*            _fsBoundary;
+		std::string                                        _areaTableName;
 		//--
-		ign::feature::sql::FeatureStorePostgis*            _fsLandmask;
+		std::string                                        _boundaryTableName;
 		//--
-		epg::tools::MultiLineStringTool*                   _mlsToolBoundary;
+		io::GeometryCache*                                 _geometryCache;
+		//-- structures preparees construites par l'operateur (pas de structures partagees)
+		AuMatchingIndexes                                  _ownIndexes;
+		//-- structures preparees utilisees (_ownIndexes ou structures partagees)
+		AuMatchingIndexes*                                 _indexes;
 		//--
 		epg::log::EpgLogger*                               _logger;
 		//--
 		epg::log::ShapeLogger*                             _shapeLogger;
 		//--
+		mutable tools::DiagnosticWriter                    _diagnosticWriter;
+		//--
 		std::string                                        _countryCode;
 		//--
 		bool                                               _verbose;
+		//-- nombre de processus de calcul (AU_SHARD_COUNT)
+		size_t                                             _numShards;
+		//-- nombre d'occurrences de chaque anomalie
+		mutable std::vector< size_t >                      _vAnomalies;
+		//-- anomalies de l'unite administrative en cours, reportees a la fin de son traitement
+		mutable std::vector< std::pair< Anomaly, std::string > > _vPendingAnomalies;
+		//-- anomalies comptees sans etre inscrites dans le log
+		bool                                               _quiet;
+		//-- relance ciblee (AU_TARGET_IDS, AU_TARGET_BBOX)
+		bool                                               _targeted;
+		//-- unites administratives selectionnees par la relance ciblee
+		std::vector< ign::feature::Feature >               _vTargetAu;
+		//-- emprises des unites administratives selectionnees elargies du rayon d'influence
+		std::vector< ign::geometry::Envelope >             _vTargetEnvelopes;
 
 	private:
 
 		//--
-		AuMatchingOp( std::string countryCode, bool verbose );
+		AuMatchingOp( std::string countryCode, bool verbose, AuMatchingIndexes* sharedIndexes = 0 );
 
 		//--
 		~AuMatchingOp();
@@ -61,14 +133,89 @@ namespace calcul{
 		//--
 		void _init();
 
+		//--
+		void _loadIndexes();
+
+		/// @brief Controle du prefiltre spatial (AU_PREFILTER_CHECK) : toute unite
+		/// administrative du pays situee a moins de searchDistance d'une portion hors
+		/// cotes doit etre restituee par areaQuery. Inscrit dans le log la part des
+		/// unites administratives retenues.
+		void _checkPrefilter( io::Query const& areaQuery, double searchDistance ) const;
+
+		/// @brief Lecture des unites administratives selectionnees par AU_TARGET_IDS
+		/// (fichier d'identifiants, un par ligne) ou AU_TARGET_BBOX (xmin,ymin,xmax,ymax)
+		/// dans la table AU_TARGET_SOURCE_TABLE (a defaut, la table de travail)
+		void _loadTargets();
+
+		/// @brief Restreint la requete au voisinage des unites administratives
+		/// selectionnees (relance ciblee)
+		io::Query _local( io::Query query ) const;
+
+		/// @brief Traitement des seules unites administratives selectionnees, reecrites
+		/// par identifiant dans la table de travail
+		void _computeTargets();
+
+		//--
+		void _indexLandmaskNoCoasts();
+
+		//-- (re)cree le cache des extractions locales de _mlsToolBoundary et l'outil de projection associe
+		void _initLocalBoundary();
+
 		//--
 		void _compute();
 
+		/// @brief Plus aucune ecriture dans les couches de diagnostic (processus fils,
+		/// executions repetees) ; avec quiet, les anomalies sont seulement comptees
+		void _disableDiagnostics( bool quiet );
+
+		//-- libelle d'une anomalie
+		static std::string _anomalyName( size_t anomaly );
+
+		//--
+		void _anomaly( Anomaly anomaly, std::string const& message ) const;
+
+		//-- reporte (ou abandonne si le traitement a ete interrompu) les anomalies
+		//-- et diagnostics mis en attente pendant le traitement d'une unite administrative
+		void _flushAuReports( bool completed );
+
+		//--
+		void _logAnomalies( std::string const& title ) const;
+
+		/// @brief Met en coherence une unite administrative avec la frontiere.
+		/// @param fAu Unite administrative a traiter
+		/// @param budget Budget de temps (pas de limite si nul)
+		/// @param modified Vaut true si la geometrie de l'objet a ete modifiee et
+		/// doit etre enregistree
+		/// @return false si le traitement a ete interrompu faute de temps (l'objet
+		/// n'est alors pas modifie)
+		bool _computeAu( 
+			ign::feature::Feature & fAu, 
+			tools::TimeBudget const* budget,
+			bool & modified
+		);
+
+		/// @brief Empreinte des entrees du traitement d'une unite administrative :
+		/// sa geometrie et les donnees (frontieres, portions hors cotes) situees
+		/// dans son emprise elargie du rayon d'influence
+		/// @param fAu Unite administrative
+		/// @param paramsKey Parametres de calcul
+		/// @param radius Rayon d'influence
+		std::string _getAuHash(
+			ign::feature::Feature const& fAu,
+			std::string const& paramsKey,
+			double radius
+		) const;
+
+		//--
+		static uint64_t _getHash( 
+			const ign::geometry::LineString & ls 
+		);
+
 		//--
 		void _getAngles( 
 			tools::SegmentIndexedGeometryCollection* indexedGeom, 
-			const std::vector<ign::geometry::LineString> & vLs,
-			std::vector<std::pair<double, double>> & vGeomFeatures
+			const std::pmr::vector<ign::geometry::LineString> & vLs,
+			std::pmr::vector<std::pair<double, double>> & vGeomFeatures
 		) const;
 
 		//--
@@ -78,34 +225,34 @@ namespace calcul{
 		) const;
 
 		//--
-		int _findIndex( 
+		static int _findIndex( 
 			const ign::geometry::LineString & ls, 
 			size_t startIndex,
 			const ign::geometry::Point & refPoint,
 			double angle,
 			double searchDistance
-		) const ;
+		);
 
 		//--
-		double _getScore(
+		static double _getScore(
 			double refAngle, 
 			double angle, 
 			double distance
-		) const;
+		);
 
 		//--
-		std::pair<int, double> _findIndex( 
+		static std::pair<int, double> _findIndex( 
 			const ign::geometry::LineString & ls, 
 			size_t startIndex,
 			const ign::geometry::Point & refPoint,
 			double refAngle,
 			double searchDistance, 
 			bool positiveDirection
-		) const;
+		);
 
 		//--
 		std::pair<bool, ign::geometry::Point> _findCandidate( 
-			epg::tools::MultiLineStringTool* mlsTool, 
+			tools::LocalTileCache* localBoundary, 
 			const ign::geometry::Point & pt,
 			double angle,
 			double boundSearchDistance,
@@ -114,25 +261,26 @@ namespace calcul{
 
 		//--
 		void _findAngles( 
-			epg::tools::MultiLineStringTool* mlsTool, 
-			std::vector<ign::geometry::LineString> & vLs,
-			const std::vector<std::pair<double, double>> & vGeomFeatures,
+			tools::LocalTileCache* localBoundary, 
+			std::pmr::vector<ign::geometry::LineString> & vLs,
+			const std::pmr::vector<std::pair<double, double>> & vGeomFeatures,
 			double searchDistance,
 			double vertexSnapDist
 		) const;
 
 		//--
 		void _projectTouchingPoints(
-			epg::tools::MultiLineStringTool* mlsTool, 
+			tools::LocalTileCache* localBoundary, 
 			ign::geometry::LineString & ls, 
-			const std::vector<int> & vTouchingPoints,
+			const std::pmr::vector<int> & vTouchingPoints,
 			double searchDistance,
 			double snapDistOnVertex
 		) const;
 
-		//--
-		std::vector<std::pair<int,int>> _getTouchingParts(
-			std::vector<std::pair<int,int>> const& vpNotTouchingParts, 
+		/// @brief Parties complementaires de vpNotTouchingParts (allouees avec la
+		/// ressource memoire de vpNotTouchingParts)
+		std::pmr::vector<std::pair<int,int>> _getTouchingParts(
+			std::pmr::vector<std::pair<int,int>> const& vpNotTouchingParts, 
 			size_t nbPoints, 
 			bool isClosed
 		) const;
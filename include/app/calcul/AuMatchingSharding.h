@@ -0,0 +1,79 @@
+#ifndef _APP_CALCUL_AUMATCHINGSHARDING_H_
+#define _APP_CALCUL_AUMATCHINGSHARDING_H_
+
+//STL
+#include <string>
+#include <vector>
+
+//BOOST
+#include <boost/progress.hpp>
+
+//SOCLE
+#include <ign/feature/Feature.h>
+#include <ign/geometry.h>
+
+//APP
+#include <app/io/Checkpoint.h>
+#include <app/io/FeaturePipeline.h>
+#include <app/io/ResultManifest.h>
+
+namespace app{
+namespace calcul{
+
+	class AuMatchingOp;
+
+	/// @brief Repartition du traitement des unites administratives de l'etape 630
+	/// entre plusieurs processus fils (AU_SHARD_COUNT), un par tuile : bandes
+	/// verticales d'effectifs egaux, chaque processus ne conservant que les
+	/// donnees situees dans l'emprise de sa tuile elargie du rayon d'influence
+	class AuMatchingSharding {
+
+	public:
+
+		/// @brief Traite les unites administratives lues dans pipeline par numShards
+		/// processus fils puis enregistre leurs resultats dans l'ordre de lecture
+		/// (manifeste et point de reprise compris)
+		/// @param op Operateur dont les structures preparees sont chargees
+		/// @param numShards Nombre de processus de calcul
+		/// @return Nombre d'unites administratives non traitees (echec d'un processus)
+		static size_t Compute(
+			AuMatchingOp & op,
+			size_t numShards,
+			io::FeaturePipeline & pipeline,
+			io::ResultManifest & manifest,
+			io::Checkpoint & checkpoint,
+			std::string const& paramsKey,
+			double influenceRadius,
+			boost::progress_display & display
+		);
+
+	private:
+
+		/// @brief Traitement d'une tuile dans un processus fils : les index sont
+		/// restreints a la tuile elargie (halo), les geometries modifiees sont
+		/// ecrites dans un fichier au format d'enregistrement
+		/// @param vAu Unites administratives a traiter
+		/// @param vIndex Indices des unites administratives de la tuile
+		/// @param halo Emprise de la tuile elargie du rayon d'influence
+		/// @param path Fichier resultat
+		static void _computeShard(
+			AuMatchingOp & op,
+			std::vector< ign::feature::Feature > const& vAu,
+			std::vector< size_t > const& vIndex,
+			ign::geometry::Envelope const& halo,
+			std::string const& path
+		);
+
+		//-- ne conserve que les contours de frontiere et les portions hors cotes
+		//-- intersectant le halo (les lignes sont conservees entieres)
+		static void _restrictToHalo(
+			AuMatchingOp & op,
+			ign::geometry::Envelope const& halo
+		);
+
+	};
+
+}
+}
+
+#endif
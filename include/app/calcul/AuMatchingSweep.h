@@ -0,0 +1,57 @@
+#ifndef _APP_CALCUL_AUMATCHINGSWEEP_H_
+#define _APP_CALCUL_AUMATCHINGSWEEP_H_
+
+//STL
+#include <string>
+#include <vector>
+
+//SOCLE
+#include <ign/feature/Feature.h>
+
+//APP
+#include <app/utils/readParameterGrid.h>
+
+namespace app{
+namespace calcul{
+
+	class AuMatchingOp;
+
+	/// @brief Balayage de parametres de l'etape 630 : evaluation de jeux de
+	/// parametres de calcul sans rien enregistrer dans la source de donnees
+	class AuMatchingSweep {
+
+	public:
+
+		/// @brief Evalue des jeux de parametres de calcul sur les unites
+		/// administratives de la table AREA_TABLE sans rien enregistrer dans la
+		/// source de donnees. Les structures preparees et les unites administratives
+		/// sont chargees une seule fois, chaque jeu est evalue dans un processus fils.
+		/// @param countryCode Code pays simple
+		/// @param vParameterSets Jeux de parametres (AU_BOUNDARY_MAX_DIST,
+		/// AU_BOUNDARY_SEARCH_DIST, AU_BOUNDARY_SNAP_DIST, AU_SEGMENT_MIN_LENGTH)
+		/// @param parallelism Nombre de jeux evalues simultanement
+		/// @param reportPath Fichier du rapport (une ligne par jeu)
+		static void Compute(
+			std::string countryCode,
+			std::vector< utils::ParameterSet > const& vParameterSets,
+			size_t parallelism,
+			std::string const& reportPath
+		);
+
+	private:
+
+		/// @brief Evaluation d'un jeu de parametres dans un processus fils : les
+		/// statistiques sont ecrites dans un fichier (une ligne du rapport)
+		static void _evaluate(
+			AuMatchingOp & op,
+			std::vector< ign::feature::Feature > const& vAu,
+			utils::ParameterSet const& parameterSet,
+			std::string const& path
+		);
+
+	};
+
+}
+}
+
+#endif
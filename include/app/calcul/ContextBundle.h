@@ -0,0 +1,72 @@
+#ifndef _APP_CALCUL_CONTEXTBUNDLE_H_
+#define _APP_CALCUL_CONTEXTBUNDLE_H_
+
+//STL
+#include <string>
+
+namespace app{
+namespace calcul{
+
+	class AuMatchingOp;
+
+	/// @brief Contexte de calcul d'une unite administrative de l'etape 630 :
+	/// extraction dans un repertoire (identifiant, parametres effectifs, resultat,
+	/// a cote de l'enregistrement des lectures) et rejeu sans base de donnees
+	class ContextBundle {
+
+	public:
+
+		/// @brief Ecrit dans un repertoire le contexte de calcul d'une unite
+		/// administrative de la table AREA_TABLE : parametres effectifs, identifiant
+		/// et resultat du calcul (rien n'est enregistre dans la source de donnees).
+		/// Les donnees lues (unite administrative, frontieres et portions hors cotes
+		/// situees dans le rayon d'influence) doivent etre enregistrees dans ce meme
+		/// repertoire par un RecordingDataSource.
+		/// @param countryCode Code pays simple
+		/// @param auId Identifiant de l'unite administrative
+		/// @param bundleDirectory Repertoire du contexte
+		static void Dump(
+			std::string countryCode,
+			std::string const& auId,
+			std::string const& bundleDirectory
+		);
+
+		/// @brief Charge les parametres effectifs enregistres par Dump
+		/// (a appeler avant la lecture des noms de tables)
+		static void LoadParameters(
+			std::string const& bundleDirectory
+		);
+
+		/// @brief Rejoue le calcul d'un contexte ecrit par Dump, les lectures
+		/// etant servies par un ReplayDataSource sur le meme repertoire. Une exception
+		/// est levee si le resultat differe de celui enregistre.
+		/// @param countryCode Code pays simple
+		/// @param bundleDirectory Repertoire du contexte
+		/// @param numLoops Nombre d'executions du calcul (profilage)
+		static void Replay(
+			std::string countryCode,
+			std::string const& bundleDirectory,
+			size_t numLoops
+		);
+
+	private:
+
+		//--
+		static void _dump(
+			AuMatchingOp & op,
+			std::string const& bundleDirectory
+		);
+
+		//--
+		static void _replay(
+			AuMatchingOp & op,
+			std::string const& bundleDirectory,
+			size_t numLoops
+		);
+
+	};
+
+}
+}
+
+#endif
@@ -5,9 +5,9 @@
 #include <epg/log/EpgLogger.h>
 #include <epg/log/ShapeLogger.h>
 #include <epg/tools/MultiLineStringTool.h>
-#include <ome2/feature/sql/NotDestroyedTools.h>
 
 //APP
+#include <app/io/DataSource.h>
 #include <app/tools/SegmentIndexedGeometry.h>
 
 namespace app{
@@ -28,11 +28,11 @@ namespace calcul{
 
 	private:
 		//--
-		ign::feature::sql::FeatureStorePostgis*            _fsCoast;
+		io::DataSource*                                    _dataSource;
 		//--
-		ign::feature::sql::FeatureStorePostgis*            _fsBoundary;
+		std::string                                        _coastTableName;
 		//--
-		ign::feature::sql::FeatureStorePostgis*            _fsLandmask;
+		std::string                                        _boundaryTableName;
 		//--
 		epg::tools::MultiLineStringTool*                   _mlsToolLandmask;
 		//--
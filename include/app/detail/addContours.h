@@ -0,0 +1,17 @@
+#ifndef _APP_DETAIL_ADDCONTOURS_H_
+#define _APP_DETAIL_ADDCONTOURS_H_
+
+// SOCLE
+#include <ign/geometry.h>
+
+namespace app{
+namespace detail{
+    //-- ajoute les contours d'une geometrie lineaire ou surfacique a une MultiLineString
+    void addContours(
+        ign::geometry::Geometry const& geom, 
+        ign::geometry::MultiLineString & mls
+    );
+}
+}
+
+#endif
@@ -1,19 +1,31 @@
 #ifndef _APP_DETAIL_EXTRACTNOTTOUCHINGPARTS_H_
 #define _APP_DETAIL_EXTRACTNOTTOUCHINGPARTS_H_
 
+//STL
+#include <memory_resource>
+#include <set>
+#include <vector>
+
 // APP
 #include <app/tools/SegmentIndexedGeometry.h>
+#include <app/tools/TimeBudget.h>
 
 
 namespace app{
 namespace detail{
 
-	//--
-    void extractNotTouchingParts(
+	/// @brief Extrait les parties de ls qui ne sont pas en contact avec refGeom.
+    /// Les structures de travail sont allouees avec la ressource memoire de
+    /// vNotTouchingParts.
+    /// @param budget Budget de temps controle pendant la recherche des contacts
+    /// (pas de limite si nul)
+    /// @return false si le budget de temps est depasse (resultats incomplets)
+    bool extractNotTouchingParts(
         const tools::SegmentIndexedGeometryInterface* refGeom,
         const ign::geometry::LineString & ls, 
-        std::vector<std::pair<int,int>> & vNotTouchingParts,
-        std::vector<int>* vTouchingPoints = 0
+        std::pmr::vector<std::pair<int,int>> & vNotTouchingParts,
+        std::pmr::vector<int>* vTouchingPoints = 0,
+        tools::TimeBudget const* budget = 0
     );
 
     //--
@@ -34,8 +46,8 @@ namespace detail{
 
     //--
     bool commonGroupExists( 
-        std::set<int> const& sGroup1,
-        std::set<int> const& sGroup2
+        std::pmr::set<int> const& sGroup1,
+        std::pmr::set<int> const& sGroup2
     );
 }
 }
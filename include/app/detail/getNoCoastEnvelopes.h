@@ -0,0 +1,26 @@
+#ifndef _APP_DETAIL_GETNOCOASTENVELOPES_H_
+#define _APP_DETAIL_GETNOCOASTENVELOPES_H_
+
+//STL
+#include <vector>
+
+// SOCLE
+#include <ign/geometry.h>
+
+namespace app{
+namespace detail{
+
+	/// @brief Emprises du prefiltre spatial de lecture des unites administratives :
+	/// emprises des portions hors cotes elargies de distance. Au-dela de maxEnvelopes
+	/// portions, les emprises des segments (elargies) sont fusionnees par maille d'une
+	/// grille d'au plus maxEnvelopes mailles couvrant l'etendue des portions. Tout
+	/// objet situe a moins de distance d'une portion intersecte l'une des emprises.
+    std::vector< ign::geometry::Envelope > getNoCoastEnvelopes(
+        ign::geometry::MultiLineString const& mLsNoCoasts,
+        double distance,
+        size_t maxEnvelopes = 64
+    );
+}
+}
+
+#endif
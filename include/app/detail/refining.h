@@ -1,6 +1,9 @@
 #ifndef _APP_DETAIL_REFINING_H_
 #define _APP_DETAIL_REFINING_H_
 
+//STL
+#include <vector>
+
 // APP
 #include <app/tools/SegmentIndexedGeometry.h>
 
@@ -8,15 +11,29 @@
 namespace app{
 namespace detail{
 
-	//--
+	//-- sommet insere par refineAreaWithLsEndings (polygone, contour, indice du sommet)
+    struct RefinedVertex {
+        size_t polygon;
+        size_t ring;
+        size_t index;
+    };
+
+	//-- (vRefined : si renseigne, recoit les sommets inseres dans l'ordre d'insertion)
     void refineAreaWithLsEndings(
         ign::geometry::MultiLineString const& mls,
         ign::geometry::MultiPolygon & mp,
-        double precision = 0.1
+        double precision = 0.1,
+        std::vector< RefinedVertex >* vRefined = 0
+    );
+
+    //-- supprime les sommets inseres par refineAreaWithLsEndings (geometrie initiale)
+    void unrefineArea(
+        ign::geometry::MultiPolygon & mp,
+        std::vector< RefinedVertex > const& vRefined
     );
 
-    //--
-    void refine(
+    //-- (renvoie l'indice du sommet insere, -1 si aucun sommet n'est insere)
+    int refine(
         ign::geometry::LineString & ls,
         ign::geometry::Point const& point,
         double precision
@@ -0,0 +1,82 @@
+#ifndef _APP_IO_CHECKPOINT_H_
+#define _APP_IO_CHECKPOINT_H_
+
+//STL
+#include <set>
+#include <string>
+#include <vector>
+
+
+namespace app{
+namespace io{
+
+	/// @brief Point de reprise d'un traitement objet par objet : liste des
+	/// identifiants des objets dont le resultat a ete valide dans la source de
+	/// donnees. Fichier texte : une ligne d'en-tete portant la cle du traitement
+	/// (table de travail par exemple) puis un identifiant par ligne, ajoutes par
+	/// lots a chaque appel de save. Une derniere ligne incomplete (arret pendant
+	/// l'ecriture) est ignoree a la lecture.
+	class Checkpoint
+	{
+	public:
+
+		/// @brief
+		/// @param path Chemin du fichier (le point de reprise est desactive si vide)
+		/// @param key Cle du traitement
+		Checkpoint(
+			std::string const& path,
+			std::string const& key
+		);
+
+		/// @brief Indique si le point de reprise est active
+		bool isEnabled() const { return !_path.empty(); }
+
+		/// @brief Indique si un point de reprise existe pour la cle
+		static bool Exists(
+			std::string const& path,
+			std::string const& key
+		);
+
+		/// @brief Charge le point de reprise existant
+		/// @return false s'il n'existe pas (ou porte sur une autre cle)
+		bool load();
+
+		/// @brief Cree un point de reprise vide (ecrase l'eventuel existant)
+		void reset();
+
+		/// @brief Indique si l'objet a deja ete traite
+		bool contains( std::string const& id ) const { return _sIds.find( id ) != _sIds.end(); }
+
+		/// @brief Nombre d'objets traites
+		size_t size() const { return _sIds.size(); }
+
+		/// @brief Declare un objet traite (ecrit lors du prochain appel a save)
+		void add( std::string const& id );
+
+		/// @brief Nombre d'objets declares depuis le dernier appel a save
+		size_t numPending() const { return _vPendingIds.size(); }
+
+		/// @brief Ajoute au fichier les objets declares. A appeler une fois
+		/// leurs ecritures validees dans la source de donnees.
+		void save();
+
+		/// @brief Supprime le fichier (traitement termine)
+		void remove();
+
+	private:
+
+		std::string                                        _path;
+		std::string                                        _key;
+		std::set< std::string >                            _sIds;
+		std::vector< std::string >                         _vPendingIds;
+
+	private:
+
+		//--
+		std::string _header() const;
+	};
+
+}
+}
+
+#endif
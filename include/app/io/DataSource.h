@@ -0,0 +1,121 @@
+#ifndef _APP_IO_DATASOURCE_H_
+#define _APP_IO_DATASOURCE_H_
+
+//STL
+#include <memory>
+#include <string>
+
+//SOCLE
+#include <ign/feature/Feature.h>
+
+//EPG
+#include <epg/tools/MultiLineStringTool.h>
+
+//APP
+#include <app/io/Query.h>
+
+
+namespace app{
+namespace io{
+
+	/// @brief Parcours sequentiel d'un ensemble d'objets
+	class FeatureCursor
+	{
+	public:
+
+		/// @brief
+		virtual ~FeatureCursor(){}
+
+		/// @brief Lit l'objet suivant
+		/// @return false s'il n'y a plus d'objet a lire
+		virtual bool next( ign::feature::Feature & feature ) = 0;
+	};
+
+	typedef std::unique_ptr< FeatureCursor >           FeatureCursorPtr;
+
+	/// @brief Interface d'acces aux tables lues et ecrites par les operateurs
+	/// de calcul. Les tables sont designees par leur nom (tel que renseigne dans
+	/// les parametres).
+	class DataSource
+	{
+	public:
+
+		/// @brief
+		virtual ~DataSource(){}
+
+		/// @brief Renvoie un curseur sur les objets de la table verifiant la requete
+		virtual FeatureCursorPtr getFeatures( 
+			std::string const& table, 
+			Query const& query 
+		) = 0;
+
+		/// @brief Nombre d'objets de la table verifiant la requete
+		virtual size_t numFeatures( 
+			std::string const& table, 
+			Query const& query 
+		) = 0;
+
+		/// @brief Cree un nouvel objet (non enregistre) conforme au schema de la table
+		virtual ign::feature::Feature newFeature( 
+			std::string const& table 
+		) = 0;
+
+		/// @brief Enregistre un nouvel objet dans la table
+		virtual void createFeature( 
+			std::string const& table, 
+			ign::feature::Feature & feature 
+		) = 0;
+
+		/// @brief Met a jour un objet existant de la table
+		virtual void modifyFeature( 
+			std::string const& table, 
+			ign::feature::Feature const& feature 
+		) = 0;
+
+		/// @brief Instancie un outil de gestion des contours des objets de la
+		/// table verifiant la requete. L'appelant est responsable de sa destruction.
+		virtual epg::tools::MultiLineStringTool* newMultiLineStringTool( 
+			std::string const& table, 
+			Query const& query 
+		) = 0;
+
+		/// @brief (Re)cree une table de polylignes portant un code pays
+		virtual void createLineStringTable( 
+			std::string const& table 
+		) = 0;
+
+		/// @brief Copie la table des unites administratives de l'etape precedente
+		/// dans la table de travail de l'etape courante. La copie PostGIS reste celle
+		/// de ome2::utils::CopyTableUtils ; les autres sources copient la structure et
+		/// les objets de la table source.
+		virtual void copyAreaTable( 
+			std::string const& fromTable, 
+			std::string const& toTable 
+		) = 0;
+
+		/// @brief Cree (s'il n'existe pas) l'index sur lequel s'appuient les conditions
+		/// Query::containsCode portant sur l'attribut de la table. A appeler lors de la
+		/// preparation des tables d'entree : les lectures ne creent aucun index. Sans
+		/// effet par defaut.
+		virtual void createCodeIndex( 
+			std::string const& table, 
+			std::string const& attribute 
+		){}
+
+		/// @brief Empreinte des geometries des objets de la table verifiant la
+		/// requete : change des qu'un objet est ajoute, supprime ou que sa geometrie
+		/// est modifiee. Par defaut, calculee en parcourant les objets.
+		virtual std::string checksum( 
+			std::string const& table, 
+			Query const& query 
+		);
+
+		/// @brief Valide les ecritures en cours. Sans effet par defaut (ecritures
+		/// validees au fil de l'eau).
+		virtual void commit(){}
+	};
+
+}
+}
+
+#endif
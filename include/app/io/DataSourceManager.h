@@ -0,0 +1,48 @@
+#ifndef _APP_IO_DATASOURCEMANAGER_H_
+#define _APP_IO_DATASOURCEMANAGER_H_
+
+//EPG
+#include <epg/SingletonT.h>
+
+//APP
+#include <app/io/DataSource.h>
+
+
+namespace app{
+namespace io{
+
+	/// @brief Gestionnaire de la source de donnees utilisee par les operateurs.
+	/// Par defaut il s'agit de la base PostGIS configuree dans le contexte, le
+	/// parametre DATA_SOURCE permet de lui substituer un fichier GeoPackage.
+	class DataSourceManager
+	{
+	public:
+
+		/// @brief
+		DataSourceManager();
+
+		/// @brief
+		~DataSourceManager();
+
+		/// @brief Renvoie la source de donnees courante
+		DataSource* getDataSource();
+
+		/// @brief Remplace la source de donnees courante (le gestionnaire en
+		/// prend la propriete)
+		void setDataSource( DataSource* dataSource );
+
+		/// @brief Instancie la source de donnees decrite par le parametre
+		/// DATA_SOURCE. L'appelant est responsable de sa destruction.
+		static DataSource* NewDataSource();
+
+	private:
+
+		DataSource*                                        _dataSource;
+	};
+
+	typedef epg::Singleton< DataSourceManager >       DataSourceManagerS;
+
+}
+}
+
+#endif
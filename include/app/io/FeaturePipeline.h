@@ -0,0 +1,99 @@
+#ifndef _APP_IO_FEATUREPIPELINE_H_
+#define _APP_IO_FEATUREPIPELINE_H_
+
+//STL
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+//APP
+#include <app/io/DataSource.h>
+#include <app/tools/BoundedQueue.h>
+
+
+namespace app{
+namespace io{
+
+	/// @brief Parcours d'une table avec mise a jour des objets, dont les lectures
+	/// et les ecritures sont realisees par deux threads dedies relies au thread de
+	/// calcul par des files bornees : le lecteur precharge les objets suivants
+	/// pendant le calcul, l'ecrivain enregistre les objets modifies par lots.
+	/// Les acces a la source de donnees sont serialises (une seule connexion).
+	/// Avec une taille de file nulle, lectures et ecritures sont realisees
+	/// directement dans le thread appelant.
+	class FeaturePipeline
+	{
+	public:
+
+		/// @brief Demarre la lecture
+		/// @param dataSource Source de donnees
+		/// @param table Table parcourue et mise a jour
+		/// @param query Requete de selection des objets
+		/// @param queueSize Taille des files de lecture et d'ecriture
+		/// @param spatialOrder Parcours des objets selon une courbe de Hilbert
+		/// (HilbertOrderedCursor) plutot que dans l'ordre de lecture
+		FeaturePipeline(
+			DataSource* dataSource,
+			std::string const& table,
+			Query const& query,
+			size_t queueSize,
+			bool spatialOrder
+		);
+
+		/// @brief Interrompt la lecture et termine les ecritures deja demandees
+		~FeaturePipeline();
+
+		/// @brief Objet suivant
+		/// @return false s'il n'y a plus d'objet a lire
+		bool next( ign::feature::Feature & feature );
+
+		/// @brief Demande l'enregistrement d'un objet modifie
+		void write( ign::feature::Feature const& feature );
+
+		/// @brief Nombre d'enregistrements demandes
+		size_t numWritten() const { return _numWritten; }
+
+		/// @brief Attend l'enregistrement des objets deja demandes et valide les
+		/// ecritures de la source de donnees (DataSource::commit) ; propage
+		/// l'eventuelle erreur survenue dans le thread d'ecriture
+		void commit();
+
+		/// @brief Attend la fin des ecritures ; propage l'eventuelle erreur
+		/// survenue dans les threads de lecture ou d'ecriture
+		void finish();
+
+	private:
+
+		DataSource*                                        _dataSource;
+		std::string                                        _table;
+		FeatureCursorPtr                                   _cursor;
+		bool                                               _threaded;
+		std::mutex                                         _dataSourceMutex;
+		tools::BoundedQueue< ign::feature::Feature >       _readQueue;
+		tools::BoundedQueue< ign::feature::Feature >       _writeQueue;
+		std::thread                                        _reader;
+		std::thread                                        _writer;
+		std::exception_ptr                                 _readerError;
+		std::exception_ptr                                 _writerError;
+		size_t                                             _numWritten;
+		size_t                                             _numStored;
+		std::mutex                                         _storedMutex;
+		std::condition_variable                            _stored;
+
+	private:
+
+		//--
+		void _read();
+
+		//--
+		void _write();
+
+		//--
+		void _stop();
+	};
+
+}
+}
+
+#endif
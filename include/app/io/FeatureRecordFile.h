@@ -0,0 +1,88 @@
+#ifndef _APP_IO_FEATURERECORDFILE_H_
+#define _APP_IO_FEATURERECORDFILE_H_
+
+//STL
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+//BOOST
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+//APP
+#include <app/io/DataSource.h>
+
+
+namespace app{
+namespace io{
+
+	/// @brief Ecriture d'un ensemble d'objets au format binaire d'enregistrement.
+	/// Format (little endian) : en-tete 'AUFR' + version (uint32), puis pour chaque
+	/// objet : identifiant, nombre d'attributs, couples (nom, valeur), geometrie WKB.
+	/// Les chaines et la geometrie sont prefixees de leur taille (uint32).
+	/// Seuls les attributs demandes sont enregistres.
+	class FeatureRecordWriter
+	{
+	public:
+
+		/// @brief Cree (ou ecrase) le fichier
+		/// @param path Chemin du fichier
+		/// @param vAttributes Noms des attributs a enregistrer
+		FeatureRecordWriter(
+			std::string const& path,
+			std::vector< std::string > const& vAttributes
+		);
+
+		/// @brief
+		~FeatureRecordWriter();
+
+		/// @brief Ajoute un objet
+		void write( ign::feature::Feature const& feature );
+
+		/// @brief Nombre d'objets ecrits
+		size_t numFeatures() const { return _numFeatures; }
+
+	private:
+
+		std::ofstream                                      _ofs;
+		std::vector< std::string >                         _vAttributes;
+		std::string                                        _buffer;
+		size_t                                             _numFeatures;
+	};
+
+	/// @brief Lecture d'un fichier au format binaire d'enregistrement. Le fichier
+	/// est projete en memoire et les objets sont decodes au fil du parcours.
+	class FeatureRecordReader : public FeatureCursor
+	{
+	public:
+
+		/// @brief
+		FeatureRecordReader( std::string const& path );
+
+		/// @brief
+		virtual bool next( ign::feature::Feature & feature );
+
+	private:
+
+		std::string                                        _path;
+		boost::interprocess::file_mapping                  _mapping;
+		boost::interprocess::mapped_region                 _region;
+		unsigned char const*                               _data;
+		size_t                                             _size;
+		size_t                                             _pos;
+
+	private:
+
+		//--
+		uint32_t _readUInt32();
+
+		//--
+		std::string _readString();
+	};
+
+}
+}
+
+#endif
@@ -0,0 +1,140 @@
+#ifndef _APP_IO_GEOPACKAGEDATASOURCE_H_
+#define _APP_IO_GEOPACKAGEDATASOURCE_H_
+
+//STL
+#include <map>
+#include <vector>
+
+//APP
+#include <app/io/DataSource.h>
+
+struct sqlite3;
+struct sqlite3_stmt;
+
+
+namespace app{
+namespace io{
+
+	/// @brief Source de donnees s'appuyant sur un fichier GeoPackage local.
+	/// Les tables d'entree (frontieres, masque terrestre, unites administratives)
+	/// doivent etre presentes dans le fichier, les tables produites par les
+	/// etapes y sont creees. Le schema eventuel prefixant le nom des tables
+	/// ('schema.table') est ignore.
+	/// Les lectures sont sequentielles (ordre des rowid) et realisees par lots
+	/// prefetches, ce qui autorise la modification d'une table en cours de
+	/// parcours. Les ecritures sont regroupees en transactions.
+	class GeoPackageDataSource : public DataSource
+	{
+	public:
+
+		/// @brief Ouvre le fichier GeoPackage (qui doit exister)
+		GeoPackageDataSource( std::string const& path );
+
+		/// @brief Valide les ecritures en cours et ferme le fichier
+		virtual ~GeoPackageDataSource();
+
+		/// @brief
+		virtual FeatureCursorPtr getFeatures(
+			std::string const& table,
+			Query const& query
+		);
+
+		/// @brief
+		virtual size_t numFeatures(
+			std::string const& table,
+			Query const& query
+		);
+
+		/// @brief
+		virtual ign::feature::Feature newFeature(
+			std::string const& table
+		);
+
+		/// @brief
+		virtual void createFeature(
+			std::string const& table,
+			ign::feature::Feature & feature
+		);
+
+		/// @brief
+		virtual void modifyFeature(
+			std::string const& table,
+			ign::feature::Feature const& feature
+		);
+
+		/// @brief
+		virtual epg::tools::MultiLineStringTool* newMultiLineStringTool(
+			std::string const& table,
+			Query const& query
+		);
+
+		/// @brief
+		virtual void createLineStringTable(
+			std::string const& table
+		);
+
+		/// @brief
+		virtual void copyAreaTable(
+			std::string const& fromTable,
+			std::string const& toTable
+		);
+
+		/// @brief Valide la transaction d'ecriture en cours
+		virtual void commit();
+
+	private:
+
+		struct TableInfo {
+			std::string                                    name;
+			std::string                                    pkName;
+			std::string                                    geomName;
+			int                                            srsId;
+			bool                                           hasRtree;
+			std::vector< std::string >                     vAttributes;
+			sqlite3_stmt*                                  insertStmt;
+			sqlite3_stmt*                                  updateStmt;
+		};
+
+		sqlite3*                                           _db;
+		std::string                                        _path;
+		std::map< std::string, TableInfo >                 _mTables;
+		bool                                               _inTransaction;
+		size_t                                             _numPendingWrites;
+
+	private:
+
+		//--
+		TableInfo & _getTable( std::string const& table );
+
+		//-- clause WHERE (les valeurs des conditions sont a lier dans l'ordre, a partir de l'indice 1)
+		std::string _toSql( TableInfo const& info, Query const& query ) const;
+
+		//--
+		void _forgetTable( std::string const& name );
+
+		//--
+		void _exec( std::string const& sql );
+
+		//--
+		sqlite3_stmt* _prepare( std::string const& sql );
+
+		//--
+		void _beginWrite();
+
+		//--
+		void _endWrite();
+
+		//--
+		void _bindFeature( TableInfo const& info, sqlite3_stmt* stmt, ign::feature::Feature const& feature );
+
+		//--
+		void _registerGeometryTable( std::string const& name, std::string const& geomName, std::string const& geometryType, int srsId );
+
+		//--
+		int _getDefaultSrsId();
+	};
+
+}
+}
+
+#endif
@@ -0,0 +1,139 @@
+#ifndef _APP_IO_GEOMETRYCACHE_H_
+#define _APP_IO_GEOMETRYCACHE_H_
+
+//STL
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+//BOOST
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+//SOCLE
+#include <ign/geometry/LineString.h>
+
+//EPG
+#include <epg/tools/MultiLineStringTool.h>
+
+//APP
+#include <app/io/DataSource.h>
+
+
+namespace app{
+namespace io{
+
+	/// @brief Cache persistant des geometries preparees par un operateur (contours,
+	/// polylignes fusionnees) pour eviter de les relire et de les recalculer d'une
+	/// execution a l'autre.
+	/// Le cache est identifie par une cle regroupant les tables sources, les
+	/// requetes et l'empreinte de leurs geometries (DataSource::checksum) : toute
+	/// modification des donnees sources conduit a un nouveau fichier.
+	/// Format du fichier (projete en memoire a la lecture) : en-tete 'AUGC' +
+	/// version (uint32), cle, nombre de sections (uint32), puis pour chaque section :
+	/// nom, taille en octets (uint64), nombre de polylignes (uint32) et pour chaque
+	/// polyligne son nombre de points (uint32) suivi des coordonnees planes (double).
+	/// Les valeurs sont ecrites dans l'ordre des octets de la machine : le cache
+	/// n'est pas destine a etre partage entre architectures.
+	class GeometryCache
+	{
+	public:
+
+		/// @brief
+		/// @param directory Repertoire du cache (le cache est desactive si vide)
+		/// @param name Prefixe du nom de fichier (etape et pays par exemple)
+		GeometryCache(
+			std::string const& directory,
+			std::string const& name
+		);
+
+		/// @brief
+		~GeometryCache();
+
+		/// @brief Indique si le cache est active
+		bool isEnabled() const { return !_directory.empty(); }
+
+		/// @brief Ajoute une valeur a la cle (parametre de calcul par exemple)
+		void addKey( std::string const& value );
+
+		/// @brief Ajoute a la cle une table source, la requete et l'empreinte
+		/// des objets correspondants
+		void addSource(
+			DataSource & dataSource,
+			std::string const& table,
+			Query const& query
+		);
+
+		/// @brief Ouvre le fichier correspondant a la cle s'il existe
+		/// @return false si le cache est desactive, absent ou illisible
+		bool load();
+
+		/// @brief Lit une section
+		/// @return false si la section n'est pas en cache
+		bool get(
+			std::string const& section,
+			std::vector< ign::geometry::LineString > & vLs
+		) const;
+
+		/// @brief Ajoute (ou remplace) une section, ecrite lors de l'appel a save
+		void set(
+			std::string const& section,
+			std::vector< ign::geometry::LineString > const& vLs
+		);
+
+		/// @brief Contours des objets de la table, lus dans la section si elle est
+		/// en cache, sinon depuis la source de donnees (les contours sont alors
+		/// ajoutes au cache)
+		void getContours(
+			std::string const& section,
+			DataSource & dataSource,
+			std::string const& table,
+			Query const& query,
+			ign::geometry::MultiLineString & mls
+		);
+
+		/// @brief Instancie un outil de gestion des contours des objets de la table
+		/// a partir de la section si elle est en cache, sinon depuis la source de
+		/// donnees (les contours sont alors ajoutes au cache)
+		epg::tools::MultiLineStringTool* newMultiLineStringTool(
+			std::string const& section,
+			DataSource & dataSource,
+			std::string const& table,
+			Query const& query
+		);
+
+		/// @brief Ecrit le fichier si des sections ont ete ajoutees
+		void save();
+
+		/// @brief Chemin du fichier de cache
+		std::string path() const;
+
+	private:
+
+		struct Section {
+			size_t                                         offset;
+			size_t                                         size;
+		};
+
+		std::string                                        _directory;
+		std::string                                        _name;
+		std::string                                        _key;
+		boost::interprocess::file_mapping                  _mapping;
+		boost::interprocess::mapped_region                 _region;
+		std::map< std::string, Section >                   _mSections;
+		std::map< std::string, std::vector< ign::geometry::LineString > > _mNewSections;
+
+	private:
+
+		//--
+		void _decode( Section const& section, std::vector< ign::geometry::LineString > & vLs ) const;
+
+		//--
+		void _unload();
+	};
+
+}
+}
+
+#endif
@@ -0,0 +1,47 @@
+#ifndef _APP_IO_HILBERTORDEREDCURSOR_H_
+#define _APP_IO_HILBERTORDEREDCURSOR_H_
+
+//STL
+#include <vector>
+
+//APP
+#include <app/io/DataSource.h>
+
+
+namespace app{
+namespace io{
+
+	/// @brief Parcours des objets d'un autre curseur dans l'ordre d'une courbe
+	/// de Hilbert sur le centre de leur emprise : les objets consecutifs sont
+	/// voisins, ce qui ameliore la localite des index et des caches du calcul.
+	/// L'ensemble des objets est lu et trie lors du premier appel a next.
+	class HilbertOrderedCursor : public FeatureCursor
+	{
+	public:
+
+		/// @brief
+		/// @param cursor Curseur parcouru (le HilbertOrderedCursor en prend la propriete)
+		HilbertOrderedCursor( FeatureCursorPtr cursor );
+
+		/// @brief
+		virtual bool next( ign::feature::Feature & feature );
+
+	private:
+
+		FeatureCursorPtr                                   _cursor;
+		std::vector< ign::feature::Feature >               _vFeatures;
+		//-- indices des objets dans l'ordre de parcours
+		std::vector< size_t >                              _vOrder;
+		size_t                                             _next;
+		bool                                               _sorted;
+
+	private:
+
+		//--
+		void _sort();
+	};
+
+}
+}
+
+#endif
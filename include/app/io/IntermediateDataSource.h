@@ -0,0 +1,142 @@
+#ifndef _APP_IO_INTERMEDIATEDATASOURCE_H_
+#define _APP_IO_INTERMEDIATEDATASOURCE_H_
+
+//STL
+#include <exception>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+//APP
+#include <app/io/DataSource.h>
+#include <app/io/MemoryDataSource.h>
+#include <app/tools/BoundedQueue.h>
+
+
+namespace app{
+namespace io{
+
+	/// @brief Source de donnees conservant en memoire les tables intermediaires
+	/// produites et relues par les etapes (tables des cotes et des portions de
+	/// frontieres hors cotes) : une fois (re)creee par createLineStringTable,
+	/// une table intermediaire est lue et ecrite en memoire, les autres tables
+	/// (et les tables intermediaires non creees au cours de l'execution) sont
+	/// deleguees a la source de donnees sous-jacente.
+	/// Les tables intermediaires peuvent en outre etre enregistrees dans la
+	/// source sous-jacente par un thread dedie, en dehors du chemin critique
+	/// du calcul. Les acces a la source sous-jacente sont serialises.
+	class IntermediateDataSource : public DataSource
+	{
+	public:
+
+		/// @brief
+		/// @param dataSource Source de donnees sous-jacente (l'IntermediateDataSource
+		/// en prend la propriete)
+		/// @param vTables Noms des tables intermediaires
+		/// @param persist Enregistrement des tables intermediaires dans la source
+		/// sous-jacente
+		IntermediateDataSource(
+			DataSource* dataSource,
+			std::vector< std::string > const& vTables,
+			bool persist
+		);
+
+		/// @brief Termine les enregistrements en cours (les erreurs sont
+		/// inscrites dans le log)
+		virtual ~IntermediateDataSource();
+
+		/// @brief
+		virtual FeatureCursorPtr getFeatures(
+			std::string const& table,
+			Query const& query
+		);
+
+		/// @brief
+		virtual size_t numFeatures(
+			std::string const& table,
+			Query const& query
+		);
+
+		/// @brief
+		virtual ign::feature::Feature newFeature(
+			std::string const& table
+		);
+
+		/// @brief
+		virtual void createFeature(
+			std::string const& table,
+			ign::feature::Feature & feature
+		);
+
+		/// @brief
+		virtual void modifyFeature(
+			std::string const& table,
+			ign::feature::Feature const& feature
+		);
+
+		/// @brief
+		virtual epg::tools::MultiLineStringTool* newMultiLineStringTool(
+			std::string const& table,
+			Query const& query
+		);
+
+		/// @brief
+		virtual void createLineStringTable(
+			std::string const& table
+		);
+
+		/// @brief
+		virtual void copyAreaTable(
+			std::string const& fromTable,
+			std::string const& toTable
+		);
+
+		/// @brief
+		virtual void createCodeIndex(
+			std::string const& table,
+			std::string const& attribute
+		);
+
+		/// @brief
+		virtual std::string checksum(
+			std::string const& table,
+			Query const& query
+		);
+
+		/// @brief
+		virtual void commit();
+
+		/// @brief Attend la fin de l'enregistrement des tables intermediaires ;
+		/// propage l'eventuelle erreur survenue dans le thread d'ecriture
+		void finish();
+
+	private:
+
+		struct PendingFeature {
+			std::string                                    table;
+			ign::feature::Feature                          feature;
+		};
+
+		DataSource*                                        _dataSource;
+		MemoryDataSource                                   _memory;
+		std::set< std::string >                            _sTables;
+		bool                                               _persist;
+		std::mutex                                         _dataSourceMutex;
+		tools::BoundedQueue< PendingFeature >              _writeQueue;
+		std::thread                                        _writer;
+		std::exception_ptr                                 _writerError;
+
+	private:
+
+		//-- table intermediaire creee au cours de l'execution
+		bool _inMemory( std::string const& table ) const;
+
+		//--
+		void _write();
+	};
+
+}
+}
+
+#endif
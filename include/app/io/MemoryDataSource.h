@@ -0,0 +1,102 @@
+#ifndef _APP_IO_MEMORYDATASOURCE_H_
+#define _APP_IO_MEMORYDATASOURCE_H_
+
+//STL
+#include <map>
+#include <vector>
+
+//APP
+#include <app/io/DataSource.h>
+
+
+namespace app{
+namespace io{
+
+	/// @brief Source de donnees dont les tables sont entierement stockees
+	/// en memoire. Les objets sont identifies par leur identifiant (attribue
+	/// automatiquement a la creation s'il est vide).
+	class MemoryDataSource : public DataSource
+	{
+	public:
+
+		/// @brief
+		MemoryDataSource();
+
+		/// @brief
+		virtual ~MemoryDataSource();
+
+		/// @brief
+		virtual FeatureCursorPtr getFeatures( 
+			std::string const& table, 
+			Query const& query 
+		);
+
+		/// @brief
+		virtual size_t numFeatures( 
+			std::string const& table, 
+			Query const& query 
+		);
+
+		/// @brief
+		virtual ign::feature::Feature newFeature( 
+			std::string const& table 
+		);
+
+		/// @brief
+		virtual void createFeature( 
+			std::string const& table, 
+			ign::feature::Feature & feature 
+		);
+
+		/// @brief
+		virtual void modifyFeature( 
+			std::string const& table, 
+			ign::feature::Feature const& feature 
+		);
+
+		/// @brief
+		virtual epg::tools::MultiLineStringTool* newMultiLineStringTool( 
+			std::string const& table, 
+			Query const& query 
+		);
+
+		/// @brief
+		virtual void createLineStringTable( 
+			std::string const& table 
+		);
+
+		/// @brief
+		virtual void copyAreaTable( 
+			std::string const& fromTable, 
+			std::string const& toTable 
+		);
+
+		/// @brief Vide (ou cree) une table
+		void clearTable( std::string const& table );
+
+		/// @brief Indique si la table existe
+		bool hasTable( std::string const& table ) const;
+
+		/// @brief Acces direct au contenu d'une table
+		std::vector< ign::feature::Feature > const& getTable( std::string const& table ) const;
+
+	private:
+
+		struct Table {
+			std::vector< ign::feature::Feature >           vFeatures;
+			std::map< std::string, size_t >                mIndex;
+			size_t                                         nextId;
+		};
+
+		std::map< std::string, Table >                     _mTables;
+
+	private:
+
+		//--
+		Table & _getTable( std::string const& table );
+	};
+
+}
+}
+
+#endif
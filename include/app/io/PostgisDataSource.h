@@ -0,0 +1,114 @@
+#ifndef _APP_IO_POSTGISDATASOURCE_H_
+#define _APP_IO_POSTGISDATASOURCE_H_
+
+//STL
+#include <map>
+#include <set>
+
+//SOCLE
+#include <ign/feature/sql/FeatureStorePostgis.h>
+
+//APP
+#include <app/io/DataSource.h>
+
+
+namespace app{
+namespace io{
+
+	/// @brief Source de donnees s'appuyant sur la base PostGIS du contexte
+	class PostgisDataSource : public DataSource
+	{
+	public:
+
+		/// @brief
+		PostgisDataSource();
+
+		/// @brief
+		virtual ~PostgisDataSource();
+
+		/// @brief
+		virtual FeatureCursorPtr getFeatures( 
+			std::string const& table, 
+			Query const& query 
+		);
+
+		/// @brief
+		virtual size_t numFeatures( 
+			std::string const& table, 
+			Query const& query 
+		);
+
+		/// @brief
+		virtual ign::feature::Feature newFeature( 
+			std::string const& table 
+		);
+
+		/// @brief
+		virtual void createFeature( 
+			std::string const& table, 
+			ign::feature::Feature & feature 
+		);
+
+		/// @brief
+		virtual void modifyFeature( 
+			std::string const& table, 
+			ign::feature::Feature const& feature 
+		);
+
+		/// @brief
+		virtual epg::tools::MultiLineStringTool* newMultiLineStringTool( 
+			std::string const& table, 
+			Query const& query 
+		);
+
+		/// @brief
+		virtual void createLineStringTable( 
+			std::string const& table 
+		);
+
+		/// @brief Copie par ome2::utils::CopyTableUtils::copyAreaTable, comme avant
+		/// l'introduction des sources de donnees : le parametre AREA_TABLE designe
+		/// toTable le temps de la copie, puis reprend sa valeur
+		virtual void copyAreaTable( 
+			std::string const& fromTable, 
+			std::string const& toTable 
+		);
+
+		/// @brief Index d'expression GIN sur le tableau des codes de l'attribut
+		/// (un avertissement est inscrit dans le log si la creation echoue)
+		virtual void createCodeIndex( 
+			std::string const& table, 
+			std::string const& attribute 
+		);
+
+		/// @brief Empreinte calculee par le serveur (md5 des geometries au format
+		/// WKB), sans transfert des objets
+		virtual std::string checksum( 
+			std::string const& table, 
+			Query const& query 
+		);
+
+		/// @brief Traduit la requete portant sur une table en filtre SQL. Les
+		/// conditions sur les codes s'appuient sur un index d'expression GIN
+		/// (cf. createCodeIndex), le prefiltre spatial sur l'operateur && (index
+		/// GiST de la geometrie).
+		std::string toSql( std::string const& table, Query const& query );
+
+	private:
+
+		std::set< std::string >                            _sCodeIndexes;
+		std::map< std::string, int >                       _mSrids;
+
+	private:
+
+		//--
+		int _getSrid( std::string const& table );
+
+		//--
+		ign::feature::sql::FeatureStorePostgis* _getFeatureStore( std::string const& table );
+	};
+
+}
+}
+
+#endif
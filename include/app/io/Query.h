@@ -0,0 +1,84 @@
+#ifndef _APP_IO_QUERY_H_
+#define _APP_IO_QUERY_H_
+
+//STL
+#include <string>
+#include <vector>
+
+//SOCLE
+#include <ign/feature/Feature.h>
+#include <ign/geometry/Envelope.h>
+
+
+namespace app{
+namespace io{
+
+	/// @brief Condition portant sur la valeur d'un attribut
+	struct Condition
+	{
+		enum Operator {
+			EQUALS,
+			CONTAINS,
+			NOT_CONTAINS,
+			CONTAINS_CODE
+		};
+
+		std::string                                        attribute;
+		Operator                                           op;
+		std::string                                        value;
+	};
+
+	/// @brief Requete attributaire independante du support de stockage.
+	/// Les conditions sont combinees par un ET logique. Chaque source de
+	/// donnees se charge de la traduire dans son propre dialecte.
+	class Query
+	{
+	public:
+
+		/// @brief
+		Query(){}
+
+		/// @brief Ajoute la condition 'attribute = value'
+		Query & equals( std::string const& attribute, std::string const& value );
+
+		/// @brief Ajoute la condition 'attribute contient value'
+		Query & contains( std::string const& attribute, std::string const& value );
+
+		/// @brief Ajoute la condition 'attribute ne contient pas value'
+		Query & notContains( std::string const& attribute, std::string const& value );
+
+		/// @brief Ajoute la condition 'value est l'un des codes de attribute', ou
+		/// attribute est une liste de codes separes par '#' (ex : 'fr#be'). A preferer
+		/// a contains pour les codes pays : la condition peut s'appuyer sur un index.
+		Query & containsCode( std::string const& attribute, std::string const& value );
+
+		/// @brief Restreint la requete aux objets dont l'emprise intersecte l'une
+		/// des emprises (prefiltre spatial, evalue sur les rectangles englobants)
+		Query & intersects( std::vector< ign::geometry::Envelope > const& vEnvelopes );
+
+		/// @brief
+		std::vector< ign::geometry::Envelope > const& getEnvelopes() const { return _vEnvelopes; }
+
+		/// @brief
+		std::vector< Condition > const& getConditions() const { return _vConditions; }
+
+		/// @brief Evalue la requete sur un objet en memoire
+		bool matches( ign::feature::Feature const& feature ) const;
+
+		/// @brief Representation textuelle (pour les logs). Les emprises y figurent
+		/// sans arrondi : la representation est utilisee comme cle d'enregistrement.
+		std::string toString() const;
+
+	private:
+
+		std::vector< Condition >                           _vConditions;
+		std::vector< ign::geometry::Envelope >             _vEnvelopes;
+	};
+
+	/// @brief Indique si code est l'un des codes de la liste codes (separes par '#')
+	bool hasCode( std::string const& codes, std::string const& code );
+
+}
+}
+
+#endif
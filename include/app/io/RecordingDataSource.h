@@ -0,0 +1,134 @@
+#ifndef _APP_IO_RECORDINGDATASOURCE_H_
+#define _APP_IO_RECORDINGDATASOURCE_H_
+
+//STL
+#include <fstream>
+#include <vector>
+
+//APP
+#include <app/io/DataSource.h>
+
+
+namespace app{
+namespace io{
+
+	/// @brief Source de donnees enregistrant dans un repertoire toutes les lectures
+	/// realisees sur une autre source (ensembles d'objets, contours utilises par
+	/// les MultiLineStringTool, comptages, empreintes) ainsi que les requetes correspondantes.
+	/// L'enregistrement peut etre rejoue par un ReplayDataSource.
+	/// Le repertoire contient un index texte ('index.txt' : une ligne par lecture,
+	/// dans l'ordre des appels) et un fichier binaire par lecture.
+	class RecordingDataSource : public DataSource
+	{
+	public:
+
+		/// @brief Type de lecture enregistree
+		enum ReadType {
+			FEATURES,
+			CONTOURS,
+			COUNT,
+			CHECKSUM
+		};
+
+		/// @brief
+		/// @param dataSource Source de donnees enregistree (le RecordingDataSource
+		/// en prend la propriete)
+		/// @param directory Repertoire d'enregistrement (cree si besoin)
+		/// @param vAttributes Attributs a enregistrer en plus de ceux des requetes
+		RecordingDataSource(
+			DataSource* dataSource,
+			std::string const& directory,
+			std::vector< std::string > const& vAttributes
+		);
+
+		/// @brief
+		virtual ~RecordingDataSource();
+
+		/// @brief
+		virtual FeatureCursorPtr getFeatures(
+			std::string const& table,
+			Query const& query
+		);
+
+		/// @brief
+		virtual size_t numFeatures(
+			std::string const& table,
+			Query const& query
+		);
+
+		/// @brief
+		virtual ign::feature::Feature newFeature(
+			std::string const& table
+		);
+
+		/// @brief
+		virtual void createFeature(
+			std::string const& table,
+			ign::feature::Feature & feature
+		);
+
+		/// @brief
+		virtual void modifyFeature(
+			std::string const& table,
+			ign::feature::Feature const& feature
+		);
+
+		/// @brief Les contours sont lus via getFeatures sur la source enregistree
+		virtual epg::tools::MultiLineStringTool* newMultiLineStringTool(
+			std::string const& table,
+			Query const& query
+		);
+
+		/// @brief
+		virtual void createLineStringTable(
+			std::string const& table
+		);
+
+		/// @brief
+		virtual void copyAreaTable(
+			std::string const& fromTable,
+			std::string const& toTable
+		);
+
+		/// @brief
+		virtual void createCodeIndex(
+			std::string const& table,
+			std::string const& attribute
+		);
+
+		/// @brief
+		virtual std::string checksum(
+			std::string const& table,
+			Query const& query
+		);
+
+		/// @brief
+		virtual void commit();
+
+		/// @brief Nom du fichier d'index d'un enregistrement
+		static std::string IndexFileName() { return "index.txt"; }
+
+		/// @brief Cle identifiant une lecture dans l'index
+		static std::string Key( ReadType type, std::string const& table, Query const& query );
+
+	private:
+
+		DataSource*                                        _dataSource;
+		std::string                                        _directory;
+		std::vector< std::string >                         _vAttributes;
+		std::ofstream                                      _index;
+		size_t                                             _numRecords;
+
+	private:
+
+		//-- declare une lecture dans l'index et renvoie le chemin du fichier associe
+		std::string _addRecord( ReadType type, std::string const& table, Query const& query );
+
+		//--
+		std::vector< std::string > _getAttributes( Query const& query ) const;
+	};
+
+}
+}
+
+#endif
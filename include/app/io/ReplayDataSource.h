@@ -0,0 +1,103 @@
+#ifndef _APP_IO_REPLAYDATASOURCE_H_
+#define _APP_IO_REPLAYDATASOURCE_H_
+
+//STL
+#include <map>
+#include <vector>
+
+//APP
+#include <app/io/DataSource.h>
+
+
+namespace app{
+namespace io{
+
+	/// @brief Source de donnees rejouant un enregistrement realise par un
+	/// RecordingDataSource : les lectures sont servies depuis les fichiers
+	/// de l'enregistrement (projetes en memoire), les ecritures sont ignorees.
+	/// Une lecture repetee plus souvent que lors de l'enregistrement est servie
+	/// par le dernier enregistrement correspondant.
+	class ReplayDataSource : public DataSource
+	{
+	public:
+
+		/// @brief
+		/// @param directory Repertoire de l'enregistrement
+		ReplayDataSource( std::string const& directory );
+
+		/// @brief
+		virtual ~ReplayDataSource();
+
+		/// @brief
+		virtual FeatureCursorPtr getFeatures(
+			std::string const& table,
+			Query const& query
+		);
+
+		/// @brief
+		virtual size_t numFeatures(
+			std::string const& table,
+			Query const& query
+		);
+
+		/// @brief
+		virtual ign::feature::Feature newFeature(
+			std::string const& table
+		);
+
+		/// @brief Attribue un identifiant a l'objet sans l'enregistrer
+		virtual void createFeature(
+			std::string const& table,
+			ign::feature::Feature & feature
+		);
+
+		/// @brief Sans effet
+		virtual void modifyFeature(
+			std::string const& table,
+			ign::feature::Feature const& feature
+		);
+
+		/// @brief
+		virtual epg::tools::MultiLineStringTool* newMultiLineStringTool(
+			std::string const& table,
+			Query const& query
+		);
+
+		/// @brief Sans effet
+		virtual void createLineStringTable(
+			std::string const& table
+		);
+
+		/// @brief Sans effet
+		virtual void copyAreaTable(
+			std::string const& fromTable,
+			std::string const& toTable
+		);
+
+		/// @brief
+		virtual std::string checksum(
+			std::string const& table,
+			Query const& query
+		);
+
+	private:
+
+		struct Records {
+			std::vector< std::string >                     vValues;
+			size_t                                         next;
+		};
+
+		std::string                                        _directory;
+		std::map< std::string, Records >                   _mRecords;
+		size_t                                             _nextId;
+
+	private:
+
+		//-- valeur (fichier, comptage ou empreinte) de la prochaine lecture correspondant a la cle
+		std::string const& _nextRecord( std::string const& key );
+	};
+
+}
+}
+
+#endif
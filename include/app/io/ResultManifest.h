@@ -0,0 +1,91 @@
+#ifndef _APP_IO_RESULTMANIFEST_H_
+#define _APP_IO_RESULTMANIFEST_H_
+
+//STL
+#include <map>
+#include <memory>
+#include <string>
+
+//APP
+#include <app/io/FeatureRecordFile.h>
+
+
+namespace app{
+namespace io{
+
+	/// @brief Manifeste des resultats d'un traitement objet par objet, conserve
+	/// d'une execution a l'autre : pour chaque objet, l'empreinte de ses entrees
+	/// (geometrie, donnees voisines, parametres) et la geometrie resultat.
+	/// Lors d'une nouvelle execution, un objet dont l'empreinte est inchangee
+	/// reprend le resultat precedent sans etre recalcule.
+	/// Le manifeste de l'execution courante est ecrit dans un fichier temporaire
+	/// (au format des enregistrements, cf. FeatureRecordWriter) qui ne remplace
+	/// le precedent qu'a l'appel de commit : une execution interrompue conserve
+	/// le manifeste precedent.
+	class ResultManifest
+	{
+	public:
+
+		/// @brief Charge le manifeste precedent s'il existe
+		/// @param path Chemin du manifeste (le manifeste est desactive si vide)
+		ResultManifest( std::string const& path );
+
+		/// @brief Supprime le fichier temporaire si commit n'a pas ete appele
+		~ResultManifest();
+
+		/// @brief Indique si le manifeste est active
+		bool isEnabled() const { return !_path.empty(); }
+
+		/// @brief Recherche le resultat de l'execution precedente. Si l'empreinte
+		/// est inchangee, l'objet recoit la geometrie resultat et l'entree est
+		/// reportee dans le manifeste courant.
+		/// @param feature Objet a traiter
+		/// @param hash Empreinte des entrees du traitement de l'objet
+		/// @param written Indique si le resultat avait ete enregistre
+		/// @return false si l'objet doit etre (re)calcule
+		bool find(
+			ign::feature::Feature & feature,
+			std::string const& hash,
+			bool & written
+		);
+
+		/// @brief Ajoute le resultat du traitement d'un objet au manifeste courant
+		void add(
+			ign::feature::Feature const& feature,
+			std::string const& hash,
+			bool written
+		);
+
+		/// @brief Reporte dans le manifeste courant l'entree de l'execution precedente
+		/// d'un objet qui n'est pas traite par l'execution courante (objet deja traite
+		/// avant l'interruption d'une execution reprise). Sans effet si l'objet ne
+		/// figure pas dans le manifeste precedent.
+		/// @param id Identifiant de l'objet
+		void carryForward(
+			std::string const& id
+		);
+
+		/// @brief Remplace le manifeste precedent par le manifeste courant
+		void commit();
+
+		/// @brief Nombre d'objets dont le resultat a ete repris
+		size_t numReused() const { return _numReused; }
+
+	private:
+
+		struct Entry {
+			std::string                                    hash;
+			bool                                           written;
+			ign::feature::Feature                          feature;
+		};
+
+		std::string                                        _path;
+		std::map< std::string, Entry >                     _mPrevious;
+		std::unique_ptr< FeatureRecordWriter >             _writer;
+		size_t                                             _numReused;
+	};
+
+}
+}
+
+#endif
@@ -0,0 +1,151 @@
+#ifndef _APP_IO_SNAPSHOTDATASOURCE_H_
+#define _APP_IO_SNAPSHOTDATASOURCE_H_
+
+//STL
+#include <map>
+#include <set>
+#include <vector>
+
+//APP
+#include <app/io/DataSource.h>
+
+
+namespace app{
+namespace io{
+
+	/// @brief Source de donnees servant des tables partagees (frontieres, masque
+	/// terrestre) depuis un instantane local, construit une fois pour plusieurs
+	/// traitements (un par pays), les autres tables etant deleguees a la source
+	/// de donnees sous-jacente.
+	/// L'instantane est partitionne par code pays : chaque table est decoupee en
+	/// un fichier par code (au format des enregistrements, cf. FeatureRecordWriter),
+	/// un objet portant plusieurs codes ('fr#be') etant copie dans chacune des
+	/// partitions correspondantes. Une requete portant sur le code pays (condition
+	/// equals ou containsCode) ne lit que la partition concernee, projetee en
+	/// memoire. Le repertoire contient un index ('snapshot.txt' : une ligne par
+	/// table, avec l'attribut de partition) et un sous-repertoire par table.
+	/// Les tables de l'instantane sont en lecture seule.
+	class SnapshotDataSource : public DataSource
+	{
+	public:
+
+		/// @brief Table a inclure dans un instantane
+		struct TableSpec {
+			std::string                                    table;
+			std::string                                    partitionAttribute;
+		};
+
+		/// @brief
+		/// @param dataSource Source de donnees sous-jacente (le SnapshotDataSource
+		/// en prend la propriete)
+		/// @param directory Repertoire de l'instantane
+		SnapshotDataSource(
+			DataSource* dataSource,
+			std::string const& directory
+		);
+
+		/// @brief
+		virtual ~SnapshotDataSource();
+
+		/// @brief Construit un instantane
+		/// @param dataSource Source de donnees lue
+		/// @param directory Repertoire de l'instantane (cree si besoin)
+		/// @param vTables Tables a inclure
+		/// @param sCodes Codes pays conserves (tous si vide)
+		/// @param vAttributes Attributs enregistres (en plus des attributs de partition)
+		static void Build(
+			DataSource & dataSource,
+			std::string const& directory,
+			std::vector< TableSpec > const& vTables,
+			std::set< std::string > const& sCodes,
+			std::vector< std::string > const& vAttributes
+		);
+
+		/// @brief Nom du fichier d'index d'un instantane
+		static std::string IndexFileName() { return "snapshot.txt"; }
+
+		/// @brief
+		virtual FeatureCursorPtr getFeatures(
+			std::string const& table,
+			Query const& query
+		);
+
+		/// @brief
+		virtual size_t numFeatures(
+			std::string const& table,
+			Query const& query
+		);
+
+		/// @brief
+		virtual ign::feature::Feature newFeature(
+			std::string const& table
+		);
+
+		/// @brief
+		virtual void createFeature(
+			std::string const& table,
+			ign::feature::Feature & feature
+		);
+
+		/// @brief
+		virtual void modifyFeature(
+			std::string const& table,
+			ign::feature::Feature const& feature
+		);
+
+		/// @brief
+		virtual epg::tools::MultiLineStringTool* newMultiLineStringTool(
+			std::string const& table,
+			Query const& query
+		);
+
+		/// @brief
+		virtual void createLineStringTable(
+			std::string const& table
+		);
+
+		/// @brief
+		virtual void copyAreaTable(
+			std::string const& fromTable,
+			std::string const& toTable
+		);
+
+		/// @brief
+		virtual void createCodeIndex(
+			std::string const& table,
+			std::string const& attribute
+		);
+
+		/// @brief
+		virtual std::string checksum(
+			std::string const& table,
+			Query const& query
+		);
+
+		/// @brief
+		virtual void commit();
+
+	private:
+
+		struct SnapshotTable {
+			std::string                                    partitionAttribute;
+			std::string                                    directory;
+		};
+
+		DataSource*                                        _dataSource;
+		std::string                                        _directory;
+		std::map< std::string, SnapshotTable >             _mTables;
+
+	private:
+
+		//--
+		SnapshotTable const* _getTable( std::string const& table ) const;
+
+		//--
+		void _checkWritable( std::string const& table ) const;
+	};
+
+}
+}
+
+#endif
@@ -0,0 +1,42 @@
+#ifndef _APP_IO_WKB_H_
+#define _APP_IO_WKB_H_
+
+//STL
+#include <string>
+
+//SOCLE
+#include <ign/geometry.h>
+
+
+namespace app{
+namespace io{
+
+	/// @brief Encodage/decodage Well-Known Binary (2D, little endian en ecriture).
+	/// Types supportes : Point, LineString, Polygon, MultiLineString, MultiPolygon.
+	/// Les coordonnees Z/M eventuelles sont ignorees a la lecture.
+	class Wkb
+	{
+	public:
+
+		/// @brief Ajoute l'encodage WKB de geom a la fin de buffer
+		static void Write( 
+			ign::geometry::Geometry const& geom, 
+			std::string & buffer 
+		);
+
+		/// @brief Decode une geometrie WKB. L'appelant est responsable de la
+		/// destruction de la geometrie renvoyee.
+		/// @param data Debut du WKB
+		/// @param size Taille disponible
+		/// @param readSize Nombre d'octets lus (optionnel)
+		static ign::geometry::Geometry* Read( 
+			unsigned char const* data, 
+			size_t size,
+			size_t* readSize = 0
+		);
+	};
+
+}
+}
+
+#endif
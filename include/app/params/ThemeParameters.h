@@ -14,6 +14,10 @@
 		
 		DB_CONF_FILE,
 		WORKING_SCHEMA,
+		DATA_SOURCE,
+		DATA_SOURCE_FILE,
+		GEOMETRY_CACHE_DIRECTORY,
+		INTERMEDIATE_TABLES,
 		BOUNDARY_TYPE_INLAND_WATER_BOUNDARY,
 		AREA_TABLE_INIT,
 		AREA_TABLE_INIT_BASE,
@@ -34,7 +38,24 @@
 		AU_COAST_MAX_DIST,
 		AU_COAST_SEARCH_DIST,
 		AU_COAST_SNAP_DIST,
-		AU_SEGMENT_MIN_LENGTH
+		AU_SEGMENT_MIN_LENGTH,
+		AU_FEATURE_TIME_BUDGET,
+		AU_PIPELINE_QUEUE_SIZE,
+		AU_SPATIAL_ORDER,
+		AU_BOUNDARY_TILE_SIZE,
+		AU_BOUNDARY_TILE_CACHE_SIZE,
+		AU_MANIFEST_DIRECTORY,
+		AU_CHECKPOINT_DIRECTORY,
+		AU_CHECKPOINT_INTERVAL,
+		AU_RESUME,
+		AU_SHARD_COUNT,
+		AU_TARGET_IDS,
+		AU_TARGET_BBOX,
+		AU_TARGET_SOURCE_TABLE,
+		AU_PREFILTER_CHECK,
+
+		ALLOCATION_TRACKING,
+		ALLOCATION_TRACKING_TOP_K
 		
 	};
 
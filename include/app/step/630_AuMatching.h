@@ -2,6 +2,7 @@
 #define _APP_STEP_AUMATCHING_H_
 
 #include <epg/step/StepBase.h>
+#include <app/calcul/AuMatchingIndexes.h>
 #include <app/params/ThemeParameters.h>
 
 namespace app{
@@ -11,6 +12,11 @@ namespace step{
 
 	public:
 
+		/// \brief
+		/// \param sharedIndexes Structures preparees conservees d'une execution a
+		/// l'autre (traitement de plusieurs niveaux administratifs), non detenues
+		AuMatching( calcul::AuMatchingIndexes* sharedIndexes = 0 ): _sharedIndexes( sharedIndexes ) {};
+
 		/// \brief
 		int getCode() { return 630; };
 
@@ -23,6 +29,10 @@ namespace step{
 		/// \brief
 		void init();
 
+	private:
+		//--
+		calcul::AuMatchingIndexes*                         _sharedIndexes;
+
 	};
 
 }
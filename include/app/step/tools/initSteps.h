@@ -15,12 +15,15 @@ namespace app{
 namespace step{
 namespace tools{
 
+	/// @brief Enregistre les etapes du traitement
+	/// @param sharedIndexes Structures preparees de l'etape 630 conservees d'une
+	/// execution a l'autre (non detenues, aucune par defaut)
 	template<  typename StepSuiteType >
-	void initSteps( StepSuiteType& stepSuite )
+	void initSteps( StepSuiteType& stepSuite, calcul::AuMatchingIndexes* sharedIndexes = 0 )
 	{
 		stepSuite.addStep( epg::step::factoryNew< InitLandmaskCoast >() );
 		stepSuite.addStep( epg::step::factoryNew< InitLandmaskNoCoast >() );
-		stepSuite.addStep( epg::step::factoryNew< AuMatching >() );
+		stepSuite.addStep( new AuMatching( sharedIndexes ) );
 	}
 
 }
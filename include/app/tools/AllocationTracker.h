@@ -0,0 +1,144 @@
+#ifndef _APP_TOOLS_ALLOCATIONTRACKER_H_
+#define _APP_TOOLS_ALLOCATIONTRACKER_H_
+
+//STL
+#include <queue>
+#include <string>
+#include <vector>
+
+
+namespace app{
+namespace tools{
+
+	/// @brief Compteurs d'allocations dynamiques (operateurs new/delete globaux)
+	struct AllocationStats
+	{
+		/// @brief Nombre d'allocations
+		size_t                                             numAllocations;
+		/// @brief Nombre de liberations
+		size_t                                             numDeallocations;
+		/// @brief Volume alloue (octets)
+		size_t                                             allocatedBytes;
+		/// @brief Volume vivant (octets, peut etre negatif si des blocs alloues par
+		/// un autre thread sont liberes par le thread courant)
+		long long                                          liveBytes;
+		/// @brief Pic du volume vivant (octets)
+		long long                                          peakLiveBytes;
+
+		/// @brief
+		AllocationStats():
+			numAllocations( 0 ),
+			numDeallocations( 0 ),
+			allocatedBytes( 0 ),
+			liveBytes( 0 ),
+			peakLiveBytes( 0 )
+		{
+		}
+
+		/// @brief
+		std::string toString() const;
+	};
+
+	/// @brief Suivi des allocations dynamiques. Les operateurs new/delete globaux sont
+	/// remplaces lorsque l'application est compilee avec l'option CMake
+	/// ALLOCATION_TRACKING ; les compteurs sont alors tenus par thread.
+	class AllocationTracker
+	{
+	public:
+
+		/// @brief Niveau de rapport
+		enum Level {
+			NONE = 0,
+			PHASE = 1,
+			FEATURE = 2
+		};
+
+		/// @brief Indique si les operateurs new/delete instrumentes sont compiles
+		static bool IsAvailable();
+
+		/// @brief
+		static void SetLevel( Level level );
+
+		/// @brief
+		static Level GetLevel();
+
+		/// @brief Compteurs courants du thread
+		static AllocationStats Current();
+	};
+
+	/// @brief Mesure des allocations du thread courant sur une portee. Les portees
+	/// peuvent etre imbriquees.
+	class AllocationScope
+	{
+	public:
+
+		/// @brief
+		AllocationScope();
+
+		/// @brief
+		~AllocationScope();
+
+		/// @brief Allocations realisees depuis la creation de la portee (le pic est
+		/// relatif au volume vivant a la creation)
+		AllocationStats stats() const;
+
+	private:
+		//--
+		AllocationStats                                    _start;
+		//--
+		long long                                          _outerPeak;
+	};
+
+	/// @brief Portee correspondant a une phase de traitement : les allocations sont
+	/// inscrites dans le log a sa destruction si le niveau de rapport est au moins
+	/// AllocationTracker::PHASE.
+	class AllocationPhase
+	{
+	public:
+
+		/// @brief
+		AllocationPhase( std::string const& name );
+
+		/// @brief
+		~AllocationPhase();
+
+	private:
+		//--
+		std::string                                        _name;
+		//--
+		AllocationScope                                    _scope;
+	};
+
+	/// @brief Classement des objets les plus consommateurs en volume alloue
+	class AllocationRanking
+	{
+	public:
+
+		/// @brief
+		/// @param size Nombre d'objets conserves
+		AllocationRanking( size_t size );
+
+		/// @brief
+		void add( std::string const& id, AllocationStats const& stats );
+
+		/// @brief Inscrit le classement dans le log
+		void log( std::string const& title ) const;
+
+	private:
+		//--
+		typedef std::pair< size_t, std::pair< std::string, AllocationStats > > Entry;
+		//--
+		struct EntryGreater
+		{
+			bool operator()( Entry const& a, Entry const& b ) const { return a.first > b.first; }
+		};
+		//--
+		size_t                                                                     _size;
+		//--
+		std::priority_queue< Entry, std::vector< Entry >, EntryGreater >          _heap;
+	};
+
+}
+}
+
+#endif
@@ -0,0 +1,98 @@
+#ifndef _APP_TOOLS_BOUNDEDQUEUE_H_
+#define _APP_TOOLS_BOUNDEDQUEUE_H_
+
+//STL
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+
+namespace app{
+namespace tools{
+
+	/// @brief File bornee partagee entre threads. L'ajout bloque tant que la file
+	/// est pleine (contre-pression), le retrait tant qu'elle est vide. Une fois
+	/// fermee, la file n'accepte plus d'element et ses consommateurs la vident
+	/// avant d'etre liberes.
+	template< typename T >
+	class BoundedQueue
+	{
+	public:
+
+		/// @brief
+		/// @param capacity Nombre maximum d'elements en attente (au moins 1)
+		BoundedQueue( size_t capacity ):
+			_capacity( capacity > 0 ? capacity : 1 ),
+			_closed( false )
+		{
+		}
+
+		/// @brief Ajoute un element (bloquant si la file est pleine)
+		/// @return false si la file a ete fermee
+		bool push( T const& value )
+		{
+			std::unique_lock< std::mutex > lock( _mutex );
+			_notFull.wait( lock, [this]{ return _closed || _queue.size() < _capacity; } );
+			if ( _closed ) return false;
+			_queue.push_back( value );
+			_notEmpty.notify_one();
+			return true;
+		}
+
+		/// @brief Retire un element (bloquant si la file est vide)
+		/// @return false si la file est fermee et vide
+		bool pop( T & value )
+		{
+			std::unique_lock< std::mutex > lock( _mutex );
+			_notEmpty.wait( lock, [this]{ return _closed || !_queue.empty(); } );
+			if ( _queue.empty() ) return false;
+			value = _queue.front();
+			_queue.pop_front();
+			_notFull.notify_one();
+			return true;
+		}
+
+		/// @brief Retire tous les elements en attente (bloquant si la file est vide)
+		/// @return false si la file est fermee et vide
+		bool popAll( std::vector< T > & values )
+		{
+			std::unique_lock< std::mutex > lock( _mutex );
+			_notEmpty.wait( lock, [this]{ return _closed || !_queue.empty(); } );
+			if ( _queue.empty() ) return false;
+			values.insert( values.end(), _queue.begin(), _queue.end() );
+			_queue.clear();
+			_notFull.notify_all();
+			return true;
+		}
+
+		/// @brief Ferme la file et reveille les threads en attente
+		void close()
+		{
+			std::lock_guard< std::mutex > lock( _mutex );
+			_closed = true;
+			_notFull.notify_all();
+			_notEmpty.notify_all();
+		}
+
+		/// @brief Rouvre la file (une fois ses consommateurs arretes)
+		void reopen()
+		{
+			std::lock_guard< std::mutex > lock( _mutex );
+			_closed = false;
+		}
+
+	private:
+
+		size_t                                             _capacity;
+		bool                                               _closed;
+		std::deque< T >                                    _queue;
+		std::mutex                                         _mutex;
+		std::condition_variable                            _notFull;
+		std::condition_variable                            _notEmpty;
+	};
+
+}
+}
+
+#endif
@@ -0,0 +1,130 @@
+#ifndef _APP_TOOLS_DIAGNOSTICWRITER_H_
+#define _APP_TOOLS_DIAGNOSTICWRITER_H_
+
+//STL
+#include <memory>
+#include <string>
+#include <vector>
+
+//SOCLE
+#include <ign/feature/Feature.h>
+
+//EPG
+#include <epg/log/ShapeLogger.h>
+
+
+namespace app{
+namespace tools{
+
+	/// @brief Ecriture d'enregistrements de diagnostic dans le ShapeLogger. Un
+	/// enregistrement ne porte que l'identifiant de l'objet traite et une geometrie :
+	/// l'objet lui-meme (geometrie complete et attributs) n'est pas copie. 
+	/// L'enregistrement est reutilise d'une ecriture a l'autre. En mode differe,
+	/// seuls la couche (par son rang), l'identifiant et une copie de la geometrie
+	/// sont conserves : l'enregistrement n'est renseigne qu'a l'inscription.
+	class DiagnosticWriter
+	{
+	public:
+
+		/// @brief
+		DiagnosticWriter():
+			_shapeLogger( epg::log::ShapeLoggerS::getInstance() ),
+			_buffered( false ),
+			_numPending( 0 )
+		{
+		}
+
+		/// @brief Inscrit une geometrie dans une couche de diagnostic
+		/// @param layer Nom de la couche (declaree via ShapeLogger::addShape)
+		/// @param id Identifiant de l'objet a l'origine du diagnostic
+		/// @param geometry Geometrie a inscrire
+		void write(
+			std::string const& layer,
+			std::string const& id,
+			ign::geometry::Geometry const& geometry
+		) {
+			if ( !_shapeLogger ) return;
+			if ( _buffered ) {
+				// les emplacements (et la capacite des identifiants) sont reutilises
+				if ( _numPending == _vPending.size() ) _vPending.push_back( PendingRecord() );
+				PendingRecord & pending = _vPending[_numPending++];
+				pending.layer = _layerIndex( layer );
+				pending.id = id;
+				pending.geometry.reset( geometry.clone() );
+				return;
+			}
+			_record.setId( id );
+			_record.setGeometry( geometry );
+			_shapeLogger->writeFeature( layer, _record );
+		}
+
+		/// @brief Desactive les ecritures (processus fils ne devant pas ecrire
+		/// dans les fichiers ouverts par le processus parent)
+		void disable() { _shapeLogger = 0; }
+
+		/// @brief Passe en mode differe : les enregistrements suivants sont conserves
+		/// jusqu'a l'appel de flush ou de discard (les enregistrements encore en
+		/// attente sont abandonnes)
+		void buffer() { discard(); _buffered = true; }
+
+		/// @brief Inscrit les enregistrements en attente et quitte le mode differe
+		void flush()
+		{
+			if ( _shapeLogger ) {
+				for ( size_t i = 0 ; i < _numPending ; ++i ) {
+					_record.setId( _vPending[i].id );
+					_record.setGeometry( *_vPending[i].geometry );
+					_shapeLogger->writeFeature( _vLayers[_vPending[i].layer], _record );
+				}
+			}
+			discard();
+		}
+
+		/// @brief Abandonne les enregistrements en attente et quitte le mode differe
+		void discard()
+		{
+			for ( size_t i = 0 ; i < _numPending ; ++i ) _vPending[i].geometry.reset();
+			_numPending = 0;
+			_buffered = false;
+		}
+
+	private:
+
+		//-- enregistrement differe
+		struct PendingRecord
+		{
+			size_t                                         layer;
+			std::string                                    id;
+			std::unique_ptr< ign::geometry::Geometry >     geometry;
+		};
+
+	private:
+		//--
+		epg::log::ShapeLogger*                             _shapeLogger;
+		//--
+		ign::feature::Feature                              _record;
+		//-- mode differe
+		bool                                               _buffered;
+		//-- couches rencontrees en mode differe
+		std::vector< std::string >                         _vLayers;
+		//-- enregistrements en attente (les _numPending premiers)
+		std::vector< PendingRecord >                       _vPending;
+		//--
+		size_t                                             _numPending;
+
+	private:
+
+		//--
+		size_t _layerIndex( std::string const& layer )
+		{
+			for ( size_t i = 0 ; i < _vLayers.size() ; ++i )
+				if ( _vLayers[i] == layer ) return i;
+			_vLayers.push_back( layer );
+			return _vLayers.size() - 1;
+		}
+	};
+
+}
+}
+
+#endif
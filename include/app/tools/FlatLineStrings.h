@@ -0,0 +1,111 @@
+#ifndef _APP_TOOLS_FLATLINESTRINGS_H_
+#define _APP_TOOLS_FLATLINESTRINGS_H_
+
+//STL
+#include <cmath>
+#include <vector>
+
+//SOCLE
+#include <ign/geometry.h>
+#include <ign/Exception.h>
+
+
+namespace app{
+namespace tools{
+
+	/// @brief Ensemble de polylignes dont les coordonnees sont stockees dans deux
+	/// tableaux contigus (x et y), les polylignes etant delimitees par des
+	/// decalages. Le segment i relie les points i et i+1 d'une meme polyligne.
+	/// Permet des calculs de distance sans manipuler d'objets geometriques.
+	class FlatLineStrings
+	{
+	public:
+
+		/// @brief
+		FlatLineStrings()
+		{
+			_vOffsets.push_back( 0 );
+		}
+
+		/// @brief Ajoute une polyligne
+		void add( ign::geometry::LineString const& ls )
+		{
+			_vX.reserve( _vX.size() + ls.numPoints() );
+			_vY.reserve( _vY.size() + ls.numPoints() );
+			for ( size_t i = 0 ; i < ls.numPoints() ; ++i ) {
+				_vX.push_back( ls.pointN(i).x() );
+				_vY.push_back( ls.pointN(i).y() );
+			}
+			_vOffsets.push_back( _vX.size() );
+		}
+
+		/// @brief Ajoute les polylignes (ou les contours) d'une geometrie lineaire
+		/// ou surfacique
+		void add( ign::geometry::Geometry const& geom )
+		{
+			switch( geom.getGeometryType() )
+			{
+			case ign::geometry::Geometry::GeometryTypeLineString :
+				add( geom.asLineString() );
+				break;
+			case ign::geometry::Geometry::GeometryTypeMultiLineString :
+				for ( size_t i = 0 ; i < geom.asMultiLineString().numGeometries() ; ++i )
+					add( geom.asMultiLineString().lineStringN(i) );
+				break;
+			case ign::geometry::Geometry::GeometryTypePolygon :
+				for ( size_t i = 0 ; i < geom.asPolygon().numRings() ; ++i )
+					add( geom.asPolygon().ringN(i) );
+				break;
+			case ign::geometry::Geometry::GeometryTypeMultiPolygon :
+				for ( size_t i = 0 ; i < geom.asMultiPolygon().numGeometries() ; ++i )
+					add( geom.asMultiPolygon().polygonN(i) );
+				break;
+			default :
+				IGN_THROW_EXCEPTION( "[ app::tools::FlatLineStrings ] Geometry type '"+ign::geometry::Geometry::GeometryTypeName(geom.getGeometryType())+"' not allowed." );
+			}
+		}
+
+		/// @brief
+		size_t numLineStrings() const { return _vOffsets.size()-1; }
+
+		/// @brief Indice du premier point de la polyligne
+		size_t begin( size_t lineString ) const { return _vOffsets[lineString]; }
+
+		/// @brief Indice suivant le dernier point de la polyligne
+		size_t end( size_t lineString ) const { return _vOffsets[lineString+1]; }
+
+		/// @brief
+		double x( size_t i ) const { return _vX[i]; }
+
+		/// @brief
+		double y( size_t i ) const { return _vY[i]; }
+
+		/// @brief Point i
+		ign::geometry::Point pointN( size_t i ) const { return ign::geometry::Point( _vX[i], _vY[i] ); }
+
+		/// @brief Distance du point (px, py) au segment i
+		double segmentDistance( size_t i, double px, double py ) const
+		{
+			double const x1 = _vX[i], y1 = _vY[i];
+			double const dx = _vX[i+1] - x1, dy = _vY[i+1] - y1;
+			double const length2 = dx*dx + dy*dy;
+
+			double t = length2 > 0 ? ( ( px-x1 )*dx + ( py-y1 )*dy ) / length2 : 0;
+			if ( t < 0 ) t = 0;
+			else if ( t > 1 ) t = 1;
+
+			double const ex = px - ( x1 + t*dx ), ey = py - ( y1 + t*dy );
+			return std::sqrt( ex*ex + ey*ey );
+		}
+
+	private:
+
+		std::vector< double >                              _vX;
+		std::vector< double >                              _vY;
+		std::vector< size_t >                              _vOffsets;
+	};
+
+}
+}
+
+#endif
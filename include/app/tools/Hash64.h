@@ -0,0 +1,63 @@
+#ifndef _APP_TOOLS_HASH64_H_
+#define _APP_TOOLS_HASH64_H_
+
+//STL
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+
+namespace app{
+namespace tools{
+
+	/// @brief Empreinte FNV-1a 64 bits, calculee au fil de l'eau (non cryptographique :
+	/// sert a detecter une modification des donnees ou a nommer des fichiers)
+	class Hash64
+	{
+	public:
+
+		/// @brief
+		Hash64():
+			_value( 14695981039346656037ULL )
+		{
+		}
+
+		/// @brief
+		Hash64 & add( void const* data, size_t size )
+		{
+			unsigned char const* bytes = static_cast< unsigned char const* >( data );
+			for ( size_t i = 0 ; i < size ; ++i ) {
+				_value ^= bytes[i];
+				_value *= 1099511628211ULL;
+			}
+			return *this;
+		}
+
+		/// @brief Ajoute une chaine (prefixee de sa taille)
+		Hash64 & add( std::string const& value )
+		{
+			uint64_t const size = value.size();
+			add( &size, sizeof( size ) );
+			return add( value.data(), value.size() );
+		}
+
+		/// @brief
+		uint64_t value() const { return _value; }
+
+		/// @brief Representation hexadecimale
+		std::string toString() const
+		{
+			char buffer[17];
+			std::snprintf( buffer, sizeof( buffer ), "%016llx", static_cast< unsigned long long >( _value ) );
+			return buffer;
+		}
+
+	private:
+
+		uint64_t                                           _value;
+	};
+
+}
+}
+
+#endif
@@ -0,0 +1,83 @@
+#ifndef _APP_TOOLS_HILBERTCURVE_H_
+#define _APP_TOOLS_HILBERTCURVE_H_
+
+//STL
+#include <algorithm>
+#include <cstdint>
+
+//SOCLE
+#include <ign/geometry/Envelope.h>
+
+
+namespace app{
+namespace tools{
+
+	/// @brief Rang des points d'une emprise le long d'une courbe de Hilbert
+	/// (grille de 2^16 x 2^16 cellules) : deux points proches sur la courbe sont
+	/// proches dans le plan, ce qui permet d'ordonner des objets pour la localite
+	class HilbertCurve
+	{
+	public:
+
+		/// @brief
+		/// @param extent Emprise couverte par la courbe
+		HilbertCurve( ign::geometry::Envelope const& extent ):
+			_xmin( extent.xmin() ),
+			_ymin( extent.ymin() ),
+			_scaleX( extent.xmax() > extent.xmin() ? ( GRID_SIZE - 1 ) / ( extent.xmax() - extent.xmin() ) : 0 ),
+			_scaleY( extent.ymax() > extent.ymin() ? ( GRID_SIZE - 1 ) / ( extent.ymax() - extent.ymin() ) : 0 )
+		{
+		}
+
+		/// @brief Rang de la cellule contenant le point (les points hors de
+		/// l'emprise sont ramenes sur son bord)
+		uint64_t key( double x, double y ) const
+		{
+			return _key( _cell( x, _xmin, _scaleX ), _cell( y, _ymin, _scaleY ) );
+		}
+
+	private:
+
+		//--
+		static const uint32_t GRID_SIZE = 1u << 16;
+
+		double                                             _xmin;
+		double                                             _ymin;
+		double                                             _scaleX;
+		double                                             _scaleY;
+
+	private:
+
+		//--
+		static uint32_t _cell( double value, double min, double scale )
+		{
+			double const cell = ( value - min ) * scale;
+			return static_cast< uint32_t >( std::min( std::max( cell, 0. ), double( GRID_SIZE - 1 ) ) );
+		}
+
+		//-- conversion (x, y) -> rang par quadrants successifs, du plus grand au plus petit
+		static uint64_t _key( uint32_t x, uint32_t y )
+		{
+			uint64_t key = 0;
+			for ( uint32_t s = GRID_SIZE / 2 ; s > 0 ; s /= 2 ) {
+				uint32_t const rx = ( x & s ) > 0 ? 1 : 0;
+				uint32_t const ry = ( y & s ) > 0 ? 1 : 0;
+				key += static_cast< uint64_t >( s ) * s * ( ( 3 * rx ) ^ ry );
+
+				// rotation du quadrant
+				if ( ry == 0 ) {
+					if ( rx == 1 ) {
+						x = s - 1 - ( x & ( s - 1 ) );
+						y = s - 1 - ( y & ( s - 1 ) );
+					}
+					std::swap( x, y );
+				}
+			}
+			return key;
+		}
+	};
+
+}
+}
+
+#endif
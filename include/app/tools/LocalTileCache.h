@@ -0,0 +1,118 @@
+#ifndef _APP_TOOLS_LOCALTILECACHE_H_
+#define _APP_TOOLS_LOCALTILECACHE_H_
+
+//STL
+#include <cstdint>
+#include <list>
+#include <map>
+#include <vector>
+
+//SOCLE
+#include <ign/geometry.h>
+
+//EPG
+#include <epg/tools/MultiLineStringTool.h>
+
+
+namespace app{
+namespace tools{
+
+	/// @brief Cache des extractions locales (MultiLineStringTool::getLocal) realisees
+	/// sur une grille reguliere de tuiles : les portions de geometrie d'une tuile sont
+	/// extraites une seule fois et conservees tant que la tuile fait partie des
+	/// tuiles les plus recemment utilisees. Les requetes voisines (parties d'une
+	/// meme unite administrative, unites administratives voisines) sont servies
+	/// sans nouvelle extraction ni copie.
+	/// Une portion est restituee si son emprise intersecte l'emprise demandee, soit
+	/// le meme ensemble que MultiLineStringTool::getLocal (l'ordre peut differer).
+	/// Les portions a cheval sur plusieurs tuiles sont stockees et restituees une
+	/// seule fois : elles sont identifiees par leurs coordonnees et, pour des
+	/// portions de meme geometrie issues d'objets distincts (frontieres partagees),
+	/// par leur rang parmi ces portions dans l'extraction d'une tuile. Chaque copie
+	/// est ainsi restituee, comme par MultiLineStringTool::getLocal.
+	class LocalTileCache
+	{
+	public:
+
+		/// @brief
+		/// @param tool Outil interroge (non detenu)
+		/// @param tileSize Cote des tuiles (pas de cache si <= 0 : chaque requete est
+		/// transmise a l'outil)
+		/// @param maxTiles Nombre maximum de tuiles conservees
+		LocalTileCache(
+			epg::tools::MultiLineStringTool const* tool,
+			double tileSize,
+			size_t maxTiles
+		);
+
+		/// @brief
+		epg::tools::MultiLineStringTool const* tool() const { return _tool; }
+
+		/// @brief Portions de geometrie intersectant l'emprise
+		/// @param envelope Emprise
+		/// @param vLs Portions (vues en lecture seule, valides jusqu'a l'appel suivant)
+		void getLocal(
+			ign::geometry::Envelope const& envelope,
+			std::vector< ign::geometry::LineString const* > & vLs
+		);
+
+		/// @brief Nombre de tuiles servies depuis le cache
+		size_t numHits() const { return _numHits; }
+
+		/// @brief Nombre de tuiles extraites
+		size_t numMisses() const { return _numMisses; }
+
+	private:
+
+		typedef std::pair< int64_t, int64_t >              TileKey;
+
+		struct Piece {
+			ign::geometry::LineString                      ls;
+			ign::geometry::Envelope                        envelope;
+			uint64_t                                       hash;
+			//-- rang parmi les portions de memes coordonnees
+			size_t                                         occurrence;
+			//-- nombre de tuiles referencant la portion
+			size_t                                         numTiles;
+			//-- derniere requete ayant restitue la portion
+			size_t                                         lastQuery;
+		};
+
+		struct Tile {
+			std::vector< Piece* >                          vPieces;
+			std::list< TileKey >::iterator                 lruPosition;
+		};
+
+		epg::tools::MultiLineStringTool const*             _tool;
+		double                                             _tileSize;
+		size_t                                             _maxTiles;
+		std::map< TileKey, Tile >                          _mTiles;
+		//-- portions des tuiles conservees, par empreinte des coordonnees
+		std::multimap< uint64_t, Piece >                   _mPieces;
+		size_t                                             _numQueries;
+		//-- tuiles de la plus recemment a la moins recemment utilisee
+		std::list< TileKey >                               _lru;
+		//-- resultat de la derniere requete transmise a l'outil (pas de cache)
+		ign::geometry::MultiLineString                     _mlsLocal;
+		size_t                                             _numHits;
+		size_t                                             _numMisses;
+
+	private:
+
+		//--
+		int64_t _index( double value ) const;
+
+		//--
+		Tile const& _getTile( TileKey const& key );
+
+		//--
+		Piece* _getPiece( ign::geometry::LineString const& ls, uint64_t hash, size_t occurrence );
+
+		//--
+		void _evict();
+	};
+
+}
+}
+
+#endif
@@ -0,0 +1,135 @@
+#ifndef _APP_TOOLS_MONOTONICARENA_H_
+#define _APP_TOOLS_MONOTONICARENA_H_
+
+//STL
+#include <algorithm>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+
+namespace app{
+namespace tools{
+
+	/// @brief Arene d'allocation monotone (std::pmr) destinee aux objets temporaires
+	/// du traitement d'un objet. La memoire n'est jamais liberee individuellement :
+	/// elle est recuperee en bloc par release. Si un traitement a deborde du tampon
+	/// initial, celui-ci est agrandi lors de la liberation afin que les traitements
+	/// suivants restent dans un bloc contigu.
+	class MonotonicArena
+	{
+	public:
+
+		/// @brief Portee d'utilisation de l'arene : libere l'arene a sa destruction.
+		/// Les conteneurs alloues dans l'arene doivent etre detruits avant la portee
+		/// (i.e. declares apres elle). Les portees ne doivent pas etre imbriquees.
+		class Scope
+		{
+		public:
+			/// @brief
+			Scope( MonotonicArena & arena ): _arena( arena ) {}
+
+			/// @brief
+			~Scope() { _arena.release(); }
+
+		private:
+			MonotonicArena &                               _arena;
+		};
+
+		/// @brief
+		/// @param initialSize Taille initiale du tampon (octets)
+		/// @param maxSize Taille maximale atteinte par agrandissement du tampon (octets)
+		MonotonicArena( size_t initialSize = 1 << 16, size_t maxSize = 1 << 26 ):
+			_maxSize( maxSize ),
+			_buffer( initialSize )
+		{
+			_reset();
+		}
+
+		/// @brief Arene propre au thread courant
+		static MonotonicArena & Local()
+		{
+			thread_local MonotonicArena arena;
+			return arena;
+		}
+
+		/// @brief
+		std::pmr::memory_resource* resource()
+		{
+			return _resource.get();
+		}
+
+		/// @brief Libere l'ensemble des allocations
+		void release()
+		{
+			size_t const overflow = _upstream.allocatedBytes();
+			if ( overflow > 0 && _buffer.size() < _maxSize ) {
+				_resource.reset();
+				std::vector< char >( std::min( _maxSize, _buffer.size() + overflow ) ).swap( _buffer );
+				_reset();
+			} else {
+				_resource->release();
+			}
+			_upstream.clear();
+		}
+
+	private:
+
+		//-- ressource amont comptant les allocations hors du tampon
+		class CountingResource : public std::pmr::memory_resource
+		{
+		public:
+			CountingResource(): _allocatedBytes( 0 ) {}
+
+			size_t allocatedBytes() const { return _allocatedBytes; }
+
+			void clear() { _allocatedBytes = 0; }
+
+		private:
+			void* do_allocate( size_t bytes, size_t alignment ) override
+			{
+				_allocatedBytes += bytes;
+				return std::pmr::new_delete_resource()->allocate( bytes, alignment );
+			}
+
+			void do_deallocate( void* p, size_t bytes, size_t alignment ) override
+			{
+				std::pmr::new_delete_resource()->deallocate( p, bytes, alignment );
+			}
+
+			bool do_is_equal( std::pmr::memory_resource const& other ) const noexcept override
+			{
+				return this == &other;
+			}
+
+			size_t                                         _allocatedBytes;
+		};
+
+		//--
+		void _reset()
+		{
+			_resource.reset( new std::pmr::monotonic_buffer_resource( _buffer.data(), _buffer.size(), &_upstream ) );
+		}
+
+	private:
+
+		//--
+		size_t                                                         _maxSize;
+		//--
+		std::vector< char >                                            _buffer;
+		//--
+		CountingResource                                               _upstream;
+		//--
+		std::unique_ptr< std::pmr::monotonic_buffer_resource >         _resource;
+
+	private:
+		//--
+		MonotonicArena( MonotonicArena const& );
+		//--
+		MonotonicArena& operator=( MonotonicArena const& );
+	};
+
+}
+}
+
+#endif
@@ -7,6 +7,8 @@
 #include <ign/geometry/index/QuadTree.h>
 #include <ign/geometry.h>
 
+//APP
+#include <app/tools/FlatLineStrings.h>
 
 
 namespace app{
@@ -23,35 +25,22 @@ namespace tools{
 	{
 	public:
 
-		/// \brief
-		SegmentIndexedGeometry( const ign::geometry::Geometry* geometry ):
-			_geom( geometry )
+		/// \brief Les coordonnees de la geometrie sont recopiees dans des tableaux
+		/// contigus, la geometrie n'est pas conservee
+		SegmentIndexedGeometry( const ign::geometry::Geometry* geometry )
 		{ 
-			switch( _geom->getGeometryType() )
+			switch( geometry->getGeometryType() )
 			{
 			case ign::geometry::Geometry::GeometryTypeLineString :
-				{
-					_loadQuadTree( _geom->asLineString() );
-					break;
-				}
 			case ign::geometry::Geometry::GeometryTypeMultiLineString :
-				{
-					_loadQuadTree( _geom->asMultiLineString() );
-					break;
-				}
 			case ign::geometry::Geometry::GeometryTypePolygon :
-				{
-					_loadQuadTree( _geom->asPolygon() );
-					break;
-				}
 			case ign::geometry::Geometry::GeometryTypeMultiPolygon :
-				{
-					_loadQuadTree( _geom->asMultiPolygon() );
-					break;
-				}
+				_coords.add( *geometry );
+				break;
 			default :
-				IGN_THROW_EXCEPTION( "[ app::tools::IndexedGeometry ] Geometry type '"+ign::geometry::Geometry::GeometryTypeName(_geom->getGeometryType())+"' not allowed." );
+				IGN_THROW_EXCEPTION( "[ app::tools::IndexedGeometry ] Geometry type '"+ign::geometry::Geometry::GeometryTypeName(geometry->getGeometryType())+"' not allowed." );
 			};
+			_loadQuadTree();
 		}
 
 		/// \brief
@@ -61,15 +50,22 @@ namespace tools{
 		/// \brief
 		virtual std::pair<double, std::set<int>> distance( ign::geometry::Geometry const& geom, double threshold )const 
 		{
-			std::set< std::pair< const ign::geometry::Point*, const ign::geometry::Point* > > sSegments;
+			std::set< size_t > sSegments;
 			_qTree.query( geom.getEnvelope().expandBy( threshold ), sSegments );
 
+			// cas d'un point : calcul direct sur les coordonnees
+			bool const isPoint = geom.getGeometryType() == ign::geometry::Geometry::GeometryTypePoint;
+			double const px = isPoint ? geom.asPoint().x() : 0;
+			double const py = isPoint ? geom.asPoint().y() : 0;
+
 			double minDist = threshold;
 			bool found = false;
-			std::set< std::pair< const ign::geometry::Point*, const ign::geometry::Point* > >::const_iterator sit;
+			std::set< size_t >::const_iterator sit;
 			for( sit = sSegments.begin() ; sit != sSegments.end() ; ++sit )
 			{
-				double distance = ign::geometry::LineString( *sit->first, *sit->second ).distance( geom );
+				double distance = isPoint 
+					? _coords.segmentDistance( *sit, px, py ) 
+					: ign::geometry::LineString( _coords.pointN(*sit), _coords.pointN(*sit+1) ).distance( geom );
 				if( distance <= minDist )
 				{
 					minDist = distance;
@@ -83,50 +79,32 @@ namespace tools{
 		/// \brief
 		virtual void getSegments( ign::geometry::Envelope const& bbox, std::vector<ign::geometry::LineString> & vLs )const 
 		{
-			std::set< std::pair< const ign::geometry::Point*, const ign::geometry::Point* > > sSegments;
+			std::set< size_t > sSegments;
 			_qTree.query( bbox, sSegments );
-			std::set< std::pair< const ign::geometry::Point*, const ign::geometry::Point* > >::const_iterator sit;
+			std::set< size_t >::const_iterator sit;
 			for( sit = sSegments.begin() ; sit != sSegments.end() ; ++sit )
 			{
-				vLs.push_back(ign::geometry::LineString( *sit->first, *sit->second ));
+				vLs.push_back(ign::geometry::LineString( _coords.pointN(*sit), _coords.pointN(*sit+1) ));
 			}
 		}
 
 	private :
 
-
-		ign::geometry::index::QuadTree< std::pair< const ign::geometry::Point*, const ign::geometry::Point* > >  _qTree ;
-		const ign::geometry::Geometry*                                                                           _geom ;
+		//-- un segment est designe par l'indice de son premier point
+		ign::geometry::index::QuadTree< size_t >           _qTree ;
+		FlatLineStrings                                    _coords ;
 
 
 	private:
 
 		//--
-		void _loadQuadTree( ign::geometry::LineString const& ls )
-		{
-			for( size_t i = 0 ; i < ls.numSegments() ; ++i )
-				_qTree.insert( std::make_pair( &ls.pointN(i), &ls.pointN(i+1) ), ign::geometry::Envelope( ls.pointN(i), ls.pointN(i+1) ) );
-		}
-		//--
-		void _loadQuadTree( ign::geometry::MultiLineString const& mls )
-		{
-			for( size_t i = 0 ; i < mls.numGeometries() ; ++i )
-				_loadQuadTree( mls.lineStringN(i) );
-		}
-		//--
-		void _loadQuadTree( ign::geometry::Polygon const& poly )
-		{
-			for( size_t i = 0 ; i < poly.numRings() ; ++i )
-				_loadQuadTree( poly.ringN(i) );
-		}
-		//--
-		void _loadQuadTree( ign::geometry::MultiPolygon const& mp )
+		void _loadQuadTree()
 		{
-			for( size_t i = 0 ; i < mp.numGeometries() ; ++i )
-				_loadQuadTree( mp.polygonN(i) );
+			for( size_t i = 0 ; i < _coords.numLineStrings() ; ++i )
+				for( size_t j = _coords.begin(i) ; j+1 < _coords.end(i) ; ++j )
+					_qTree.insert( j, ign::geometry::Envelope( _coords.pointN(j), _coords.pointN(j+1) ) );
 		}
 
-
 	} ;
 
 	class SegmentIndexedGeometryCollection : public SegmentIndexedGeometryInterface
@@ -145,10 +123,17 @@ namespace tools{
 			/// \brief
 			void addGeometry( const ign::geometry::Geometry* geometry, int group = -1 )
 			{
+				_qTreeGeoms.insert( _vIndexedGeoms.size(), geometry->getEnvelope() );
 				_vIndexedGeoms.push_back( new SegmentIndexedGeometry( geometry ) );
 				_vGroups.push_back( group );
 			}
 
+			/// \brief Rangs (ordre d'ajout) des geometries dont l'emprise intersecte bbox
+			void getGeometries( ign::geometry::Envelope const& bbox, std::set<size_t> & sIndexes )const
+			{
+				_qTreeGeoms.query( bbox, sIndexes );
+			}
+
 			/// \brief
 			virtual std::pair<double, std::set<int>> distance( ign::geometry::Geometry const& geom, double threshold )const
 			{
@@ -185,6 +170,8 @@ namespace tools{
 
 			std::vector< SegmentIndexedGeometry* >   _vIndexedGeoms;
 			std::vector< int >                       _vGroups;
+			//-- emprises des geometries
+			ign::geometry::index::QuadTree< size_t > _qTreeGeoms;
 	};
 
 }
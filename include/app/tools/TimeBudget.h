@@ -0,0 +1,59 @@
+#ifndef _APP_TOOLS_TIMEBUDGET_H_
+#define _APP_TOOLS_TIMEBUDGET_H_
+
+//STL
+#include <chrono>
+
+
+namespace app{
+namespace tools{
+
+	/// @brief Budget de temps alloue au traitement d'un objet. Le controle
+	/// est cooperatif : c'est a l'appelant de tester le depassement aux
+	/// etapes cles de son traitement.
+	class TimeBudget
+	{
+	public:
+
+		/// @brief
+		/// @param seconds Duree allouee en secondes (pas de limite si <= 0)
+		TimeBudget( double seconds ):
+			_seconds( seconds ),
+			_start( std::chrono::steady_clock::now() )
+		{ 
+		}
+
+		/// @brief Redemarre le decompte
+		void start()
+		{
+			_start = std::chrono::steady_clock::now();
+		}
+
+		/// @brief Temps ecoule depuis le dernier demarrage (en secondes)
+		double elapsed() const
+		{
+			return std::chrono::duration< double >( std::chrono::steady_clock::now() - _start ).count();
+		}
+
+		/// @brief
+		bool isUnlimited() const
+		{
+			return _seconds <= 0;
+		}
+
+		/// @brief
+		bool isExceeded() const
+		{
+			return !isUnlimited() && elapsed() > _seconds;
+		}
+
+	private:
+
+		double                                             _seconds;
+		std::chrono::steady_clock::time_point              _start;
+	};
+
+}
+}
+
+#endif
@@ -0,0 +1,27 @@
+#ifndef _APP_UTILS_FORKTASKS_H_
+#define _APP_UTILS_FORKTASKS_H_
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace app{
+namespace utils{
+
+    /// @brief Execute chaque tache dans un processus fils (fork), au plus
+    /// parallelism processus s'executant simultanement. Le processus fils se
+    /// termine avec le code renvoye par la tache (1 si elle leve une exception),
+    /// sans detruire les objets herites du processus parent.
+    /// @param vLabels Libelles des taches (log)
+    /// @param parallelism Nombre maximum de processus simultanes
+    /// @param task Tache a executer, appelee avec l'indice de la tache
+    /// @return Indices des taches en echec
+    std::vector< size_t > forkTasks(
+        std::vector< std::string > const& vLabels,
+        size_t parallelism,
+        std::function< int ( size_t ) > const& task
+    );
+}
+}
+
+#endif
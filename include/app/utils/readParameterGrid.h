@@ -0,0 +1,26 @@
+#ifndef _APP_UTILS_READPARAMETERGRID_H_
+#define _APP_UTILS_READPARAMETERGRID_H_
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace app{
+namespace utils{
+
+    /// @brief Jeu de parametres : couples (nom du parametre, valeur)
+    typedef std::vector< std::pair< std::string, std::string > > ParameterSet;
+
+    /// @brief Lit une grille de parametres et renvoie l'ensemble des combinaisons
+    /// (produit cartesien, le premier parametre variant le moins vite).
+    /// Chaque ligne est de la forme 'NOM = valeur1,valeur2,...' ; les lignes
+    /// vides et les lignes debutant par '#' sont ignorees. Les valeurs doivent
+    /// etre numeriques.
+    /// @param path Chemin du fichier
+    std::vector< ParameterSet > readParameterGrid(
+        std::string const& path
+    );
+}
+}
+
+#endif
@@ -0,0 +1,27 @@
+#ifndef _APP_UTILS_RUNBATCH_H_
+#define _APP_UTILS_RUNBATCH_H_
+
+#include <string>
+#include <vector>
+
+namespace app{
+namespace utils{
+
+    /// @brief Lance le traitement de chaque pays dans un processus dedie
+    /// (l'executable est relance avec les arguments communs suivis du code pays),
+    /// au plus parallelism processus s'executant simultanement.
+    /// @param executable Executable a lancer
+    /// @param vArgs Arguments communs
+    /// @param vCountries Codes pays
+    /// @param parallelism Nombre maximum de processus simultanes
+    /// @return Codes des pays dont le traitement a echoue
+    std::vector< std::string > runBatch(
+        std::string const& executable,
+        std::vector< std::string > const& vArgs,
+        std::vector< std::string > const& vCountries,
+        size_t parallelism
+    );
+}
+}
+
+#endif
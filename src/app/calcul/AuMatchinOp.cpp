@@ -1,10 +1,27 @@
 //APP
 #include <app/calcul/AuMatchingOp.h>
+#include <app/calcul/AuMatchingSharding.h>
 #include <app/params/ThemeParameters.h>
 #include <app/detail/Angle.h>
 #include <app/detail/extractNotTouchingParts.h>
+#include <app/detail/getNoCoastEnvelopes.h>
 #include <app/detail/getSubString.h>
 #include <app/detail/refining.h>
+#include <app/io/Checkpoint.h>
+#include <app/io/DataSourceManager.h>
+#include <app/io/FeaturePipeline.h>
+#include <app/io/ResultManifest.h>
+#include <app/io/Wkb.h>
+#include <app/tools/AllocationTracker.h>
+#include <app/tools/Hash64.h>
+
+//STL
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
 
 //BOOST
 #include <boost/progress.hpp>
@@ -18,19 +35,59 @@
 //EPG
 #include <epg/Context.h>
 #include <epg/params/EpgParameters.h>
-#include <epg/sql/tools/numFeatures.h>
-#include <epg/sql/DataBaseManager.h>
 #include <epg/tools/StringTools.h>
 #include <epg/tools/TimeTools.h>
 #include <epg/tools/geometry/project.h>
 #include <epg/tools/geometry/angle.h>
 #include <epg/tools/geometry/LineStringSplitter.h>
-#include <ome2/feature/sql/NotDestroyedTools.h>
 
 
 using namespace app::detail;
 
 namespace app{
+namespace detail{
+
+    //-- restitue a une unite administrative la geometrie deplacee dans la geometrie de
+    //-- travail de AuMatchingOp::_computeAu (sans les sommets inseres par le raffinement),
+    //-- en sortie de portee (interruption, exception) si aucun resultat ne lui a ete affecte
+    class AreaGeometryRestorer {
+    public:
+        AreaGeometryRestorer( ign::feature::Feature & fAu, ign::geometry::MultiPolygon & mpAu, std::vector< RefinedVertex > const& vRefined ):
+            _fAu( fAu ), _mpAu( mpAu ), _vRefined( vRefined ), _done( false )
+        {
+        }
+
+        ~AreaGeometryRestorer() { restore(); }
+
+        void restore()
+        {
+            if ( _done ) return;
+            _done = true;
+            unrefineArea( _mpAu, _vRefined );
+            _fAu.getGeometry().asMultiPolygon() = std::move( _mpAu );
+        }
+
+        void release() { _done = true; }
+
+    private:
+        ign::feature::Feature &                            _fAu;
+        ign::geometry::MultiPolygon &                      _mpAu;
+        std::vector< RefinedVertex > const&                _vRefined;
+        bool                                               _done;
+    };
+
+    //-- libelles des anomalies (ordre de AuMatchingOp::Anomaly)
+    const char* const ANOMALY_NAMES[] = {
+        "closed_boundary_not_found",
+        "parts_not_matching",
+        "path_not_found",
+        "ring_error",
+        "empty_result",
+        "invalid_result",
+        "point_not_projected"
+    };
+}
+
 namespace calcul{
 
 	///
@@ -38,18 +95,36 @@ namespace calcul{
 	///
     void AuMatchingOp::Compute(
         std::string countryCode, 
-        bool verbose) 
+        bool verbose,
+        AuMatchingIndexes* sharedIndexes) 
     {
-        AuMatchingOp auMatchingOp(countryCode, verbose);
+        tools::AllocationPhase allocationPhase("[630] total");
+
+        AuMatchingOp auMatchingOp(countryCode, verbose, sharedIndexes);
         auMatchingOp._compute();
     }
 
     ///
 	///
 	///
-    AuMatchingOp::AuMatchingOp( std::string countryCode, bool verbose ):
+    std::string AuMatchingOp::CheckpointPath( std::string const& countryCode )
+    {
+        std::string const directory = params::ThemeParametersS::getInstance()->getValue( AU_CHECKPOINT_DIRECTORY ).toString();
+        return directory.empty() ? "" : directory + "/630_" + countryCode + "_checkpoint.txt";
+    }
+
+    ///
+	///
+	///
+    AuMatchingOp::AuMatchingOp( std::string countryCode, bool verbose, AuMatchingIndexes* sharedIndexes ):
+        _geometryCache( 0 ),
+        _indexes( sharedIndexes ? sharedIndexes : &_ownIndexes ),
         _countryCode( countryCode ),
-        _verbose( verbose )
+        _verbose( verbose ),
+        _numShards( 1 ),
+        _vAnomalies( NUM_ANOMALIES, 0 ),
+        _quiet( false ),
+        _targeted( false )
     {
         _init();
     }
@@ -59,7 +134,7 @@ namespace calcul{
 	///
     AuMatchingOp::~AuMatchingOp()
     {
-        delete _mlsToolBoundary;
+        delete _geometryCache;
         
         _shapeLogger->closeShape( "not_boundaries" );
         _shapeLogger->closeShape( "contact_points" );
@@ -84,6 +159,8 @@ namespace calcul{
 	///
     void AuMatchingOp::_init() 
     {
+        tools::AllocationPhase allocationPhase("[630] initialization");
+
         //--
         _logger= epg::log::EpgLoggerS::getInstance();
         _logger->log(epg::log::INFO, "[START] initialization: "+epg::tools::TimeTools::getTime());
@@ -94,28 +171,64 @@ namespace calcul{
         // epg parameters
         epg::params::EpgParameters const& epgParams = context->getEpgParameters();
 
-        std::string const idName = epgParams.getValue( ID ).toString();
-        std::string const geomName = epgParams.getValue( GEOM ).toString();
         std::string const countryCodeName = epgParams.getValue( COUNTRY_CODE ).toString();
-        std::string const areaTableName = epgParams.getValue( AREA_TABLE ).toString();
         std::string const boundaryTypeName = epgParams.getValue( BOUNDARY_TYPE ).toString();
         std::string const typeCostlineValue = epgParams.getValue( TYPE_COASTLINE ).toString();
 
         // app parameters
         params::ThemeParameters* themeParameters = params::ThemeParametersS::getInstance();
-        std::string const landmaskTableName = themeParameters->getValue( LANDMASK_TABLE ).toString();
-        std::string const noCoastTableName = themeParameters->getValue( NOCOAST_TABLE ).toString();
         
         //--
-        _fsBoundary = context->getFeatureStore( epg::TARGET_BOUNDARY );
+        _dataSource = io::DataSourceManagerS::getInstance()->getDataSource();
         //--
-        _fsLandmask = context->getDataBaseManager().getFeatureStore(landmaskTableName, idName, geomName);
+        _boundaryTableName = epgParams.getValue( TARGET_BOUNDARY_TABLE ).toString();
         //--
-        _fsNoCoast = context->getDataBaseManager().getFeatureStore(noCoastTableName, idName, geomName);
+        _noCoastTableName = themeParameters->getValue( NOCOAST_TABLE ).toString();
         //--
-        _fsArea = context->getDataBaseManager().getFeatureStore(areaTableName, idName, geomName);
+        _areaTableName = epgParams.getValue( AREA_TABLE ).toString();
         //--
-        _mlsToolBoundary = new epg::tools::MultiLineStringTool( ome2::feature::sql::NotDestroyedTools::GetFeatureFilter("country LIKE '%"+_countryCode+"%' AND "+boundaryTypeName+"::text NOT LIKE '%"+typeCostlineValue+"%'", _fsBoundary), *_fsBoundary );
+        _loadTargets();
+        //--
+        io::Query const countryQuery = _local( io::Query().containsCode(countryCodeName, _countryCode) );
+        io::Query const boundaryNotCoastQuery = _local( io::Query().containsCode(countryCodeName, _countryCode).notContains(boundaryTypeName, typeCostlineValue) );
+
+        //--
+        _numShards = _targeted ? 1 : static_cast<size_t>( std::max( themeParameters->getValue( AU_SHARD_COUNT ).toDouble(), 1. ) );
+
+        // une relance ciblee ne lit que des donnees partielles : ses structures lui sont propres
+        if ( _targeted ) _indexes = &_ownIndexes;
+        // structures deja construites pour ce pays (traitement d'un autre niveau) : ni
+        // l'outil des contours ni le cache des geometries ne sont relus
+        bool const loaded = _indexes->countryCode == _countryCode && _indexes->mlsToolBoundary
+            && ( _numShards == 1 || _indexes->mLsBoundaryContours.numGeometries() > 0 );
+
+        // la cle du cache porte sur l'ensemble des lectures dont derivent les geometries preparees
+        // (pas de cache pour une relance ciblee, qui ne lit que des donnees partielles)
+        _geometryCache = new io::GeometryCache( _targeted || loaded ? "" : themeParameters->getValue( GEOMETRY_CACHE_DIRECTORY ).toString(), "630_" + _countryCode );
+        if ( _geometryCache->isEnabled() ) {
+            _geometryCache->addSource( *_dataSource, _boundaryTableName, boundaryNotCoastQuery );
+            _geometryCache->addSource( *_dataSource, _boundaryTableName, countryQuery );
+            _geometryCache->addSource( *_dataSource, _noCoastTableName, countryQuery );
+            _geometryCache->load();
+        }
+        //--
+        if ( loaded ) {
+            _logger->log(epg::log::INFO, "[630] reusing the prepared structures of " + _countryCode);
+        } else {
+            _indexes->clear();
+            _indexes->countryCode = _countryCode;
+            if ( _targeted && _vTargetAu.empty() ) {
+                // aucun objet selectionne : rien a charger
+            } else if ( _numShards > 1 ) {
+                // les contours sont conserves : chaque processus de calcul reconstruit
+                // l'outil a partir des seuls contours de sa tuile
+                _geometryCache->getContours( "boundary_contours", *_dataSource, _boundaryTableName, boundaryNotCoastQuery, _indexes->mLsBoundaryContours );
+                _indexes->mlsToolBoundary = new epg::tools::MultiLineStringTool( _indexes->mLsBoundaryContours );
+            } else {
+                _indexes->mlsToolBoundary = _geometryCache->newMultiLineStringTool( "boundary_contours", *_dataSource, _boundaryTableName, boundaryNotCoastQuery );
+            }
+            _initLocalBoundary();
+        }
         
         //--
         _shapeLogger = epg::log::ShapeLoggerS::getInstance();
@@ -141,321 +254,791 @@ namespace calcul{
     ///
 	///
 	///
-    void AuMatchingOp::_compute() 
+    void AuMatchingOp::_loadIndexes() 
     {
+        tools::AllocationPhase allocationPhase("[630] index loading");
 
         epg::Context* context = epg::ContextS::getInstance();
 
         //epg params
         epg::params::EpgParameters const& epgParams = context->getEpgParameters();
 
-        std::string const idName = epgParams.getValue( ID ).toString();
-        std::string const geomName = epgParams.getValue( GEOM ).toString();
         std::string const countryCodeName = epgParams.getValue( COUNTRY_CODE ).toString();
 
-        //app params
+        std::vector<ign::geometry::LineString> vLsNoCoast;
+        if ( !_geometryCache->get( "landmask_no_coasts", vLsNoCoast ) ) {
+            io::FeatureCursorPtr itNoCoast = _dataSource->getFeatures(_noCoastTableName, _local( io::Query().containsCode(countryCodeName, _countryCode) ));
+            ign::feature::Feature fNoCoast;
+            while (itNoCoast->next(fNoCoast)) {
+                vLsNoCoast.push_back(fNoCoast.getGeometry().asLineString());
+            }
+            _geometryCache->set( "landmask_no_coasts", vLsNoCoast );
+        }
+        for (size_t i = 0 ; i < vLsNoCoast.size() ; ++i) {
+             _indexes->mLsLandmaskNoCoasts.addGeometry(vLsNoCoast[i]);
+        }
+        _indexLandmaskNoCoasts();
+
+        // on indexe les contours frontière fermés 
+        if ( !_geometryCache->get( "merged_boundaries", _indexes->vMergedBoundaryLs ) ) {
+            io::FeatureCursorPtr itBoundary = _dataSource->getFeatures(_boundaryTableName, _local( io::Query().containsCode(countryCodeName, _countryCode) ));
+            ign::geometry::algorithm::LineMergerOpGeos merger2;
+            ign::feature::Feature fBoundary;
+            while (itBoundary->next(fBoundary)) {
+                ign::geometry::LineString const& lsBoundary = fBoundary.getGeometry().asLineString();
+                merger2.add(lsBoundary);
+            }
+            _indexes->vMergedBoundaryLs = merger2.getMergedLineStrings();
+            _geometryCache->set( "merged_boundaries", _indexes->vMergedBoundaryLs );
+        }
+        _geometryCache->save();
+
+        _indexes->vMergedBoundaryIndexedLs.resize(_indexes->vMergedBoundaryLs.size(), 0);
+        for ( size_t i = 0 ; i < _indexes->vMergedBoundaryLs.size() ; ++i ) {
+            if ( _indexes->vMergedBoundaryLs[i].isClosed() ) {
+                _indexes->vMergedBoundaryIndexedLs[i] = new tools::SegmentIndexedGeometry( &_indexes->vMergedBoundaryLs[i] );
+                _indexes->qTreeClosedBoundary.insert( i, _indexes->vMergedBoundaryLs[i].getEnvelope() );
+            }
+        }
+    };
+
+    ///
+	///
+	///
+    void AuMatchingOp::_loadTargets() 
+    {
         params::ThemeParameters* themeParameters = params::ThemeParametersS::getInstance();
+        std::string const targetIds = themeParameters->getValue( AU_TARGET_IDS ).toString();
+        std::string const targetBbox = themeParameters->getValue( AU_TARGET_BBOX ).toString();
 
-        double const boundMaxDist = themeParameters->getValue( AU_BOUNDARY_MAX_DIST ).toDouble();
-        double const boundSearchDist = themeParameters->getValue( AU_BOUNDARY_SEARCH_DIST ).toDouble();
-        double const boundSnapDist = themeParameters->getValue( AU_BOUNDARY_SNAP_DIST ).toDouble();
-        double const segmentMinLength = themeParameters->getValue( AU_SEGMENT_MIN_LENGTH ).toDouble();
+        _targeted = !targetIds.empty() || !targetBbox.empty();
+        if ( !_targeted ) return;
 
-        //--
-        ign::geometry::MultiLineString mLsLandmaskNoCoasts;
-        tools::SegmentIndexedGeometryCollection* indexedLandmaskNoCoasts = new tools::SegmentIndexedGeometryCollection();
+        epg::params::EpgParameters const& epgParams = epg::ContextS::getInstance()->getEpgParameters();
+        std::string const countryCodeName = epgParams.getValue( COUNTRY_CODE ).toString();
+        std::string const idName = epgParams.getValue( ID ).toString();
+
+        // les unites administratives sont relues en entree d'etape : la table de
+        // travail contient deja le resultat d'un traitement precedent
+        std::string sourceTableName = themeParameters->getValue( AU_TARGET_SOURCE_TABLE ).toString();
+        if ( sourceTableName.empty() ) sourceTableName = _areaTableName;
+
+        ign::feature::Feature fAu;
+        if ( !targetIds.empty() ) {
+            std::ifstream ifs( targetIds.c_str() );
+            if ( !ifs )
+                IGN_THROW_EXCEPTION( "[ app::calcul::AuMatchingOp ] unable to open '" + targetIds + "'" );
+
+            std::string id;
+            while ( ifs >> id ) {
+                io::FeatureCursorPtr itAu = _dataSource->getFeatures( sourceTableName, io::Query().equals(countryCodeName, _countryCode).equals(idName, id) );
+                if ( itAu->next(fAu) ) _vTargetAu.push_back(fAu);
+                else _logger->log(epg::log::WARN, "Selected object not found [id] " + id);
+            }
+        } else {
+            std::vector<std::string> vBounds;
+            epg::tools::StringTools::Split( targetBbox, ",", vBounds );
+            std::vector<double> vValues;
+            for ( size_t i = 0 ; i < vBounds.size() ; ++i ) {
+                char* end = 0;
+                vValues.push_back( std::strtod( vBounds[i].c_str(), &end ) );
+                if ( vBounds[i].empty() || *end != '\0' ) vValues.clear();
+            }
+            if ( vValues.size() != 4 )
+                IGN_THROW_EXCEPTION( "[ app::calcul::AuMatchingOp ] invalid bounding box '" + targetBbox + "' (xmin,ymin,xmax,ymax)" );
+
+            std::vector<ign::geometry::Envelope> vBbox( 1, ign::geometry::Envelope( ign::geometry::Point( vValues[0], vValues[1] ), ign::geometry::Point( vValues[2], vValues[3] ) ) );
+            io::FeatureCursorPtr itAu = _dataSource->getFeatures( sourceTableName, io::Query().equals(countryCodeName, _countryCode).intersects(vBbox) );
+            while ( itAu->next(fAu) ) _vTargetAu.push_back(fAu);
+        }
+
+        double const influenceRadius = std::max( themeParameters->getValue( AU_BOUNDARY_MAX_DIST ).toDouble(), themeParameters->getValue( AU_BOUNDARY_SEARCH_DIST ).toDouble() );
+        for ( size_t i = 0 ; i < _vTargetAu.size() ; ++i ) {
+            ign::geometry::Envelope envelope = _vTargetAu[i].getGeometry().getEnvelope();
+            _vTargetEnvelopes.push_back( envelope.expandBy( influenceRadius ) );
+        }
+
+        _logger->log(epg::log::INFO, "[630] targeted run : " + std::to_string(_vTargetAu.size()) + " objects selected");
+    };
+
+    ///
+	///
+	///
+    io::Query AuMatchingOp::_local( io::Query query ) const
+    {
+        if ( _targeted ) query.intersects( _vTargetEnvelopes );
+        return query;
+    };
+
+    ///
+	///
+	///
+    void AuMatchingOp::_checkPrefilter( io::Query const& areaQuery, double searchDistance ) const
+    {
+        epg::params::EpgParameters const& epgParams = epg::ContextS::getInstance()->getEpgParameters();
+        std::string const countryCodeName = epgParams.getValue( COUNTRY_CODE ).toString();
 
-        ign::feature::FeatureIteratorPtr itNoCoast = ome2::feature::sql::NotDestroyedTools::GetFeatures(*_fsNoCoast, ign::feature::FeatureFilter(countryCodeName+" LIKE '%"+_countryCode+"%'"));
-        while (itNoCoast->hasNext()) {
-             ign::feature::Feature fNoCoast = itNoCoast->next();
-             ign::geometry::LineString const& lsNoCoast = fNoCoast.getGeometry().asLineString();
-             mLsLandmaskNoCoasts.addGeometry(lsNoCoast);
+        std::set< std::string > sSelected;
+        ign::feature::Feature fAu;
+        io::FeatureCursorPtr itSelected = _dataSource->getFeatures( _areaTableName, areaQuery );
+        while ( itSelected->next( fAu ) ) sSelected.insert( fAu.getId() );
+
+        // lecture de reference, sans prefiltre spatial
+        size_t numAu = 0, numNearBoundary = 0, numMissing = 0;
+        io::FeatureCursorPtr itAu = _dataSource->getFeatures( _areaTableName, io::Query().equals( countryCodeName, _countryCode ) );
+        while ( itAu->next( fAu ) ) {
+            ++numAu;
+            if ( _indexes->indexedLandmaskNoCoasts->distance( fAu.getGeometry(), searchDistance ).first < 0 ) continue;
+            ++numNearBoundary;
+            if ( sSelected.find( fAu.getId() ) != sSelected.end() ) continue;
+            ++numMissing;
+            _logger->log(epg::log::ERROR, "[630] prefilter check : object near the boundary not selected [id] " + fAu.getId());
         }
+
+        std::ostringstream ss;
+        ss << std::setprecision(3) << "[630] prefilter check : " << sSelected.size() << " selected ("
+            << ( numAu > 0 ? 100. * sSelected.size() / numAu : 0. ) << "%), " << numNearBoundary << " near the boundary, "
+            << numAu << " in the country, " << areaQuery.getEnvelopes().size() << " envelopes";
+        _logger->log(epg::log::INFO, ss.str());
+
+        if ( numMissing > 0 )
+            IGN_THROW_EXCEPTION( "[ app::calcul::AuMatchingOp ] prefilter check failed : " + std::to_string( numMissing ) + " objects near the boundary not selected" );
+    };
+
+    ///
+	///
+	///
+    void AuMatchingOp::_computeTargets() 
+    {
+        tools::AllocationPhase allocationPhase("[630] targeted au processing");
+
+        if ( _vTargetAu.empty() ) {
+            _logger->log(epg::log::WARN, "[630] targeted run : no object selected");
+            return;
+        }
+
+        _loadIndexes();
+
+        // mise a jour directe de la table de travail, sans copie ni manifeste ni point de reprise :
+        // chaque objet est reecrit (par identifiant), meme non modifie, pour remplacer le
+        // resultat du traitement precedent
+        size_t numModified = 0;
+        for ( size_t i = 0 ; i < _vTargetAu.size() ; ++i ) {
+            bool modified = false;
+            _computeAu(_vTargetAu[i], 0, modified);
+            if ( modified ) ++numModified;
+
+            _dataSource->modifyFeature(_areaTableName, _vTargetAu[i]);
+        }
+        _dataSource->commit();
+
+        _logAnomalies( "[630] anomalies" );
+        _logger->log(epg::log::INFO, "[630] targeted run : " + std::to_string(numModified) + "/" + std::to_string(_vTargetAu.size()) + " objects modified");
+    };
+
+    ///
+	///
+	///
+    void AuMatchingOp::_indexLandmaskNoCoasts() 
+    {
+        delete _indexes->indexedLandmaskNoCoasts;
+        _indexes->indexedLandmaskNoCoasts = new tools::SegmentIndexedGeometryCollection();
+
         // a faire dans un deuxième temps car les pointeurs sur les éléments de vecteur peuvent être modifiés en cas de réallocation
         int numGroup = 0;
-        for (size_t i = 0 ; i < mLsLandmaskNoCoasts.numGeometries() ; ++i) {
-            int group = mLsLandmaskNoCoasts.lineStringN(i).isClosed() ? numGroup++ : -1;
-            indexedLandmaskNoCoasts->addGeometry(&mLsLandmaskNoCoasts.lineStringN(i), group);
+        for (size_t i = 0 ; i < _indexes->mLsLandmaskNoCoasts.numGeometries() ; ++i) {
+            int group = _indexes->mLsLandmaskNoCoasts.lineStringN(i).isClosed() ? numGroup++ : -1;
+            _indexes->indexedLandmaskNoCoasts->addGeometry(&_indexes->mLsLandmaskNoCoasts.lineStringN(i), group);
         }
+    };
 
-        // on indexe les contours frontière fermés 
-        ign::feature::FeatureIteratorPtr itBoundary = ome2::feature::sql::NotDestroyedTools::GetFeatures(*_fsBoundary, ign::feature::FeatureFilter(countryCodeName+" LIKE '%"+_countryCode+"%'"));
-        ign::geometry::algorithm::LineMergerOpGeos merger2;
-        while (itBoundary->hasNext()) {
-            ign::feature::Feature fBoundary = itBoundary->next();
-            ign::geometry::LineString const& lsBoundary = fBoundary.getGeometry().asLineString();
-            merger2.add(lsBoundary);
-        }
-        std::vector< ign::geometry::LineString > vMergedBoundaryLs = merger2.getMergedLineStrings();
-
-        std::vector< tools::SegmentIndexedGeometryInterface* > vMergedBoundaryIndexedLs(vMergedBoundaryLs.size(), 0);
-        ign::geometry::index::QuadTree< size_t > qTreeClosedBoundary;
-        for ( size_t i = 0 ; i < vMergedBoundaryLs.size() ; ++i ) {
-            if ( vMergedBoundaryLs[i].isClosed() ) {
-                vMergedBoundaryIndexedLs[i] = new tools::SegmentIndexedGeometry( &vMergedBoundaryLs[i] );
-                qTreeClosedBoundary.insert( i, vMergedBoundaryLs[i].getEnvelope() );
-            }
+    ///
+	///
+	///
+    void AuMatchingOp::_initLocalBoundary() 
+    {
+        delete _indexes->localBoundary;
+        _indexes->localBoundary = 0;
+        if ( !_indexes->mlsToolBoundary ) return;
+
+        params::ThemeParameters* themeParameters = params::ThemeParametersS::getInstance();
+        double const tileSize = themeParameters->getValue( AU_BOUNDARY_TILE_SIZE ).toDouble();
+        size_t const maxTiles = static_cast<size_t>( std::max( themeParameters->getValue( AU_BOUNDARY_TILE_CACHE_SIZE ).toDouble(), 1. ) );
+        _indexes->localBoundary = new tools::LocalTileCache( _indexes->mlsToolBoundary, tileSize, maxTiles );
+    };
+
+    ///
+	///
+	///
+    void AuMatchingOp::_compute() 
+    {
+
+        epg::Context* context = epg::ContextS::getInstance();
+
+        //epg params
+        epg::params::EpgParameters const& epgParams = context->getEpgParameters();
+
+        std::string const countryCodeName = epgParams.getValue( COUNTRY_CODE ).toString();
+
+        //app params
+        params::ThemeParameters* themeParameters = params::ThemeParametersS::getInstance();
+
+        double const boundMaxDist = themeParameters->getValue( AU_BOUNDARY_MAX_DIST ).toDouble();
+        double const boundSearchDist = themeParameters->getValue( AU_BOUNDARY_SEARCH_DIST ).toDouble();
+        double const featureTimeBudget = themeParameters->getValue( AU_FEATURE_TIME_BUDGET ).toDouble();
+        size_t const allocationTopK = static_cast<size_t>( themeParameters->getValue( ALLOCATION_TRACKING_TOP_K ).toDouble() );
+        size_t const pipelineQueueSize = static_cast<size_t>( std::max( themeParameters->getValue( AU_PIPELINE_QUEUE_SIZE ).toDouble(), 0. ) );
+        bool const spatialOrder = themeParameters->getValue( AU_SPATIAL_ORDER ).toString() == "1";
+
+        if ( _targeted ) {
+            _computeTargets();
+            return;
         }
 
+        // index deja charges lors du traitement d'un autre niveau (structures partagees)
+        if ( !_indexes->indexedLandmaskNoCoasts ) _loadIndexes();
+
         // Go through objects intersecting the boundary
-        ign::feature::FeatureIteratorPtr itArea = ome2::feature::sql::NotDestroyedTools::GetFeatures( *_fsArea, ign::feature::FeatureFilter(countryCodeName+" = '"+_countryCode+"'"));
+        // seules les unites administratives au contact des portions de frontiere
+        // qui ne sont pas des cotes peuvent etre modifiees : prefiltre spatial
+        std::vector<ign::geometry::Envelope> const vNoCoastEnvelopes = detail::getNoCoastEnvelopes(_indexes->mLsLandmaskNoCoasts, boundSearchDist);
+        io::Query const areaQuery = io::Query().equals(countryCodeName, _countryCode).intersects(vNoCoastEnvelopes);
+        if ( themeParameters->getValue( AU_PREFILTER_CHECK ).toString() == "1" ) _checkPrefilter( areaQuery, boundSearchDist );
 
         //patience
-        int numFeatures = ome2::feature::sql::NotDestroyedTools::NumFeatures( *_fsArea, ign::feature::FeatureFilter(countryCodeName+" = '"+_countryCode + "'"));
+        size_t numFeatures = _dataSource->numFeatures( _areaTableName, areaQuery );
         boost::progress_display display( numFeatures , std::cout, "[ au_matching % complete ]\n") ;
 
-        while (itArea->hasNext())
-        {
-            ++display;
+        // lecture (prechargement) et ecriture des unites administratives dans des
+        // threads dedies, en parallele du calcul ; parcours eventuellement ordonne
+        // spatialement pour que les unites administratives consecutives soient voisines
+        io::FeaturePipeline areaPipeline( _dataSource, _areaTableName, areaQuery, pipelineQueueSize, spatialOrder );
+
+        // reprise des resultats de l'execution precedente pour les unites administratives
+        // dont les entrees (geometrie, donnees voisines, parametres) n'ont pas change
+        std::string const manifestDirectory = themeParameters->getValue( AU_MANIFEST_DIRECTORY ).toString();
+        // un manifeste par table traitee : les niveaux administratifs d'un meme pays ne se recouvrent pas
+        io::ResultManifest manifest( manifestDirectory.empty() ? "" : manifestDirectory + "/630_" + _countryCode + "_" + _areaTableName + "_manifest.bin" );
+
+        std::ostringstream ssParams;
+        ssParams << std::setprecision(15) << "1|" << _countryCode << "|" << boundMaxDist << "|" << boundSearchDist << "|"
+            << themeParameters->getValue( AU_BOUNDARY_SNAP_DIST ).toDouble() << "|" << themeParameters->getValue( AU_SEGMENT_MIN_LENGTH ).toDouble();
+        std::string const paramsKey = ssParams.str();
+        double const influenceRadius = std::max( boundMaxDist, boundSearchDist );
+
+        // point de reprise : identifiants des objets dont le resultat est valide,
+        // enregistres tous les AU_CHECKPOINT_INTERVAL objets
+        io::Checkpoint checkpoint( CheckpointPath( _countryCode ), _areaTableName );
+        size_t const checkpointInterval = static_cast<size_t>( std::max( themeParameters->getValue( AU_CHECKPOINT_INTERVAL ).toDouble(), 1. ) );
+        if ( themeParameters->getValue( AU_RESUME ).toString() == "1" && checkpoint.load() ) {
+            _logger->log(epg::log::INFO, "Resuming from checkpoint : " + std::to_string(checkpoint.size()) + " objects already processed");
+        } else {
+            checkpoint.reset();
+        }
+
+        // les objets dont le traitement depasse le budget de temps sont mis de cote
+        // pour etre traites a la fin sans limite de temps
+        std::vector<ign::feature::Feature> vDeferredAu;
+        std::vector<std::string> vDeferredAuHash;
+        tools::TimeBudget budget( featureTimeBudget );
 
-            ign::feature::Feature fAu = itArea->next();
-            ign::geometry::MultiPolygon mpAu = fAu.getGeometry().asMultiPolygon();
-            ign::geometry::algorithm::PolygonBuilderV1 polyBuilder;
-            std::set< size_t > sAddedClosedBoundary;
+        // classement des unites administratives les plus consommatrices en allocations
+        bool const trackAuAllocations = tools::AllocationTracker::IsAvailable() && tools::AllocationTracker::GetLevel() >= tools::AllocationTracker::FEATURE;
+        tools::AllocationRanking auAllocationRanking( trackAuAllocations ? allocationTopK : 0 );
 
-            if (_verbose) _logger->log(epg::log::DEBUG,fAu.getId());
+        // nombre d'objets non traites suite a l'echec d'un processus de calcul
+        size_t numFailed = 0;
+        std::fill( _vAnomalies.begin(), _vAnomalies.end(), 0 );
 
-            detail::refineAreaWithLsEndings(mLsLandmaskNoCoasts, mpAu);
+        if ( _numShards > 1 ) {
+            numFailed = AuMatchingSharding::Compute(*this, _numShards, areaPipeline, manifest, checkpoint, paramsKey, influenceRadius, display);
+        } else {
+            tools::AllocationPhase allocationPhase("[630] au processing");
 
-            bool bIsModified = false;
-            for ( int i = 0 ; i < mpAu.numGeometries() ; ++i )
+            ign::feature::Feature fAu;
+            while (areaPipeline.next(fAu))
             {
-                ign::geometry::Polygon & pAu = mpAu.polygonN(i);
+                ++display;
 
-                for ( int j = 0 ; j < pAu.numRings() ; ++j )                                                                                                                                                                                                                                                                              
-                {
-                    ign::geometry::LineString & ring = pAu.ringN(j);
-
-                    // on extrait les parties de l'UA qui ne sont pas des frontieres
-                    std::vector<std::pair<int,int>> vpNotTouchingParts;
-                    std::vector<int> vTouchingPoints;
-                    detail::extractNotTouchingParts( indexedLandmaskNoCoasts, ring, vpNotTouchingParts, &vTouchingPoints );
-
-                    // on gere les boucles
-                    if (vpNotTouchingParts.empty()) {
-                        bIsModified = true;
-
-                        std::set< size_t > sClosedBoundary;
-                        qTreeClosedBoundary.query( ring.getEnvelope(), sClosedBoundary );
-
-                        bool foundBoundary = false;
-
-                        std::set< size_t >::const_iterator sit;
-                        for( sit = sClosedBoundary.begin() ; sit != sClosedBoundary.end() ; ++sit )
-                        {
-                            if ( vMergedBoundaryIndexedLs[*sit]->distance(ring, boundMaxDist).first < 0 ) continue;
-                            ign::geometry::algorithm::OptimizedHausdorffDistanceOp hausdorfOp(ring, vMergedBoundaryLs[*sit], -1, boundMaxDist);
-                            double distance = hausdorfOp.getDemiHausdorff(ign::geometry::algorithm::OptimizedHausdorffDistanceOp::DhdFromAtoB);
-                            if (distance < 0) {
-                                distance = hausdorfOp.getDemiHausdorff(ign::geometry::algorithm::OptimizedHausdorffDistanceOp::DhdFromBtoA);
-                            }
-                            if (distance < 0) continue;
-
-                            foundBoundary = true;
-
-                            if ( sAddedClosedBoundary.find(*sit) != sAddedClosedBoundary.end() ) continue;
-
-                            polyBuilder.addLineString(vMergedBoundaryLs[*sit]);
-                            sAddedClosedBoundary.insert(*sit);
-                            
-                            ign::feature::Feature feature = fAu;
-                            feature.setGeometry( vMergedBoundaryLs[*sit] );
-                            _shapeLogger->writeFeature( "boucle", feature );
-                        }
-                        if (!foundBoundary) {
-                            _logger->log(epg::log::ERROR, "Not found closed boundary line [id] " + fAu.getId());
-                        }
-                        continue;
-                    }
-                    
-                    // on projette les eventuels points de contact avec la frontiere
-                    ign::geometry::LineString ringWithContactPoints = ring;
-                    _projectTouchingPoints(_mlsToolBoundary, ringWithContactPoints, vTouchingPoints, boundSearchDist, boundSnapDist);
-
-                    std::vector<ign::geometry::LineString> vLsNotTouchingParts;
-                    for ( int i = 0 ; i < vpNotTouchingParts.size() ; ++i ) {
-                        vLsNotTouchingParts.push_back(detail::getSubString(vpNotTouchingParts[i], ringWithContactPoints));
-                    }
+                // deja traite avant l'interruption de l'execution precedente
+                if ( checkpoint.contains(fAu.getId()) ) {
+                    manifest.carryForward(fAu.getId());
+                    continue;
+                }
 
-                    // c est un contour fermé qui ne touche pas les frontières
-                    if ( vLsNotTouchingParts.size() == 1 && vLsNotTouchingParts.front().isClosed() ) {
-                        polyBuilder.addLineString(vLsNotTouchingParts.front());
-                        if (vTouchingPoints.size() > 0) bIsModified = true;
+                std::string auHash;
+                bool reused = false;
+                if ( manifest.isEnabled() ) {
+                    auHash = _getAuHash(fAu, paramsKey, influenceRadius);
+                    bool written = false;
+                    reused = manifest.find(fAu, auHash, written);
+                    if ( reused && written ) areaPipeline.write(fAu);
+                }
+
+                if ( !reused ) {
+                    tools::AllocationScope auAllocationScope;
+                    budget.start();
+                    bool modified = false;
+                    bool const computed = _computeAu(fAu, &budget, modified);
+                    auAllocationRanking.add( fAu.getId(), auAllocationScope.stats() );
+                    if ( !computed ) {
+                        _logger->log(epg::log::WARN, "Time budget exceeded, object deferred [id] " + fAu.getId());
+                        vDeferredAu.push_back(fAu);
+                        vDeferredAuHash.push_back(auHash);
                         continue;
                     }
+                    if ( modified ) areaPipeline.write(fAu);
+                    manifest.add(fAu, auHash, modified);
+                }
 
-                    bIsModified = true;
+                checkpoint.add(fAu.getId());
+                if ( checkpoint.numPending() >= checkpointInterval ) {
+                    areaPipeline.commit();
+                    checkpoint.save();
+                }
+            }
+        }
 
-                    // recupérer les angles de la frontière au niveau des extremites des vpNotTouchingParts
-                    std::vector<std::pair<double, double>> vGeomFeatures;
-                    _getAngles(indexedLandmaskNoCoasts, vLsNotTouchingParts, vGeomFeatures);
-                    
-                    for ( int i = 0 ; i < vLsNotTouchingParts.size() ; ++i ) {
-                        ign::feature::Feature feature = fAu;
-                        feature.setGeometry( vLsNotTouchingParts[i] );
-                        _shapeLogger->writeFeature( "not_boundaries", feature );
-                    }
-                    for ( int i = 0 ; i < vTouchingPoints.size() ; ++i ) {
-                        ign::feature::Feature feature = fAu;
-                        feature.setGeometry( ring.pointN(vTouchingPoints[i]) );
-                        _shapeLogger->writeFeature( "contact_points", feature );
-                    }
+        if ( !vDeferredAu.empty() ) {
+            tools::AllocationPhase allocationPhase("[630] deferred objects processing");
 
-                    // on supprime les overshots
-                    std::vector<std::pair<ign::geometry::Point,ign::geometry::Point>> vpStartEnd;
-                    for ( int i = 0 ; i < vLsNotTouchingParts.size() ; ++i )
-                    {
-                        epg::tools::geometry::LineStringSplitter lsSplitter( vLsNotTouchingParts[i], 1e-5 );
+            _logger->log(epg::log::INFO, "[START] deferred objects processing: "+epg::tools::TimeTools::getTime());
 
-                        ign::geometry::MultiLineString mls;
-                        _mlsToolBoundary->getLocal(vLsNotTouchingParts[i].getEnvelope(), mls);
+            boost::progress_display displayDeferred( vDeferredAu.size() , std::cout, "[ au_matching deferred objects % complete ]\n") ;
+            for ( size_t i = 0 ; i < vDeferredAu.size() ; ++i, ++displayDeferred ) {
+                tools::AllocationScope auAllocationScope;
+                bool modified = false;
+                _computeAu(vDeferredAu[i], 0, modified);
+                if ( modified ) areaPipeline.write(vDeferredAu[i]);
+                manifest.add(vDeferredAu[i], vDeferredAuHash[i], modified);
+                auAllocationRanking.add( vDeferredAu[i].getId(), auAllocationScope.stats() );
 
-                        lsSplitter.addCuttingGeometry(mls);
+                checkpoint.add(vDeferredAu[i].getId());
+                if ( checkpoint.numPending() >= checkpointInterval ) {
+                    areaPipeline.commit();
+                    checkpoint.save();
+                }
+            }
 
-                        vpStartEnd.push_back(std::make_pair(vLsNotTouchingParts[i].startPoint(), vLsNotTouchingParts[i].endPoint()));
+            _logger->log(epg::log::INFO, "[END] deferred objects processing: "+epg::tools::TimeTools::getTime());
+        }
 
-                        vLsNotTouchingParts[i] = lsSplitter.truncAtEnds();
-                    }
+        areaPipeline.finish();
+        areaPipeline.commit();
+        // les objets d'un processus en echec ne figurent pas dans le point de reprise
+        if ( numFailed == 0 ) checkpoint.remove();
+        else checkpoint.save();
+
+        if ( manifest.isEnabled() ) {
+            manifest.commit();
+            _logger->log(epg::log::INFO, "Objects reused from previous run : " + std::to_string(manifest.numReused()) + "/" + std::to_string(numFeatures));
+        }
+
+        if ( trackAuAllocations ) auAllocationRanking.log( "[630] top administrative units" );
+
+        // en mode multi-processus, les anomalies sont inscrites par chaque processus de calcul
+        if ( _numShards == 1 ) _logAnomalies( "[630] anomalies" );
+        if ( _numShards == 1 && _indexes->localBoundary->numMisses() > 0 )
+            _logger->log(epg::log::INFO, "[630] boundary tiles : " + std::to_string(_indexes->localBoundary->numHits()) + " hits, " + std::to_string(_indexes->localBoundary->numMisses()) + " extractions");
+
+        if ( numFailed > 0 ) {
+            std::string mError = "[ app::calcul::AuMatchingOp ] " + std::to_string(numFailed) + " objects not processed (shard failure)";
+            if ( checkpoint.isEnabled() ) mError += ", run step 630 again with --resume";
+            IGN_THROW_EXCEPTION(mError);
+        }
+    };
+
+    ///
+	///
+	///
+    void AuMatchingOp::_disableDiagnostics( bool quiet )
+    {
+        _shapeLogger = 0;
+        _diagnosticWriter.disable();
+        _quiet = quiet;
+    };
+
+    ///
+	///
+	///
+    std::string AuMatchingOp::_anomalyName( size_t anomaly )
+    {
+        return detail::ANOMALY_NAMES[anomaly];
+    };
+
+    ///
+	///
+	///
+    void AuMatchingOp::_anomaly( Anomaly anomaly, std::string const& message ) const
+    {
+        _vPendingAnomalies.push_back( std::make_pair( anomaly, message ) );
+    };
+
+    ///
+	///
+	///
+    void AuMatchingOp::_flushAuReports( bool completed )
+    {
+        if ( completed ) {
+            for ( size_t i = 0 ; i < _vPendingAnomalies.size() ; ++i ) {
+                ++_vAnomalies[_vPendingAnomalies[i].first];
+                if ( !_quiet ) _logger->log(epg::log::ERROR, _vPendingAnomalies[i].second);
+            }
+            _diagnosticWriter.flush();
+        } else {
+            _diagnosticWriter.discard();
+        }
+        _vPendingAnomalies.clear();
+    };
+
+    ///
+	///
+	///
+    void AuMatchingOp::_logAnomalies( std::string const& title ) const
+    {
+        std::string message = title + " :";
+        for ( size_t a = 0 ; a < NUM_ANOMALIES ; ++a )
+            message += " " + _anomalyName( a ) + "=" + std::to_string( _vAnomalies[a] );
+        _logger->log(epg::log::INFO, message);
+    };
+
+    ///
+	///
+	///
+    bool AuMatchingOp::_computeAu( ign::feature::Feature & fAu, tools::TimeBudget const* budget, bool & modified ) 
+    {
+        //app params
+        params::ThemeParameters* themeParameters = params::ThemeParametersS::getInstance();
+
+        double const boundMaxDist = themeParameters->getValue( AU_BOUNDARY_MAX_DIST ).toDouble();
+        double const boundSearchDist = themeParameters->getValue( AU_BOUNDARY_SEARCH_DIST ).toDouble();
+        double const boundSnapDist = themeParameters->getValue( AU_BOUNDARY_SNAP_DIST ).toDouble();
+        double const segmentMinLength = themeParameters->getValue( AU_SEGMENT_MIN_LENGTH ).toDouble();
 
-                    // on supprime les petits segments aux extremites qui ont etes tronquees
-                    for ( int i = 0 ; i < vLsNotTouchingParts.size() ; ++i )
+        // les structures temporaires propres a l'objet sont allouees dans une arene
+        // liberee en bloc a la fin du traitement (ou en cas d'interruption)
+        tools::MonotonicArena::Scope arenaScope( tools::MonotonicArena::Local() );
+        std::pmr::memory_resource* resource = tools::MonotonicArena::Local().resource();
+
+        // la geometrie est deplacee (et non copiee) dans la geometrie de travail : elle est
+        // restituee a l'objet, sans les sommets inseres, si elle n'est pas remplacee
+        ign::geometry::MultiPolygon mpAu( std::move( fAu.getGeometry().asMultiPolygon() ) );
+        std::vector< detail::RefinedVertex > vRefined;
+        detail::AreaGeometryRestorer geometryRestorer( fAu, mpAu, vRefined );
+        ign::geometry::algorithm::PolygonBuilderV1 polyBuilder;
+        std::pmr::set< size_t > sAddedClosedBoundary( resource );
+
+        if (_verbose) _logger->log(epg::log::DEBUG,fAu.getId());
+
+        // anomalies et diagnostics sont mis en attente : ceux d'un traitement
+        // interrompu par le budget de temps sont abandonnes, l'objet etant repris
+        _vPendingAnomalies.clear();
+        _diagnosticWriter.buffer();
+
+        detail::refineAreaWithLsEndings(_indexes->mLsLandmaskNoCoasts, mpAu, 0.1, &vRefined);
+
+        bool bIsModified = false;
+        for ( int i = 0 ; i < mpAu.numGeometries() ; ++i )
+        {
+            ign::geometry::Polygon & pAu = mpAu.polygonN(i);
+
+            for ( int j = 0 ; j < pAu.numRings() ; ++j )                                                                                                                                                                                                                                                                              
+            {
+                // interruption cooperative entre deux contours
+                if ( budget && budget->isExceeded() ) {
+                    _flushAuReports( false );
+                    return false;
+                }
+
+                ign::geometry::LineString & ring = pAu.ringN(j);
+
+                // on extrait les parties de l'UA qui ne sont pas des frontieres
+                std::pmr::vector<std::pair<int,int>> vpNotTouchingParts( resource );
+                std::pmr::vector<int> vTouchingPoints( resource );
+                if ( !detail::extractNotTouchingParts( _indexes->indexedLandmaskNoCoasts, ring, vpNotTouchingParts, &vTouchingPoints, budget ) ) {
+                    _flushAuReports( false );
+                    return false;
+                }
+
+                // on gere les boucles
+                if (vpNotTouchingParts.empty()) {
+                    bIsModified = true;
+
+                    std::set< size_t > sClosedBoundary;
+                    _indexes->qTreeClosedBoundary.query( ring.getEnvelope(), sClosedBoundary );
+
+                    bool foundBoundary = false;
+
+                    std::set< size_t >::const_iterator sit;
+                    for( sit = sClosedBoundary.begin() ; sit != sClosedBoundary.end() ; ++sit )
                     {
-                        if ( !vLsNotTouchingParts[i].startPoint().equals(vpStartEnd[i].first) && vLsNotTouchingParts[i].numPoints() > 2 ) {
-                            if (vLsNotTouchingParts[i].startPoint().distance(vLsNotTouchingParts[i].pointN(1)) < segmentMinLength) {
-                                ign::feature::Feature feature = fAu;
-                                feature.setGeometry( vLsNotTouchingParts[i].pointN(1) );
-                                _shapeLogger->writeFeature( "deleted_segments", feature );
-
-                                vLsNotTouchingParts[i].removePointN(1);
-                            }
+                        // interruption cooperative avant chaque calcul de distance de Hausdorff
+                        if ( budget && budget->isExceeded() ) {
+                            _flushAuReports( false );
+                            return false;
                         }
-                        if ( !vLsNotTouchingParts[i].endPoint().equals(vpStartEnd[i].second) && vLsNotTouchingParts[i].numPoints() > 2 ) {
-                            if (vLsNotTouchingParts[i].endPoint().distance(vLsNotTouchingParts[i].pointN(vLsNotTouchingParts[i].numPoints()-2)) < segmentMinLength) {
-                                ign::feature::Feature feature = fAu;
-                                feature.setGeometry( vLsNotTouchingParts[i].pointN(vLsNotTouchingParts[i].numPoints()-2) );
-                                _shapeLogger->writeFeature( "deleted_segments", feature );
-
-                                vLsNotTouchingParts[i].removePointN(vLsNotTouchingParts[i].numPoints()-2);
-                            }
+
+                        if ( _indexes->vMergedBoundaryIndexedLs[*sit]->distance(ring, boundMaxDist).first < 0 ) continue;
+                        ign::geometry::algorithm::OptimizedHausdorffDistanceOp hausdorfOp(ring, _indexes->vMergedBoundaryLs[*sit], -1, boundMaxDist);
+                        double distance = hausdorfOp.getDemiHausdorff(ign::geometry::algorithm::OptimizedHausdorffDistanceOp::DhdFromAtoB);
+                        if (distance < 0) {
+                            distance = hausdorfOp.getDemiHausdorff(ign::geometry::algorithm::OptimizedHausdorffDistanceOp::DhdFromBtoA);
                         }
-                    }
+                        if (distance < 0) continue;
 
-                    for ( int i = 0 ; i < vLsNotTouchingParts.size() ; ++i )
-                    {
-                        ign::feature::Feature feature = fAu;
-                        feature.setGeometry( vLsNotTouchingParts[i] );
-                        _shapeLogger->writeFeature( "not_boundaries_trim", feature );
+                        foundBoundary = true;
+
+                        if ( sAddedClosedBoundary.find(*sit) != sAddedClosedBoundary.end() ) continue;
+
+                        polyBuilder.addLineString(_indexes->vMergedBoundaryLs[*sit]);
+                        sAddedClosedBoundary.insert(*sit);
+                        
+                        _diagnosticWriter.write( "boucle", fAu.getId(), _indexes->vMergedBoundaryLs[*sit] );
+                    }
+                    if (!foundBoundary) {
+                        _anomaly(CLOSED_BOUNDARY_NOT_FOUND, "Not found closed boundary line [id] " + fAu.getId());
                     }
+                    continue;
+                }
 
-                    // on identifie les similarités geometriques landmask/boundary et on remplace les 
-                    // extremites des vLsNotTouchingParts si un candidat est trouve
-                    _findAngles(_mlsToolBoundary, vLsNotTouchingParts, vGeomFeatures, boundSearchDist, boundSnapDist);
+                // on projette les eventuels points de contact avec la frontiere
+                ign::geometry::LineString ringWithContactPoints = ring;
+                _projectTouchingPoints(_indexes->localBoundary, ringWithContactPoints, vTouchingPoints, boundSearchDist, boundSnapDist);
 
-                    // on reconstitue le nouveau contour en concatenant les parties ne touchant pas 
-                    // la frontiere et les parties touchant la frontieres projetees sur la frontiere cible
-                    ign::geometry::Point previousRingEndPoint = vLsNotTouchingParts.rbegin()->endPoint();
+                std::pmr::vector<ign::geometry::LineString> vLsNotTouchingParts( resource );
+                vLsNotTouchingParts.reserve( vpNotTouchingParts.size() );
+                for ( int i = 0 ; i < vpNotTouchingParts.size() ; ++i ) {
+                    vLsNotTouchingParts.push_back(detail::getSubString(vpNotTouchingParts[i], ringWithContactPoints));
+                }
 
-                    // on recupere les parties longeant les frontieres pour guider les chemins le long des trous
-                    std::vector<std::pair<int,int>> vpTouchingParts = _getTouchingParts(vpNotTouchingParts, ring.numPoints(), true);
-                    if ( vpTouchingParts.empty() || (vpTouchingParts.front().second != vpNotTouchingParts.front().first) ) {
-                        _logger->log(epg::log::ERROR, "Touching/not touching parts are not matching " + fAu.getId());
-                    }
+                // c est un contour fermé qui ne touche pas les frontières
+                if ( vLsNotTouchingParts.size() == 1 && vLsNotTouchingParts.front().isClosed() ) {
+                    polyBuilder.addLineString(vLsNotTouchingParts.front());
+                    if (vTouchingPoints.size() > 0) bIsModified = true;
+                    continue;
+                }
 
-                    std::vector<ign::geometry::LineString> vLsTouchingParts;
-                    for ( int i = 0 ; i < vpTouchingParts.size() ; ++i ) {
-                        vLsTouchingParts.push_back(detail::getSubString(vpTouchingParts[i], ringWithContactPoints));
-                    }
+                bIsModified = true;
 
-                    ign::geometry::LineString newRing;
-                    bool bErrorConstructingRing = false;
-                    for ( int i = 0 ; i < vLsNotTouchingParts.size() ; ++i )
-                    {
-                        std::pair< bool, ign::geometry::LineString > pathFound = _mlsToolBoundary->getPathAlong( 
-                            previousRingEndPoint,
-                            vLsNotTouchingParts[i].startPoint(),
-                            vLsTouchingParts[i],
-                            boundSearchDist, // maxDist
-                            boundSearchDist,
-                            boundSnapDist
-                        );
-                        if ( !pathFound.first ) 
-                        {
-                            _logger->log(epg::log::ERROR, "Path not found for object [id] " + fAu.getId());
-                            bErrorConstructingRing = true;
-                            break;
-                        }
+                // recupérer les angles de la frontière au niveau des extremites des vpNotTouchingParts
+                std::pmr::vector<std::pair<double, double>> vGeomFeatures( resource );
+                _getAngles(_indexes->indexedLandmaskNoCoasts, vLsNotTouchingParts, vGeomFeatures);
+                
+                for ( int i = 0 ; i < vLsNotTouchingParts.size() ; ++i ) {
+                    _diagnosticWriter.write( "not_boundaries", fAu.getId(), vLsNotTouchingParts[i] );
+                }
+                for ( int i = 0 ; i < vTouchingPoints.size() ; ++i ) {
+                    _diagnosticWriter.write( "contact_points", fAu.getId(), ring.pointN(vTouchingPoints[i]) );
+                }
 
-                        ign::feature::Feature fPAth = fAu;
-                        fPAth.setGeometry( pathFound.second );
-                        _shapeLogger->writeFeature( "path", fPAth );
+                // on supprime les overshots
+                std::pmr::vector<std::pair<ign::geometry::Point,ign::geometry::Point>> vpStartEnd( resource );
+                std::vector<ign::geometry::LineString const*> vLocalLs;
+                for ( int i = 0 ; i < vLsNotTouchingParts.size() ; ++i )
+                {
+                    epg::tools::geometry::LineStringSplitter lsSplitter( vLsNotTouchingParts[i], 1e-5 );
+
+                    _indexes->localBoundary->getLocal(vLsNotTouchingParts[i].getEnvelope(), vLocalLs);
+                    for ( size_t j = 0 ; j < vLocalLs.size() ; ++j ) lsSplitter.addCuttingGeometry(*vLocalLs[j]);
 
-                        for( ign::geometry::LineString::const_iterator lsit = pathFound.second.begin() ; lsit != pathFound.second.end(); ++lsit ) {
-                            newRing.addPoint(*lsit);
+                    vpStartEnd.push_back(std::make_pair(vLsNotTouchingParts[i].startPoint(), vLsNotTouchingParts[i].endPoint()));
+
+                    vLsNotTouchingParts[i] = lsSplitter.truncAtEnds();
+                }
+
+                // on supprime les petits segments aux extremites qui ont etes tronquees
+                for ( int i = 0 ; i < vLsNotTouchingParts.size() ; ++i )
+                {
+                    if ( !vLsNotTouchingParts[i].startPoint().equals(vpStartEnd[i].first) && vLsNotTouchingParts[i].numPoints() > 2 ) {
+                        if (vLsNotTouchingParts[i].startPoint().distance(vLsNotTouchingParts[i].pointN(1)) < segmentMinLength) {
+                            _diagnosticWriter.write( "deleted_segments", fAu.getId(), vLsNotTouchingParts[i].pointN(1) );
+
+                            vLsNotTouchingParts[i].removePointN(1);
                         }
+                    }
+                    if ( !vLsNotTouchingParts[i].endPoint().equals(vpStartEnd[i].second) && vLsNotTouchingParts[i].numPoints() > 2 ) {
+                        if (vLsNotTouchingParts[i].endPoint().distance(vLsNotTouchingParts[i].pointN(vLsNotTouchingParts[i].numPoints()-2)) < segmentMinLength) {
+                            _diagnosticWriter.write( "deleted_segments", fAu.getId(), vLsNotTouchingParts[i].pointN(vLsNotTouchingParts[i].numPoints()-2) );
 
-                        for( ign::geometry::LineString::const_iterator lsit = vLsNotTouchingParts[i].begin()+1 ; lsit != vLsNotTouchingParts[i].end()-1 ; ++lsit) {
-                            newRing.addPoint(*lsit);
+                            vLsNotTouchingParts[i].removePointN(vLsNotTouchingParts[i].numPoints()-2);
                         }
+                    }
+                }
 
-                        previousRingEndPoint = vLsNotTouchingParts[i].endPoint();
+                for ( int i = 0 ; i < vLsNotTouchingParts.size() ; ++i )
+                {
+                    _diagnosticWriter.write( "not_boundaries_trim", fAu.getId(), vLsNotTouchingParts[i] );
+                }
 
-                        if ( i == vLsNotTouchingParts.size()-1 )
-                        {
-                            newRing.addPoint(newRing.startPoint());
-                        }
+                // on identifie les similarités geometriques landmask/boundary et on remplace les 
+                // extremites des vLsNotTouchingParts si un candidat est trouve
+                _findAngles(_indexes->localBoundary, vLsNotTouchingParts, vGeomFeatures, boundSearchDist, boundSnapDist);
+
+                // on reconstitue le nouveau contour en concatenant les parties ne touchant pas 
+                // la frontiere et les parties touchant la frontieres projetees sur la frontiere cible
+                ign::geometry::Point previousRingEndPoint = vLsNotTouchingParts.rbegin()->endPoint();
+
+                // on recupere les parties longeant les frontieres pour guider les chemins le long des trous
+                std::pmr::vector<std::pair<int,int>> vpTouchingParts = _getTouchingParts(vpNotTouchingParts, ring.numPoints(), true);
+                if ( vpTouchingParts.empty() || (vpTouchingParts.front().second != vpNotTouchingParts.front().first) ) {
+                    _anomaly(PARTS_NOT_MATCHING, "Touching/not touching parts are not matching " + fAu.getId());
+                }
+
+                std::pmr::vector<ign::geometry::LineString> vLsTouchingParts( resource );
+                vLsTouchingParts.reserve( vpTouchingParts.size() );
+                for ( int i = 0 ; i < vpTouchingParts.size() ; ++i ) {
+                    vLsTouchingParts.push_back(detail::getSubString(vpTouchingParts[i], ringWithContactPoints));
+                }
+
+                ign::geometry::LineString newRing;
+                bool bErrorConstructingRing = false;
+                for ( int i = 0 ; i < vLsNotTouchingParts.size() ; ++i )
+                {
+                    // interruption cooperative avant chaque recherche de chemin
+                    if ( budget && budget->isExceeded() ) {
+                        _flushAuReports( false );
+                        return false;
                     }
-                    if (bErrorConstructingRing)
+
+                    std::pair< bool, ign::geometry::LineString > pathFound = _indexes->mlsToolBoundary->getPathAlong( 
+                        previousRingEndPoint,
+                        vLsNotTouchingParts[i].startPoint(),
+                        vLsTouchingParts[i],
+                        boundSearchDist, // maxDist
+                        boundSearchDist,
+                        boundSnapDist
+                    );
+                    if ( !pathFound.first ) 
                     {
-                        _logger->log(epg::log::ERROR, "Error constructing ring [id] " + fAu.getId());
-                        continue;
+                        _anomaly(PATH_NOT_FOUND, "Path not found for object [id] " + fAu.getId());
+                        bErrorConstructingRing = true;
+                        break;
+                    }
+
+                    _diagnosticWriter.write( "path", fAu.getId(), pathFound.second );
+
+                    for( ign::geometry::LineString::const_iterator lsit = pathFound.second.begin() ; lsit != pathFound.second.end(); ++lsit ) {
+                        newRing.addPoint(*lsit);
+                    }
+
+                    for( ign::geometry::LineString::const_iterator lsit = vLsNotTouchingParts[i].begin()+1 ; lsit != vLsNotTouchingParts[i].end()-1 ; ++lsit) {
+                        newRing.addPoint(*lsit);
                     }
 
-                    // vRings.push_back(newRing);
-                    polyBuilder.addLineString(newRing);
+                    previousRingEndPoint = vLsNotTouchingParts[i].endPoint();
 
-                    for ( int i = 0 ; i < vLsNotTouchingParts.size() ; ++i )
+                    if ( i == vLsNotTouchingParts.size()-1 )
                     {
-                        ign::feature::Feature feature = fAu;
-                        feature.setGeometry( vLsNotTouchingParts[i] );
-                        _shapeLogger->writeFeature( "not_boundaries_merged", feature );
-                    }    
+                        newRing.addPoint(newRing.startPoint());
+                    }
+                }
+                if (bErrorConstructingRing)
+                {
+                    _anomaly(RING_ERROR, "Error constructing ring [id] " + fAu.getId());
+                    continue;
                 }
-            }
 
-            ign::geometry::MultiPolygon newGeometry = polyBuilder.getMultiPolygon();
+                // vRings.push_back(newRing);
+                polyBuilder.addLineString(newRing);
 
-            if (!bIsModified || newGeometry.equals(mpAu)) {
-                _shapeLogger->writeFeature( "resulting_polygons_not_modified", fAu );
-            } else {
-                fAu.setGeometry(newGeometry);
-                if ( !newGeometry.isEmpty() )
+                for ( int i = 0 ; i < vLsNotTouchingParts.size() ; ++i )
                 {
-                    _fsArea->modifyFeature(fAu);
-                } else {
-                    _logger->log(epg::log::ERROR, "MultiPolygon is empty [id] " + fAu.getId());
-                }
-                
-                if ( !newGeometry.isValid() ) {
-                    _logger->log(epg::log::ERROR, "MultiPolygon is not valid [id] " + fAu.getId());
-                    _shapeLogger->writeFeature( "resulting_polygons_not_valid", fAu );
-                }
-                _shapeLogger->writeFeature( "resulting_polygons", fAu );
+                    _diagnosticWriter.write( "not_boundaries_merged", fAu.getId(), vLsNotTouchingParts[i] );
+                }    
             }
         }
 
-        delete indexedLandmaskNoCoasts;
-        for (size_t i = 0 ; i < vMergedBoundaryIndexedLs.size() ; ++i) {
-            delete vMergedBoundaryIndexedLs[i];
+        ign::geometry::MultiPolygon newGeometry = polyBuilder.getMultiPolygon();
+
+        if (!bIsModified || newGeometry.equals(mpAu)) {
+            geometryRestorer.restore();
+            if ( _shapeLogger ) _shapeLogger->writeFeature( "resulting_polygons_not_modified", fAu );
+        } else {
+            geometryRestorer.release();
+            fAu.setGeometry(newGeometry);
+            if ( !newGeometry.isEmpty() )
+            {
+                modified = true;
+            } else {
+                _anomaly(EMPTY_RESULT, "MultiPolygon is empty [id] " + fAu.getId());
+            }
+            
+            if ( !newGeometry.isValid() ) {
+                _anomaly(INVALID_RESULT, "MultiPolygon is not valid [id] " + fAu.getId());
+                if ( _shapeLogger ) _shapeLogger->writeFeature( "resulting_polygons_not_valid", fAu );
+            }
+            if ( _shapeLogger ) _shapeLogger->writeFeature( "resulting_polygons", fAu );
         }
+
+        _flushAuReports( true );
+        return true;
     };
 
+    ///
+	///
+	///
+    std::string AuMatchingOp::_getAuHash(
+        ign::feature::Feature const& fAu,
+        std::string const& paramsKey,
+        double radius
+    ) const {
+        tools::Hash64 hash;
+        hash.add( paramsKey );
+
+        std::string wkb;
+        io::Wkb::Write( fAu.getGeometry(), wkb );
+        hash.add( wkb );
+
+        ign::geometry::Envelope envelope = fAu.getGeometry().getEnvelope();
+        envelope.expandBy( radius );
+
+        // l'ordre de restitution des index n'etant pas garanti, les empreintes
+        // des polylignes voisines sont combinees par somme
+        uint64_t boundaryHash = 0;
+        ign::geometry::MultiLineString mlsBoundary;
+        _indexes->mlsToolBoundary->getLocal( envelope, mlsBoundary );
+        for ( size_t i = 0 ; i < mlsBoundary.numGeometries() ; ++i )
+            boundaryHash += _getHash( mlsBoundary.lineStringN(i) );
+
+        std::set< size_t > sClosedBoundary;
+        _indexes->qTreeClosedBoundary.query( envelope, sClosedBoundary );
+        for ( std::set< size_t >::const_iterator sit = sClosedBoundary.begin() ; sit != sClosedBoundary.end() ; ++sit )
+            boundaryHash += _getHash( _indexes->vMergedBoundaryLs[*sit] );
+
+        // les portions hors cotes sont indexees dans l'ordre de _indexes->mLsLandmaskNoCoasts
+        uint64_t noCoastHash = 0;
+        std::set< size_t > sNoCoast;
+        _indexes->indexedLandmaskNoCoasts->getGeometries( envelope, sNoCoast );
+        for ( std::set< size_t >::const_iterator sit = sNoCoast.begin() ; sit != sNoCoast.end() ; ++sit )
+            if ( _indexes->mLsLandmaskNoCoasts.lineStringN(*sit).getEnvelope().intersects( envelope ) )
+                noCoastHash += _getHash( _indexes->mLsLandmaskNoCoasts.lineStringN(*sit) );
+
+        hash.add( &boundaryHash, sizeof( boundaryHash ) );
+        hash.add( &noCoastHash, sizeof( noCoastHash ) );
+        return hash.toString();
+    }
+
+    ///
+	///
+	///
+    uint64_t AuMatchingOp::_getHash( const ign::geometry::LineString & ls )
+    {
+        tools::Hash64 hash;
+        for ( size_t i = 0 ; i < ls.numPoints() ; ++i ) {
+            double const x = ls.pointN(i).x();
+            double const y = ls.pointN(i).y();
+            hash.add( &x, sizeof( x ) ).add( &y, sizeof( y ) );
+        }
+        return hash.value();
+    }
+
     ///
 	///
 	///
     void AuMatchingOp::_getAngles( 
         tools::SegmentIndexedGeometryCollection* indexedGeom, 
-        const std::vector<ign::geometry::LineString> & vLs,
-        std::vector<std::pair<double, double>> & vGeomFeatures) const
+        const std::pmr::vector<ign::geometry::LineString> & vLs,
+        std::pmr::vector<std::pair<double, double>> & vGeomFeatures) const
     {
         for ( size_t i = 0 ; i < vLs.size() ; ++i ) {
             vGeomFeatures.push_back(std::make_pair(_getAngle(indexedGeom, vLs[i].startPoint()), _getAngle(indexedGeom, vLs[i].endPoint())));
@@ -495,7 +1078,7 @@ namespace calcul{
         const ign::geometry::Point & refPoint,
         double angle,
         double searchDistance
-    ) const {
+    ) {
         std::pair<int, double>  newIndex1 = _findIndex(ls, startIndex, refPoint, angle, searchDistance, true);
         std::pair<int, double>  newIndex2 = _findIndex(ls, --startIndex, refPoint, angle, searchDistance, false);
         if ( newIndex1.first < 0 && newIndex2.first < 0 ) return -1;
@@ -509,7 +1092,7 @@ namespace calcul{
         double refAngle, 
         double angle, 
         double distance
-    ) const {
+    ) {
         double deltaAngle = abs(refAngle-angle);
         double angleScore = -1;
         if ( deltaAngle < 0.174532925 ) // 10
@@ -539,7 +1122,7 @@ namespace calcul{
         double refAngle,
         double searchDistance, 
         bool positiveDirection 
-    ) const {
+    ) {
         double distance = ls.pointN(startIndex).distance(refPoint);
         size_t index = startIndex;
         size_t bestIndex = -1;
@@ -565,20 +1148,22 @@ namespace calcul{
 	///
 	///
     std::pair<bool, ign::geometry::Point> AuMatchingOp::_findCandidate( 
-        epg::tools::MultiLineStringTool* mlsTool, 
+        tools::LocalTileCache* localBoundary, 
         const ign::geometry::Point & pt,
         double angle,
         double boundSearchDistance,
         double vertexSearchDistance
         ) const
     {					
-        std::pair< bool, ign::geometry::Point > foundProjection = mlsTool->project( pt, boundSearchDistance);
+        std::pair< bool, ign::geometry::Point > foundProjection = localBoundary->tool()->project( pt, boundSearchDistance);
         if (!foundProjection.first) return std::make_pair(false, ign::geometry::Point());
 
-        ign::geometry::MultiLineString mls;
-        mlsTool->getLocal( pt.getEnvelope().expandBy(boundSearchDistance), mls);
+        std::vector<ign::geometry::LineString const*> vLocalLs;
+        localBoundary->getLocal( pt.getEnvelope().expandBy(boundSearchDistance), vLocalLs);
 
-        std::vector<ign::geometry::LineString> vMergedLs = ign::geometry::algorithm::LineMergerOpGeos::MergeLineStrings(mls);
+        ign::geometry::algorithm::LineMergerOpGeos merger;
+        for ( size_t i = 0 ; i < vLocalLs.size() ; ++i ) merger.add( *vLocalLs[i] );
+        std::vector<ign::geometry::LineString> vMergedLs = merger.getMergedLineStrings();
         for ( size_t i = 0 ; i < vMergedLs.size() ; ++i ) {
             ign::geometry::Polygon bbox = foundProjection.second.getEnvelope().expandBy(1e-5).toPolygon();
             if ( bbox.intersects(vMergedLs[i]) ) {
@@ -597,9 +1182,7 @@ namespace calcul{
 
                 if ( newIndex < 0 ) break;
 
-                ign::feature::Feature feature;
-                feature.setGeometry( vMergedLs[i].pointN(newIndex) );
-                _shapeLogger->writeFeature( "projected_point_on_sharp", feature );
+                _diagnosticWriter.write( "projected_point_on_sharp", "", vMergedLs[i].pointN(newIndex) );
 
                 return std::make_pair(true, vMergedLs[i].pointN(newIndex));
             }
@@ -611,9 +1194,9 @@ namespace calcul{
 	///
 	///
     void AuMatchingOp::_findAngles( 
-        epg::tools::MultiLineStringTool* mlsTool, 
-        std::vector<ign::geometry::LineString> & vLs,
-        const std::vector<std::pair<double, double>> & vGeomFeatures,
+        tools::LocalTileCache* localBoundary, 
+        std::pmr::vector<ign::geometry::LineString> & vLs,
+        const std::pmr::vector<std::pair<double, double>> & vGeomFeatures,
         double searchDistance,
         double vertexSnapDist
     ) const {
@@ -625,7 +1208,7 @@ namespace calcul{
             std::pair<bool, ign::geometry::Point> foundPointEnd = std::make_pair(false, ign::geometry::Point());
 
             if ( vGeomFeatures[i].first != 0 ) {
-                foundPointStart = _findCandidate(mlsTool, vLs[i].startPoint(), vGeomFeatures[i].first, searchDistance, vertexSnapDist);
+                foundPointStart = _findCandidate(localBoundary, vLs[i].startPoint(), vGeomFeatures[i].first, searchDistance, vertexSnapDist);
                 if (foundPointStart.first) {
                     ign::geometry::Point projectedPoint;
                     bool found = epg::tools::geometry::project( vLs[i], foundPointStart.second, projectedPoint, vertexSnapDist);
@@ -635,7 +1218,7 @@ namespace calcul{
                 }
             }
             if ( vGeomFeatures[i].second != 0 ) {
-                foundPointEnd = _findCandidate(mlsTool, vLs[i].endPoint(), vGeomFeatures[i].second, searchDistance, vertexSnapDist);
+                foundPointEnd = _findCandidate(localBoundary, vLs[i].endPoint(), vGeomFeatures[i].second, searchDistance, vertexSnapDist);
                 if (foundPointEnd.first) {
                     ign::geometry::Point projectedPoint;
                     bool found = epg::tools::geometry::project( vLs[i], foundPointEnd.second, projectedPoint, vertexSnapDist);
@@ -654,9 +1237,9 @@ namespace calcul{
 	///
 	///
     void AuMatchingOp::_projectTouchingPoints(
-        epg::tools::MultiLineStringTool* mlsTool, 
+        tools::LocalTileCache* localBoundary, 
         ign::geometry::LineString & ls, 
-        const std::vector<int> & vTouchingPoints,
+        const std::pmr::vector<int> & vTouchingPoints,
         double searchDistance,
         double snapDistOnVertex
     ) const {
@@ -664,11 +1247,11 @@ namespace calcul{
 
         for ( int i = 0 ; i < vTouchingPoints.size() ; ++i )
         {
-            std::pair< bool, ign::geometry::Point > foundProjectedPoint = mlsTool->project(ls.pointN(vTouchingPoints[i]), searchDistance, snapDistOnVertex);
+            std::pair< bool, ign::geometry::Point > foundProjectedPoint = localBoundary->tool()->project(ls.pointN(vTouchingPoints[i]), searchDistance, snapDistOnVertex);
             if (foundProjectedPoint.first) {
                 ls.setPointN(foundProjectedPoint.second, vTouchingPoints[i]);
             } else {
-                _logger->log(epg::log::ERROR, "Touching point not projected : " + ls.pointN(vTouchingPoints[i]).toString());
+                _anomaly(POINT_NOT_PROJECTED, "Touching point not projected : " + ls.pointN(vTouchingPoints[i]).toString());
             }
         }
 
@@ -680,12 +1263,12 @@ namespace calcul{
     ///
     ///
     ///
-    std::vector<std::pair<int,int>> AuMatchingOp::_getTouchingParts(
-        std::vector<std::pair<int,int>> const& vpNotTouchingParts, 
+    std::pmr::vector<std::pair<int,int>> AuMatchingOp::_getTouchingParts(
+        std::pmr::vector<std::pair<int,int>> const& vpNotTouchingParts, 
         size_t nbPoints, 
         bool isClosed) const 
     {
-        std::vector<std::pair<int,int>> vpTouchingParts;
+        std::pmr::vector<std::pair<int,int>> vpTouchingParts( vpNotTouchingParts.get_allocator() );
 
         if ( vpNotTouchingParts.empty() ) {
             vpTouchingParts.push_back(std::make_pair(0, nbPoints-1));
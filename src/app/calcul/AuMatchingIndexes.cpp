@@ -0,0 +1,51 @@
+// APP
+#include <app/calcul/AuMatchingIndexes.h>
+
+
+namespace app{
+namespace calcul{
+
+    ///
+	///
+	///
+    AuMatchingIndexes::AuMatchingIndexes():
+        mlsToolBoundary( 0 ),
+        localBoundary( 0 ),
+        indexedLandmaskNoCoasts( 0 )
+    {
+    }
+
+    ///
+	///
+	///
+    AuMatchingIndexes::~AuMatchingIndexes()
+    {
+        clear();
+    }
+
+    ///
+	///
+	///
+    void AuMatchingIndexes::clear()
+    {
+        countryCode.clear();
+
+        delete localBoundary;
+        localBoundary = 0;
+        delete mlsToolBoundary;
+        mlsToolBoundary = 0;
+        delete indexedLandmaskNoCoasts;
+        indexedLandmaskNoCoasts = 0;
+        for (size_t i = 0 ; i < vMergedBoundaryIndexedLs.size() ; ++i) {
+            delete vMergedBoundaryIndexedLs[i];
+        }
+        vMergedBoundaryIndexedLs.clear();
+
+        mLsBoundaryContours = ign::geometry::MultiLineString();
+        mLsLandmaskNoCoasts = ign::geometry::MultiLineString();
+        vMergedBoundaryLs.clear();
+        qTreeClosedBoundary.clear();
+    }
+
+}
+}
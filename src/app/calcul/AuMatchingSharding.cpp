@@ -0,0 +1,237 @@
+// APP
+#include <app/calcul/AuMatchingSharding.h>
+#include <app/calcul/AuMatchingOp.h>
+#include <app/io/FeatureRecordFile.h>
+#include <app/params/ThemeParameters.h>
+#include <app/tools/AllocationTracker.h>
+#include <app/tools/TimeBudget.h>
+#include <app/utils/forkTasks.h>
+
+//STL
+#include <algorithm>
+#include <limits>
+#include <map>
+
+//BOOST
+#include <boost/filesystem.hpp>
+
+//EPG
+#include <epg/tools/TimeTools.h>
+
+
+namespace app{
+namespace calcul{
+
+    ///
+	///
+	///
+    size_t AuMatchingSharding::Compute(
+        AuMatchingOp & op,
+        size_t shardCount,
+        io::FeaturePipeline & pipeline,
+        io::ResultManifest & manifest,
+        io::Checkpoint & checkpoint,
+        std::string const& paramsKey,
+        double influenceRadius,
+        boost::progress_display & display
+    ) {
+        tools::AllocationPhase allocationPhase("[630] sharded au processing");
+
+        op._logger->log(epg::log::INFO, "[START] sharded au processing: "+epg::tools::TimeTools::getTime());
+
+        size_t const checkpointInterval = static_cast<size_t>( std::max( params::ThemeParametersS::getInstance()->getValue( AU_CHECKPOINT_INTERVAL ).toDouble(), 1. ) );
+
+        // lecture de l'ensemble des objets : les resultats repris du manifeste sont
+        // enregistres directement, les autres sont repartis entre les tuiles
+        std::vector<ign::feature::Feature> vAu;
+        std::vector<std::string> vAuHash;
+        ign::feature::Feature fAu;
+        while (pipeline.next(fAu))
+        {
+            if ( checkpoint.contains(fAu.getId()) ) {
+                manifest.carryForward(fAu.getId());
+                ++display;
+                continue;
+            }
+
+            std::string auHash;
+            if ( manifest.isEnabled() ) {
+                auHash = op._getAuHash(fAu, paramsKey, influenceRadius);
+                bool written = false;
+                if ( manifest.find(fAu, auHash, written) ) {
+                    if ( written ) pipeline.write(fAu);
+                    checkpoint.add(fAu.getId());
+                    ++display;
+                    continue;
+                }
+            }
+            vAu.push_back(fAu);
+            vAuHash.push_back(auHash);
+        }
+        if ( vAu.empty() ) return 0;
+
+        // tuiles : bandes verticales d'effectifs egaux. Un objet appartient a la seule
+        // tuile contenant le centre de son emprise ; le tri (abscisse du centre puis
+        // identifiant) rend l'affectation independante de l'ordre de lecture
+        std::vector<double> vCenterX( vAu.size() );
+        for ( size_t i = 0 ; i < vAu.size() ; ++i ) {
+            ign::geometry::Envelope const envelope = vAu[i].getGeometry().getEnvelope();
+            vCenterX[i] = 0.5 * ( envelope.xmin() + envelope.xmax() );
+        }
+        std::vector<size_t> vOrder( vAu.size() );
+        for ( size_t i = 0 ; i < vOrder.size() ; ++i ) vOrder[i] = i;
+        std::sort( vOrder.begin(), vOrder.end(), [&]( size_t a, size_t b ) {
+            if ( vCenterX[a] != vCenterX[b] ) return vCenterX[a] < vCenterX[b];
+            return vAu[a].getId() < vAu[b].getId();
+        } );
+
+        size_t const numShards = std::min( shardCount, vAu.size() );
+        std::vector< std::vector<size_t> > vShardIndex( numShards );
+        std::vector<size_t> vAuShard( vAu.size() );
+        for ( size_t k = 0 ; k < vOrder.size() ; ++k ) {
+            size_t const shard = k * numShards / vOrder.size();
+            vShardIndex[shard].push_back( vOrder[k] );
+            vAuShard[vOrder[k]] = shard;
+        }
+
+        // halo : emprise des objets de la tuile elargie du rayon d'influence
+        std::vector<ign::geometry::Envelope> vHalo( numShards );
+        for ( size_t s = 0 ; s < numShards ; ++s ) {
+            double xmin = std::numeric_limits<double>::max(), ymin = xmin;
+            double xmax = -xmin, ymax = -xmin;
+            for ( size_t k = 0 ; k < vShardIndex[s].size() ; ++k ) {
+                ign::geometry::Envelope const envelope = vAu[vShardIndex[s][k]].getGeometry().getEnvelope();
+                xmin = std::min( xmin, envelope.xmin() ); ymin = std::min( ymin, envelope.ymin() );
+                xmax = std::max( xmax, envelope.xmax() ); ymax = std::max( ymax, envelope.ymax() );
+            }
+            vHalo[s] = ign::geometry::Envelope( ign::geometry::Point( xmin, ymin ), ign::geometry::Point( xmax, ymax ) );
+            vHalo[s].expandBy( influenceRadius );
+        }
+
+        // un processus fils par tuile ; les resultats sont echanges par fichiers
+        boost::filesystem::path const shardDirectory = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path( "au_matching_630_" + op._countryCode + "_%%%%%%%%" );
+        boost::filesystem::create_directories( shardDirectory );
+
+        std::vector<std::string> vLabels( numShards );
+        for ( size_t s = 0 ; s < numShards ; ++s ) vLabels[s] = "[630] shard " + std::to_string(s) + " (" + std::to_string(vShardIndex[s].size()) + " objects)";
+
+        std::vector<size_t> vFailedShards = utils::forkTasks( vLabels, numShards, [&]( size_t s ) {
+            _computeShard( op, vAu, vShardIndex[s], vHalo[s], ( shardDirectory / ( "shard_" + std::to_string(s) + ".bin" ) ).string() );
+            op._logAnomalies( vLabels[s] + " anomalies" );
+            return 0;
+        } );
+
+        // resultats des processus termines avec succes
+        std::vector<bool> vShardDone( numShards, true );
+        for ( size_t k = 0 ; k < vFailedShards.size() ; ++k ) {
+            vShardDone[vFailedShards[k]] = false;
+            op._logger->log(epg::log::ERROR, vLabels[vFailedShards[k]] + " failed, objects not processed");
+        }
+        std::map<std::string, ign::feature::Feature> mResults;
+        for ( size_t s = 0 ; s < numShards ; ++s ) {
+            if ( !vShardDone[s] ) continue;
+
+            io::FeatureRecordReader reader( ( shardDirectory / ( "shard_" + std::to_string(s) + ".bin" ) ).string() );
+            ign::feature::Feature fResult;
+            while ( reader.next(fResult) ) mResults[fResult.getId()] = fResult;
+        }
+        boost::filesystem::remove_all( shardDirectory );
+
+        // enregistrement dans l'ordre de lecture : seule la geometrie calculee est
+        // reportee sur l'objet lu (les attributs sont conserves)
+        size_t numFailed = 0;
+        for ( size_t i = 0 ; i < vAu.size() ; ++i ) {
+            if ( !vShardDone[vAuShard[i]] ) {
+                ++numFailed;
+                continue;
+            }
+            ++display;
+
+            std::map<std::string, ign::feature::Feature>::const_iterator mit = mResults.find( vAu[i].getId() );
+            bool const modified = mit != mResults.end();
+            if ( modified ) {
+                vAu[i].setGeometry( mit->second.getGeometry() );
+                pipeline.write(vAu[i]);
+            }
+            manifest.add(vAu[i], vAuHash[i], modified);
+
+            checkpoint.add(vAu[i].getId());
+            if ( checkpoint.numPending() >= checkpointInterval ) {
+                pipeline.commit();
+                checkpoint.save();
+            }
+        }
+
+        op._logger->log(epg::log::INFO, "[END] sharded au processing: "+epg::tools::TimeTools::getTime());
+
+        return numFailed;
+    }
+
+    ///
+	///
+	///
+    void AuMatchingSharding::_computeShard(
+        AuMatchingOp & op,
+        std::vector< ign::feature::Feature > const& vAu,
+        std::vector< size_t > const& vIndex,
+        ign::geometry::Envelope const& halo,
+        std::string const& path
+    ) {
+        double const featureTimeBudget = params::ThemeParametersS::getInstance()->getValue( AU_FEATURE_TIME_BUDGET ).toDouble();
+
+        // les fichiers de diagnostic sont ouverts par le processus parent
+        op._disableDiagnostics( false );
+
+        _restrictToHalo( op, halo );
+
+        io::FeatureRecordWriter writer( path, std::vector<std::string>() );
+
+        std::vector<size_t> vDeferred;
+        tools::TimeBudget budget( featureTimeBudget );
+        for ( size_t k = 0 ; k < vIndex.size() ; ++k ) {
+            ign::feature::Feature fAu = vAu[vIndex[k]];
+            budget.start();
+            bool modified = false;
+            if ( !op._computeAu(fAu, &budget, modified) ) {
+                op._logger->log(epg::log::WARN, "Time budget exceeded, object deferred [id] " + fAu.getId());
+                vDeferred.push_back( vIndex[k] );
+                continue;
+            }
+            if ( modified ) writer.write(fAu);
+        }
+
+        for ( size_t k = 0 ; k < vDeferred.size() ; ++k ) {
+            ign::feature::Feature fAu = vAu[vDeferred[k]];
+            bool modified = false;
+            op._computeAu(fAu, 0, modified);
+            if ( modified ) writer.write(fAu);
+        }
+    }
+
+    ///
+	///
+	///
+    void AuMatchingSharding::_restrictToHalo( AuMatchingOp & op, ign::geometry::Envelope const& halo )
+    {
+        // les lignes intersectant le halo sont conservees entieres
+        ign::geometry::MultiLineString mLsBoundaryContours;
+        for ( size_t i = 0 ; i < op._indexes->mLsBoundaryContours.numGeometries() ; ++i ) {
+            if ( op._indexes->mLsBoundaryContours.lineStringN(i).getEnvelope().intersects( halo ) )
+                mLsBoundaryContours.addGeometry( op._indexes->mLsBoundaryContours.lineStringN(i) );
+        }
+        op._indexes->mLsBoundaryContours = mLsBoundaryContours;
+        delete op._indexes->mlsToolBoundary;
+        op._indexes->mlsToolBoundary = new epg::tools::MultiLineStringTool( op._indexes->mLsBoundaryContours );
+        op._initLocalBoundary();
+
+        ign::geometry::MultiLineString mLsLandmaskNoCoasts;
+        for ( size_t i = 0 ; i < op._indexes->mLsLandmaskNoCoasts.numGeometries() ; ++i ) {
+            if ( op._indexes->mLsLandmaskNoCoasts.lineStringN(i).getEnvelope().intersects( halo ) )
+                mLsLandmaskNoCoasts.addGeometry( op._indexes->mLsLandmaskNoCoasts.lineStringN(i) );
+        }
+        op._indexes->mLsLandmaskNoCoasts = mLsLandmaskNoCoasts;
+        op._indexLandmaskNoCoasts();
+    }
+
+}
+}
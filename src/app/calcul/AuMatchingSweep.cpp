@@ -0,0 +1,181 @@
+// APP
+#include <app/calcul/AuMatchingSweep.h>
+#include <app/calcul/AuMatchingOp.h>
+#include <app/detail/getNoCoastEnvelopes.h>
+#include <app/params/ThemeParameters.h>
+#include <app/tools/AllocationTracker.h>
+#include <app/tools/TimeBudget.h>
+#include <app/utils/forkTasks.h>
+
+//STL
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+
+//BOOST
+#include <boost/filesystem.hpp>
+
+//EPG
+#include <epg/Context.h>
+#include <epg/params/EpgParameters.h>
+#include <epg/tools/TimeTools.h>
+
+
+namespace app{
+namespace detail{
+
+    //-- parametres de calcul pouvant varier dans un balayage
+    AU_PARAMETERS getSweepParameter( std::string const& name )
+    {
+        if ( name == "AU_BOUNDARY_MAX_DIST" ) return AU_BOUNDARY_MAX_DIST;
+        if ( name == "AU_BOUNDARY_SEARCH_DIST" ) return AU_BOUNDARY_SEARCH_DIST;
+        if ( name == "AU_BOUNDARY_SNAP_DIST" ) return AU_BOUNDARY_SNAP_DIST;
+        if ( name == "AU_SEGMENT_MIN_LENGTH" ) return AU_SEGMENT_MIN_LENGTH;
+        IGN_THROW_EXCEPTION( "[ app::calcul::AuMatchingSweep ] parameter '" + name + "' cannot be swept" );
+    }
+}
+
+namespace calcul{
+
+    ///
+	///
+	///
+    void AuMatchingSweep::Compute(
+        std::string countryCode,
+        std::vector< utils::ParameterSet > const& vParameterSets,
+        size_t parallelism,
+        std::string const& reportPath
+    ) {
+        tools::AllocationPhase allocationPhase("[630] sweep");
+
+        AuMatchingOp op(countryCode, false);
+
+        epg::params::EpgParameters const& epgParams = epg::ContextS::getInstance()->getEpgParameters();
+        std::string const countryCodeName = epgParams.getValue( COUNTRY_CODE ).toString();
+
+        params::ThemeParameters* themeParameters = params::ThemeParametersS::getInstance();
+
+        // verification des parametres avant tout chargement ; la lecture des unites
+        // administratives porte sur la plus grande distance de recherche evaluee
+        double searchDist = themeParameters->getValue( AU_BOUNDARY_SEARCH_DIST ).toDouble();
+        for ( size_t i = 0 ; i < vParameterSets.size() ; ++i ) {
+            for ( size_t j = 0 ; j < vParameterSets[i].size() ; ++j ) {
+                if ( detail::getSweepParameter( vParameterSets[i][j].first ) == AU_BOUNDARY_SEARCH_DIST )
+                    searchDist = std::max( searchDist, std::atof( vParameterSets[i][j].second.c_str() ) );
+            }
+        }
+
+        op._logger->log(epg::log::INFO, "[START] sweep loading: "+epg::tools::TimeTools::getTime());
+
+        op._loadIndexes();
+
+        std::vector<ign::geometry::Envelope> const vNoCoastEnvelopes = detail::getNoCoastEnvelopes(op._indexes->mLsLandmaskNoCoasts, searchDist);
+        io::Query const areaQuery = io::Query().equals(countryCodeName, op._countryCode).intersects(vNoCoastEnvelopes);
+
+        std::vector<ign::feature::Feature> vAu;
+        io::FeatureCursorPtr itAu = op._dataSource->getFeatures(op._areaTableName, areaQuery);
+        ign::feature::Feature fAu;
+        while (itAu->next(fAu)) vAu.push_back(fAu);
+
+        op._logger->log(epg::log::INFO, "[END] sweep loading: "+epg::tools::TimeTools::getTime());
+        op._logger->log(epg::log::INFO, "[630] sweep : " + std::to_string(vParameterSets.size()) + " parameter sets, " + std::to_string(vAu.size()) + " objects");
+
+        // un processus fils par jeu de parametres ; chacun ecrit sa ligne du rapport
+        boost::filesystem::path const sweepDirectory = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path( "au_matching_sweep_" + op._countryCode + "_%%%%%%%%" );
+        boost::filesystem::create_directories( sweepDirectory );
+
+        std::vector<std::string> vLabels( vParameterSets.size() );
+        std::vector<std::string> vDescriptions( vParameterSets.size() );
+        for ( size_t i = 0 ; i < vParameterSets.size() ; ++i ) {
+            for ( size_t j = 0 ; j < vParameterSets[i].size() ; ++j )
+                vDescriptions[i] += ( j ? " " : "" ) + vParameterSets[i][j].first + "=" + vParameterSets[i][j].second;
+            vLabels[i] = "[630] sweep set " + std::to_string(i) + " (" + vDescriptions[i] + ")";
+        }
+
+        std::vector<size_t> vFailedSets = utils::forkTasks( vLabels, parallelism, [&]( size_t i ) {
+            _evaluate( op, vAu, vParameterSets[i], ( sweepDirectory / ( "set_" + std::to_string(i) + ".txt" ) ).string() );
+            return 0;
+        } );
+        std::vector<bool> vSetDone( vParameterSets.size(), true );
+        for ( size_t k = 0 ; k < vFailedSets.size() ; ++k ) vSetDone[vFailedSets[k]] = false;
+
+        // rapport : une ligne par jeu de parametres
+        std::ofstream report( reportPath.c_str() );
+        if ( !report )
+            IGN_THROW_EXCEPTION( "[ app::calcul::AuMatchingSweep ] unable to create '" + reportPath + "'" );
+
+        report << "set;parameters;status;time_s;objects;modified;not_modified";
+        for ( size_t a = 0 ; a < AuMatchingOp::NUM_ANOMALIES ; ++a ) report << ";" << AuMatchingOp::_anomalyName( a );
+        report << ";mean_area_change;max_area_change" << std::endl;
+
+        for ( size_t i = 0 ; i < vParameterSets.size() ; ++i ) {
+            report << i << ";" << vDescriptions[i] << ";";
+            std::string line;
+            if ( vSetDone[i] ) {
+                std::ifstream ifs( ( sweepDirectory / ( "set_" + std::to_string(i) + ".txt" ) ).string().c_str() );
+                std::getline( ifs, line );
+            }
+            report << ( line.empty() ? "failed" : "ok;" + line ) << std::endl;
+        }
+        boost::filesystem::remove_all( sweepDirectory );
+
+        op._logger->log(epg::log::INFO, "[630] sweep report : " + reportPath);
+    }
+
+    ///
+	///
+	///
+    void AuMatchingSweep::_evaluate(
+        AuMatchingOp & op,
+        std::vector< ign::feature::Feature > const& vAu,
+        utils::ParameterSet const& parameterSet,
+        std::string const& path
+    ) {
+        // le processus fils n'ecrit ni dans les fichiers de diagnostic ni dans le log
+        // (les anomalies sont seulement comptees)
+        op._disableDiagnostics( true );
+
+        params::ThemeParameters* themeParameters = params::ThemeParametersS::getInstance();
+        for ( size_t j = 0 ; j < parameterSet.size() ; ++j )
+            themeParameters->setParameter( detail::getSweepParameter( parameterSet[j].first ), ign::data::String( parameterSet[j].second ) );
+
+        // la lecture a ete realisee avec la plus grande distance de recherche : seuls les
+        // objets retenus par le prefiltre de ce jeu de parametres sont evalues
+        double const boundSearchDist = themeParameters->getValue( AU_BOUNDARY_SEARCH_DIST ).toDouble();
+        std::vector<ign::geometry::Envelope> const vNoCoastEnvelopes = detail::getNoCoastEnvelopes(op._indexes->mLsLandmaskNoCoasts, boundSearchDist);
+        io::Query const areaQuery = io::Query().intersects(vNoCoastEnvelopes);
+
+        size_t numObjects = 0, numModified = 0;
+        double sumAreaChange = 0, maxAreaChange = 0;
+        tools::TimeBudget chrono( 0 );
+        for ( size_t i = 0 ; i < vAu.size() ; ++i ) {
+            if ( !areaQuery.matches( vAu[i] ) ) continue;
+            ++numObjects;
+
+            ign::feature::Feature fAu = vAu[i];
+            double const area = fAu.getGeometry().asMultiPolygon().area();
+            bool modified = false;
+            op._computeAu(fAu, 0, modified);
+            if ( !modified ) continue;
+
+            ++numModified;
+            if ( area > 0 ) {
+                double const areaChange = std::abs( fAu.getGeometry().asMultiPolygon().area() - area ) / area;
+                sumAreaChange += areaChange;
+                maxAreaChange = std::max( maxAreaChange, areaChange );
+            }
+        }
+        double const elapsed = chrono.elapsed();
+
+        std::ofstream ofs( path.c_str() );
+        ofs << std::setprecision(6) << elapsed << ";" << numObjects << ";" << numModified << ";" << ( numObjects - numModified );
+        for ( size_t a = 0 ; a < AuMatchingOp::NUM_ANOMALIES ; ++a ) ofs << ";" << op._vAnomalies[a];
+        ofs << ";" << ( numModified ? sumAreaChange / numModified : 0. ) << ";" << maxAreaChange << std::endl;
+        if ( !ofs )
+            IGN_THROW_EXCEPTION( "[ app::calcul::AuMatchingSweep ] unable to write '" + path + "'" );
+    }
+
+}
+}
@@ -0,0 +1,190 @@
+// APP
+#include <app/calcul/ContextBundle.h>
+#include <app/calcul/AuMatchingOp.h>
+#include <app/io/FeatureRecordFile.h>
+#include <app/io/Wkb.h>
+#include <app/params/ThemeParameters.h>
+#include <app/tools/TimeBudget.h>
+
+//STL
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <vector>
+
+//BOOST
+#include <boost/filesystem.hpp>
+
+//EPG
+#include <epg/Context.h>
+#include <epg/params/EpgParameters.h>
+#include <epg/params/tools/loadParameters.h>
+
+
+namespace app{
+namespace detail{
+
+    //-- fichiers d'un contexte de calcul (ContextBundle::Dump), a cote de l'enregistrement des lectures
+    const std::string BUNDLE_IDS_FILE = "ids.txt";
+    const std::string BUNDLE_THEME_PARAMETERS_FILE = "theme_parameters.ini";
+    const std::string BUNDLE_EPG_PARAMETERS_FILE = "epg_parameters.ini";
+    const std::string BUNDLE_RESULT_FILE = "result.bin";
+
+    //--
+    void writeParameters( std::string const& path, std::vector< std::pair< std::string, std::string > > const& vParameters )
+    {
+        std::ofstream ofs( path.c_str() );
+        ofs << "[params]" << std::endl;
+        for ( size_t i = 0 ; i < vParameters.size() ; ++i )
+            ofs << vParameters[i].first << "=" << vParameters[i].second << std::endl;
+        if ( !ofs )
+            IGN_THROW_EXCEPTION( "[ app::calcul::ContextBundle ] unable to write '" + path + "'" );
+    }
+}
+
+namespace calcul{
+
+    ///
+	///
+	///
+    void ContextBundle::Dump(
+        std::string countryCode,
+        std::string const& auId,
+        std::string const& bundleDirectory
+    ) {
+        boost::filesystem::create_directories( bundleDirectory );
+
+        // le contexte est une relance ciblee sur la seule unite administrative
+        std::string const idsPath = bundleDirectory + "/" + detail::BUNDLE_IDS_FILE;
+        std::ofstream ofs( idsPath.c_str() );
+        ofs << auId << std::endl;
+        ofs.close();
+        params::ThemeParametersS::getInstance()->setParameter( AU_TARGET_IDS, ign::data::String( idsPath ) );
+
+        AuMatchingOp op(countryCode, false);
+        _dump(op, bundleDirectory);
+    }
+
+    ///
+	///
+	///
+    void ContextBundle::LoadParameters( std::string const& bundleDirectory )
+    {
+        epg::params::tools::loadParams( *params::ThemeParametersS::getInstance(), bundleDirectory + "/" + detail::BUNDLE_THEME_PARAMETERS_FILE );
+        epg::params::tools::loadParams( epg::ContextS::getInstance()->getEpgParameters(), bundleDirectory + "/" + detail::BUNDLE_EPG_PARAMETERS_FILE );
+    }
+
+    ///
+	///
+	///
+    void ContextBundle::Replay(
+        std::string countryCode,
+        std::string const& bundleDirectory,
+        size_t numLoops
+    ) {
+        params::ThemeParametersS::getInstance()->setParameter( AU_TARGET_IDS, ign::data::String( bundleDirectory + "/" + detail::BUNDLE_IDS_FILE ) );
+
+        AuMatchingOp op(countryCode, false);
+        _replay(op, bundleDirectory, numLoops);
+    }
+
+    ///
+	///
+	///
+    void ContextBundle::_dump( AuMatchingOp & op, std::string const& bundleDirectory )
+    {
+        if ( op._vTargetAu.size() != 1 )
+            IGN_THROW_EXCEPTION( "[ app::calcul::ContextBundle ] object to dump not found" );
+
+        // parametres effectifs lus par le calcul (noms de tables et d'attributs compris :
+        // ils figurent dans les cles de l'enregistrement)
+        epg::params::EpgParameters const& epgParams = epg::ContextS::getInstance()->getEpgParameters();
+        params::ThemeParameters* themeParameters = params::ThemeParametersS::getInstance();
+
+        std::vector< std::pair< std::string, std::string > > vThemeParameters;
+        vThemeParameters.push_back( std::make_pair( "AREA_TABLE_INIT", themeParameters->getValue( AREA_TABLE_INIT ).toString() ) );
+        vThemeParameters.push_back( std::make_pair( "NOCOAST_TABLE", themeParameters->getValue( NOCOAST_TABLE ).toString() ) );
+        vThemeParameters.push_back( std::make_pair( "AU_BOUNDARY_MAX_DIST", themeParameters->getValue( AU_BOUNDARY_MAX_DIST ).toString() ) );
+        vThemeParameters.push_back( std::make_pair( "AU_BOUNDARY_SEARCH_DIST", themeParameters->getValue( AU_BOUNDARY_SEARCH_DIST ).toString() ) );
+        vThemeParameters.push_back( std::make_pair( "AU_BOUNDARY_SNAP_DIST", themeParameters->getValue( AU_BOUNDARY_SNAP_DIST ).toString() ) );
+        vThemeParameters.push_back( std::make_pair( "AU_SEGMENT_MIN_LENGTH", themeParameters->getValue( AU_SEGMENT_MIN_LENGTH ).toString() ) );
+        detail::writeParameters( bundleDirectory + "/" + detail::BUNDLE_THEME_PARAMETERS_FILE, vThemeParameters );
+
+        std::vector< std::pair< std::string, std::string > > vEpgParameters;
+        vEpgParameters.push_back( std::make_pair( "TARGET_BOUNDARY_TABLE", epgParams.getValue( TARGET_BOUNDARY_TABLE ).toString() ) );
+        vEpgParameters.push_back( std::make_pair( "BOUNDARY_TYPE", epgParams.getValue( BOUNDARY_TYPE ).toString() ) );
+        vEpgParameters.push_back( std::make_pair( "TYPE_COASTLINE", epgParams.getValue( TYPE_COASTLINE ).toString() ) );
+        vEpgParameters.push_back( std::make_pair( "ID", epgParams.getValue( ID ).toString() ) );
+        vEpgParameters.push_back( std::make_pair( "COUNTRY_CODE", epgParams.getValue( COUNTRY_CODE ).toString() ) );
+        detail::writeParameters( bundleDirectory + "/" + detail::BUNDLE_EPG_PARAMETERS_FILE, vEpgParameters );
+
+        // calcul complet (toutes les lectures sont enregistrees), sans ecriture
+        op._loadIndexes();
+
+        ign::feature::Feature fAu = op._vTargetAu.front();
+        bool modified = false;
+        op._computeAu(fAu, 0, modified);
+
+        io::FeatureRecordWriter writer( bundleDirectory + "/" + detail::BUNDLE_RESULT_FILE, std::vector< std::string >() );
+        writer.write( fAu );
+
+        op._logAnomalies( "[630] anomalies" );
+        op._logger->log(epg::log::INFO, "[630] context of " + fAu.getId() + " written in " + bundleDirectory + ( modified ? " (modified)" : " (not modified)" ));
+    }
+
+    ///
+	///
+	///
+    void ContextBundle::_replay(
+        AuMatchingOp & op,
+        std::string const& bundleDirectory,
+        size_t numLoops
+    ) {
+        if ( op._vTargetAu.size() != 1 )
+            IGN_THROW_EXCEPTION( "[ app::calcul::ContextBundle ] invalid bundle '" + bundleDirectory + "'" );
+
+        tools::TimeBudget chrono( 0 );
+        op._loadIndexes();
+        double const loadingTime = chrono.elapsed();
+
+        // seule la premiere execution alimente le log et les couches de diagnostic
+        ign::feature::Feature fAu;
+        double minTime = std::numeric_limits<double>::max(), sumTime = 0, maxTime = 0;
+        for ( size_t i = 0 ; i < std::max( numLoops, size_t(1) ) ; ++i ) {
+            if ( i == 1 ) op._disableDiagnostics( true );
+            fAu = op._vTargetAu.front();
+            bool modified = false;
+            chrono.start();
+            op._computeAu(fAu, 0, modified);
+            double const elapsed = chrono.elapsed();
+
+            minTime = std::min( minTime, elapsed );
+            maxTime = std::max( maxTime, elapsed );
+            sumTime += elapsed;
+        }
+        size_t const numRuns = std::max( numLoops, size_t(1) );
+
+        std::ostringstream ss;
+        ss << std::setprecision(6) << "[630] replay of " << fAu.getId() << " : loading " << loadingTime * 1000 << " ms, "
+            << numRuns << " runs, min " << minTime * 1000 << " ms, mean " << sumTime / numRuns * 1000 << " ms, max " << maxTime * 1000 << " ms";
+        op._logger->log(epg::log::INFO, ss.str());
+
+        // comparaison au resultat enregistre
+        io::FeatureRecordReader reader( bundleDirectory + "/" + detail::BUNDLE_RESULT_FILE );
+        ign::feature::Feature fExpected;
+        if ( !reader.next( fExpected ) )
+            IGN_THROW_EXCEPTION( "[ app::calcul::ContextBundle ] empty result in '" + bundleDirectory + "'" );
+
+        std::string wkb, expectedWkb;
+        io::Wkb::Write( fAu.getGeometry(), wkb );
+        io::Wkb::Write( fExpected.getGeometry(), expectedWkb );
+        if ( wkb != expectedWkb )
+            IGN_THROW_EXCEPTION( "[ app::calcul::ContextBundle ] result of " + fAu.getId() + " differs from the one recorded in '" + bundleDirectory + "'" );
+
+        op._logger->log(epg::log::INFO, "[630] replay of " + fAu.getId() + " : result identical to the recorded one");
+    }
+
+}
+}
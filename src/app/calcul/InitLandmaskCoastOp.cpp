@@ -1,6 +1,9 @@
 //APP
 #include <app/calcul/InitLandmaskCoastOp.h>
 #include <app/params/ThemeParameters.h>
+#include <app/io/DataSourceManager.h>
+#include <app/io/GeometryCache.h>
+#include <app/tools/AllocationTracker.h>
 
 //BOOST
 #include <boost/progress.hpp>
@@ -11,10 +14,8 @@
 //EPG
 #include <epg/Context.h>
 #include <epg/params/EpgParameters.h>
-#include <epg/sql/DataBaseManager.h>
 #include <epg/tools/StringTools.h>
 #include <epg/tools/TimeTools.h>
-#include <ome2/feature/sql/NotDestroyedTools.h>
 
 
 namespace app{
@@ -27,6 +28,8 @@ namespace calcul{
         std::string countryCode, 
         bool verbose
     ) {
+        tools::AllocationPhase allocationPhase("[610] total");
+
         InitLandmaskCoastOp InitLandmaskCoastOp(countryCode, verbose);
         InitLandmaskCoastOp._compute();
     }
@@ -56,6 +59,8 @@ namespace calcul{
 	///
     void InitLandmaskCoastOp::_init()
     {
+        tools::AllocationPhase allocationPhase("[610] initialization");
+
         //--
         _logger= epg::log::EpgLoggerS::getInstance();
         _logger->log(epg::log::INFO, "[START] initialization: "+epg::tools::TimeTools::getTime());
@@ -66,23 +71,27 @@ namespace calcul{
         // epg parameters
         epg::params::EpgParameters const& epgParams = context->getEpgParameters();
 
-        std::string const idName = epgParams.getValue( ID ).toString();
-        std::string const geomName = epgParams.getValue( GEOM ).toString();
         std::string const countryCodeName = epgParams.getValue( COUNTRY_CODE ).toString();
 
         // app parameters
         params::ThemeParameters* themeParameters = params::ThemeParametersS::getInstance();
         std::string const landmaskTableName = themeParameters->getValue( LANDMASK_TABLE ).toString();
-        std::string const coastTableName = themeParameters->getValue( COAST_TABLE ).toString();
         
         //--
-        _fsBoundary = context->getFeatureStore( epg::TARGET_BOUNDARY );
+        _dataSource = io::DataSourceManagerS::getInstance()->getDataSource();
         //--
-        _fsLandmask = context->getDataBaseManager().getFeatureStore(landmaskTableName, idName, geomName);
+        _boundaryTableName = epgParams.getValue( TARGET_BOUNDARY_TABLE ).toString();
         //--
-        _fsCoast = context->getDataBaseManager().getFeatureStore(coastTableName, idName, geomName);
+        _coastTableName = themeParameters->getValue( COAST_TABLE ).toString();
         //--
-        _mlsToolLandmask = new epg::tools::MultiLineStringTool( ome2::feature::sql::NotDestroyedTools::GetFeatureFilter(countryCodeName+" = '"+_countryCode+"'", _fsLandmask), *_fsLandmask );
+        io::Query const landmaskQuery = io::Query().equals(countryCodeName, _countryCode);
+        io::GeometryCache geometryCache( themeParameters->getValue( GEOMETRY_CACHE_DIRECTORY ).toString(), "610_" + _countryCode );
+        if ( geometryCache.isEnabled() ) {
+            geometryCache.addSource( *_dataSource, landmaskTableName, landmaskQuery );
+            geometryCache.load();
+        }
+        _mlsToolLandmask = geometryCache.newMultiLineStringTool( "landmask_contours", *_dataSource, landmaskTableName, landmaskQuery );
+        geometryCache.save();
         
         //--
         _shapeLogger = epg::log::ShapeLoggerS::getInstance();
@@ -97,14 +106,13 @@ namespace calcul{
 	///
     void InitLandmaskCoastOp::_compute() const
     {
+        tools::AllocationPhase allocationPhase("[610] computation");
 
         epg::Context* context = epg::ContextS::getInstance();
 
         //epg params
         epg::params::EpgParameters const& epgParams = context->getEpgParameters();
 
-        std::string const idName = epgParams.getValue( ID ).toString();
-        std::string const geomName = epgParams.getValue( GEOM ).toString();
         std::string const countryCodeName = epgParams.getValue( COUNTRY_CODE ).toString();
         std::string const boundaryTypeName = epgParams.getValue( BOUNDARY_TYPE ).toString();
         std::string const typeCostlineValue = epgParams.getValue( TYPE_COASTLINE ).toString();
@@ -117,12 +125,12 @@ namespace calcul{
         double const coastSnapDist = themeParameters->getValue( AU_COAST_SNAP_DIST ).toDouble();
 
         //--
-		ign::feature::FeatureIteratorPtr itCoast = ome2::feature::sql::NotDestroyedTools::GetFeatures(*_fsBoundary, ign::feature::FeatureFilter(countryCodeName + " LIKE '%" + _countryCode + "%' AND " + boundaryTypeName + "::text LIKE '%" + typeCostlineValue + "%'"));
+		io::FeatureCursorPtr itCoast = _dataSource->getFeatures(_boundaryTableName, io::Query().containsCode(countryCodeName, _countryCode).contains(boundaryTypeName, typeCostlineValue));
 
 		ign::geometry::algorithm::LineMergerOpGeos merger;
-        while (itCoast->hasNext())
+        ign::feature::Feature fCoast;
+        while (itCoast->next(fCoast))
         {
-            ign::feature::Feature fCoast = itCoast->next();
             ign::geometry::LineString const& lsCoast = fCoast.getGeometry().asLineString();
             std::string icc = fCoast.getAttribute( countryCodeName ).toString();
             std::string boundType = fCoast.getAttribute( boundaryTypeName ).toString();
@@ -190,10 +198,10 @@ namespace calcul{
                 _logger->log(epg::log::DEBUG, pathFound.second.startPoint().toString());
                 _logger->log(epg::log::DEBUG, pathFound.second.endPoint().toString());
 
-                ign::feature::Feature feat = _fsCoast->newFeature();
+                ign::feature::Feature feat = _dataSource->newFeature( _coastTableName );
                 feat.setGeometry( pathFound.second );
                 feat.setAttribute( countryCodeName, ign::data::String(_countryCode) );
-                _fsCoast->createFeature( feat );
+                _dataSource->createFeature( _coastTableName, feat );
             }
         }
     };
@@ -4,6 +4,8 @@
 #include <app/detail/extractNotTouchingParts.h>
 #include <app/detail/getSubString.h>
 #include <app/detail/refining.h>
+#include <app/io/DataSourceManager.h>
+#include <app/tools/AllocationTracker.h>
 
 //BOOST
 #include <boost/progress.hpp>
@@ -11,10 +13,8 @@
 //EPG
 #include <epg/Context.h>
 #include <epg/params/EpgParameters.h>
-#include <epg/sql/DataBaseManager.h>
 #include <epg/tools/StringTools.h>
 #include <epg/tools/TimeTools.h>
-#include <ome2/feature/sql/NotDestroyedTools.h>
 
 
 namespace app{
@@ -27,6 +27,8 @@ namespace calcul{
         std::string countryCode, 
         bool verbose) 
     {
+        tools::AllocationPhase allocationPhase("[620] total");
+
         InitLandmaskNoCoastOp InitLandmaskNoCoastOp(countryCode, verbose);
         InitLandmaskNoCoastOp._compute();
     }
@@ -53,32 +55,23 @@ namespace calcul{
 	///
     void InitLandmaskNoCoastOp::_init() 
     {
+        tools::AllocationPhase allocationPhase("[620] initialization");
+
         //--
         _logger= epg::log::EpgLoggerS::getInstance();
         _logger->log(epg::log::INFO, "[START] initialization: "+epg::tools::TimeTools::getTime());
 
-        //--
-        epg::Context* context = epg::ContextS::getInstance();
-
-        // epg parameters
-        epg::params::EpgParameters const& epgParams = context->getEpgParameters();
-
-        std::string const idName = epgParams.getValue( ID ).toString();
-        std::string const geomName = epgParams.getValue( GEOM ).toString();
-        std::string const countryCodeName = epgParams.getValue( COUNTRY_CODE ).toString();
-
         // app parameters
         params::ThemeParameters* themeParameters = params::ThemeParametersS::getInstance();
-        std::string const landmaskTableName = themeParameters->getValue( LANDMASK_TABLE ).toString();
-        std::string const coastTableName = themeParameters->getValue( COAST_TABLE ).toString();
-        std::string const nocoastTableName = themeParameters->getValue( NOCOAST_TABLE ).toString();
         
         //--
-        _fsLandmask = context->getDataBaseManager().getFeatureStore(landmaskTableName, idName, geomName);
+        _dataSource = io::DataSourceManagerS::getInstance()->getDataSource();
+        //--
+        _landmaskTableName = themeParameters->getValue( LANDMASK_TABLE ).toString();
         //--
-        _fsCoast = context->getDataBaseManager().getFeatureStore(coastTableName, idName, geomName);
+        _coastTableName = themeParameters->getValue( COAST_TABLE ).toString();
         //--
-        _fsNoCoast = context->getDataBaseManager().getFeatureStore(nocoastTableName, idName, geomName);
+        _noCoastTableName = themeParameters->getValue( NOCOAST_TABLE ).toString();
         
         //--
         _logger->log(epg::log::INFO, "[END] initialization: "+epg::tools::TimeTools::getTime());
@@ -89,14 +82,13 @@ namespace calcul{
 	///
     void InitLandmaskNoCoastOp::_compute() 
     {
+        tools::AllocationPhase allocationPhase("[620] computation");
 
         epg::Context* context = epg::ContextS::getInstance();
 
         //epg params
         epg::params::EpgParameters const& epgParams = context->getEpgParameters();
         
-        std::string const idName = epgParams.getValue( ID ).toString();
-        std::string const geomName = epgParams.getValue( GEOM ).toString();
         std::string const countryCodeName = epgParams.getValue( COUNTRY_CODE ).toString();
 
         //app params
@@ -107,10 +99,10 @@ namespace calcul{
 
         //--
         ign::geometry::MultiPolygon mpLandmask;
-		ign::feature::FeatureIteratorPtr itLandmask = ome2::feature::sql::NotDestroyedTools::GetFeatures(*_fsLandmask, ign::feature::FeatureFilter(landCoverTypeName + " = '" + landAreaValue + "' AND " + countryCodeName + " = '" + _countryCode + "'"));
-		while (itLandmask->hasNext())
+		io::FeatureCursorPtr itLandmask = _dataSource->getFeatures(_landmaskTableName, io::Query().equals(landCoverTypeName, landAreaValue).equals(countryCodeName, _countryCode));
+        ign::feature::Feature fLandmask;
+		while (itLandmask->next(fLandmask))
         {
-            ign::feature::Feature fLandmask = itLandmask->next();
             ign::geometry::MultiPolygon const& mp = fLandmask.getGeometry().asMultiPolygon();
             for ( int i = 0 ; i < mp.numGeometries() ; ++i ) {
                 mpLandmask.addGeometry(mp.polygonN(i));
@@ -119,9 +111,9 @@ namespace calcul{
 
         //--
         ign::geometry::MultiLineString mlsLandmaskCoastPath;
-        ign::feature::FeatureIteratorPtr itCoast = ome2::feature::sql::NotDestroyedTools::GetFeatures(*_fsCoast, ign::feature::FeatureFilter(countryCodeName+" LIKE '%"+_countryCode+"%'"));
-        while (itCoast->hasNext()) {
-             ign::feature::Feature fCoast = itCoast->next();
+        io::FeatureCursorPtr itCoast = _dataSource->getFeatures(_coastTableName, io::Query().containsCode(countryCodeName, _countryCode));
+        ign::feature::Feature fCoast;
+        while (itCoast->next(fCoast)) {
              ign::geometry::LineString const& lsCoast = fCoast.getGeometry().asLineString();
              mlsLandmaskCoastPath.addGeometry(lsCoast);
         }
@@ -151,10 +143,10 @@ namespace calcul{
         for ( int np = 0 ; np < vLandmaskNoCoasts.size() ; ++np ) {
             for ( int nr = 0 ; nr < vLandmaskNoCoasts[np].size() ; ++nr ) {
                 for ( int i = 0 ; i < vLandmaskNoCoasts[np][nr].size() ; ++i, ++display ) {
-                    ign::feature::Feature fNoCoast = _fsNoCoast->newFeature();
+                    ign::feature::Feature fNoCoast = _dataSource->newFeature(_noCoastTableName);
                     fNoCoast.setGeometry(detail::getSubString(vLandmaskNoCoasts[np][nr][i], mpLandmask.polygonN(np).ringN(nr)));
                     fNoCoast.setAttribute(countryCodeName,ign::data::String(_countryCode));
-                    _fsNoCoast->createFeature(fNoCoast);
+                    _dataSource->createFeature(_noCoastTableName, fNoCoast);
                 }
             }
         }
@@ -0,0 +1,39 @@
+// APP
+#include <app/detail/addContours.h>
+
+// SOCLE
+#include <ign/Exception.h>
+
+
+namespace app{
+namespace detail{
+
+    ///
+	///
+	///
+    void addContours( ign::geometry::Geometry const& geom, ign::geometry::MultiLineString & mls )
+    {
+        switch( geom.getGeometryType() )
+        {
+        case ign::geometry::Geometry::GeometryTypeLineString :
+            mls.addGeometry( geom.asLineString() );
+            break;
+        case ign::geometry::Geometry::GeometryTypeMultiLineString :
+            for ( size_t i = 0 ; i < geom.asMultiLineString().numGeometries() ; ++i )
+                mls.addGeometry( geom.asMultiLineString().lineStringN(i) );
+            break;
+        case ign::geometry::Geometry::GeometryTypePolygon :
+            for ( size_t i = 0 ; i < geom.asPolygon().numRings() ; ++i )
+                mls.addGeometry( geom.asPolygon().ringN(i) );
+            break;
+        case ign::geometry::Geometry::GeometryTypeMultiPolygon :
+            for ( size_t i = 0 ; i < geom.asMultiPolygon().numGeometries() ; ++i )
+                addContours( geom.asMultiPolygon().polygonN(i), mls );
+            break;
+        default :
+            IGN_THROW_EXCEPTION( "[ app::detail::addContours ] Geometry type '"+ign::geometry::Geometry::GeometryTypeName(geom.getGeometryType())+"' not allowed." );
+        }
+    }
+
+}
+}
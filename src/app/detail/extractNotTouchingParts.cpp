@@ -8,31 +8,37 @@ namespace detail{
     ///
 	///
 	///
-    void extractNotTouchingParts(
+    bool extractNotTouchingParts(
         const tools::SegmentIndexedGeometryInterface* refGeom,
         const ign::geometry::LineString & ls, 
-        std::vector<std::pair<int,int>> & vNotTouchingParts,
-        std::vector<int>* vTouchingPoints
+        std::pmr::vector<std::pair<int,int>> & vNotTouchingParts,
+        std::pmr::vector<int>* vTouchingPoints,
+        tools::TimeBudget const* budget
     ) {
+        std::pmr::memory_resource* resource = vNotTouchingParts.get_allocator().resource();
+
         bool isRing = ls.isClosed();
         int nbSegments = ls.numSegments();
         int nbPoints = ls.numPoints();
 
-        std::vector < bool > vIsTouchingPoints(nbPoints, false);
-        std::vector < std::set<int> > vGroup(nbPoints, std::set<int>());
+        std::pmr::vector < bool > vIsTouchingPoints(nbPoints, false, resource);
+        std::pmr::vector < std::pmr::set<int> > vGroup(nbPoints, resource);
         for ( int k = 0 ; k < nbPoints ; ++k ) {
+            // interruption cooperative tous les 256 sommets
+            if ( budget && ( k & 255 ) == 255 && budget->isExceeded() ) return false;
+
             std::pair<double, std::set<int>> distGroup = refGeom->distance( ls.pointN(k), 0.1 );
             if ( distGroup.first < 0 ) {
                 continue;
             }
             vIsTouchingPoints[k] = true;
-            vGroup[k] = distGroup.second;
+            vGroup[k].insert(distGroup.second.begin(), distGroup.second.end());
         }
 
         int notTouchingFirstSegment = -1;
         bool bNothingIsTouching = true;
         bool previousSegmentIsTouching = !isRing ? false : vIsTouchingPoints[nbSegments-1] && vIsTouchingPoints[nbSegments] && commonGroupExists(vGroup[nbSegments-1], vGroup[nbSegments]) ;
-        std::vector < bool > vTouchingSegments(nbSegments, false);
+        std::pmr::vector < bool > vTouchingSegments(nbSegments, false, resource);
         for ( int currentSegment = 0 ; currentSegment < nbSegments ; ++currentSegment )
         {
             bool currentSegmentIsTouching = vIsTouchingPoints[currentSegment] && vIsTouchingPoints[currentSegment+1] && commonGroupExists(vGroup[currentSegment], vGroup[currentSegment+1]);
@@ -53,7 +59,7 @@ namespace detail{
 
         if (bNothingIsTouching) {
             vNotTouchingParts.push_back(std::make_pair(0, nbSegments));
-            return;
+            return true;
         }
 
         if (notTouchingFirstSegment >= 0) {
@@ -79,6 +85,7 @@ namespace detail{
                 currentSegment = next;
             } while ( currentSegment != end );
         }
+        return true;
     };
 
     ///
@@ -92,14 +99,13 @@ namespace detail{
     ) {
         for (int i = 0 ; i < p.numRings() ; ++i)
         {
-            vNotTouchingParts.push_back(std::vector<std::pair<int,int>>());
-            std::vector<int>* vTouchingPoints_ = 0;
+            std::pmr::vector<std::pair<int,int>> vRingNotTouchingParts;
+            std::pmr::vector<int> vRingTouchingPoints;
+            extractNotTouchingParts(refGeom, p.ringN(i), vRingNotTouchingParts, vTouchingPoints ? &vRingTouchingPoints : 0);
+
+            vNotTouchingParts.push_back(std::vector<std::pair<int,int>>(vRingNotTouchingParts.begin(), vRingNotTouchingParts.end()));
             if (vTouchingPoints)
-            {
-                vTouchingPoints->push_back(std::vector<int>());
-                vTouchingPoints_ =  &vTouchingPoints->back();
-            }
-            extractNotTouchingParts(refGeom, p.ringN(i), vNotTouchingParts.back(), vTouchingPoints_);
+                vTouchingPoints->push_back(std::vector<int>(vRingTouchingPoints.begin(), vRingTouchingPoints.end()));
         }
     };
 
@@ -128,11 +134,11 @@ namespace detail{
     ///
     ///
     ///
-    bool commonGroupExists( std::set<int> const& sGroup1, std::set<int> const& sGroup2 ) 
+    bool commonGroupExists( std::pmr::set<int> const& sGroup1, std::pmr::set<int> const& sGroup2 ) 
     {
         if (sGroup1.empty() && sGroup2.empty()) return true;
 
-        for ( std::set<int>::const_iterator sit1 = sGroup1.begin() ; sit1 != sGroup1.end() ; ++sit1 ) {
+        for ( std::pmr::set<int>::const_iterator sit1 = sGroup1.begin() ; sit1 != sGroup1.end() ; ++sit1 ) {
             if( sGroup2.find(*sit1) != sGroup2.end() ) return true;
         }
         return false;
@@ -0,0 +1,79 @@
+// APP
+#include <app/detail/getNoCoastEnvelopes.h>
+
+//STL
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
+
+
+namespace app{
+namespace detail{
+    ///
+	///
+	///
+    std::vector< ign::geometry::Envelope > getNoCoastEnvelopes(
+        ign::geometry::MultiLineString const& mLsNoCoasts,
+        double distance,
+        size_t maxEnvelopes
+    ) {
+        std::vector< ign::geometry::Envelope > vEnvelopes;
+        for ( size_t i = 0 ; i < mLsNoCoasts.numGeometries() ; ++i ) {
+            ign::geometry::Envelope envelope = mLsNoCoasts.lineStringN(i).getEnvelope();
+            vEnvelopes.push_back( envelope.expandBy( distance ) );
+        }
+        if ( vEnvelopes.size() <= maxEnvelopes ) return vEnvelopes;
+
+        double xmin = vEnvelopes.front().xmin(), ymin = vEnvelopes.front().ymin();
+        double xmax = vEnvelopes.front().xmax(), ymax = vEnvelopes.front().ymax();
+        for ( size_t i = 1 ; i < vEnvelopes.size() ; ++i ) {
+            xmin = std::min( xmin, vEnvelopes[i].xmin() );
+            ymin = std::min( ymin, vEnvelopes[i].ymin() );
+            xmax = std::max( xmax, vEnvelopes[i].xmax() );
+            ymax = std::max( ymax, vEnvelopes[i].ymax() );
+        }
+
+        // les emprises fusionnees portent sur les segments et non sur les portions
+        // entieres : une longue portion n'etend pas l'emprise de chaque maille qu'elle
+        // traverse a sa propre emprise. Chaque segment est rattache a la maille
+        // contenant son milieu.
+        size_t const gridSize = std::max( static_cast< size_t >( std::sqrt( double( maxEnvelopes ) ) ), size_t(1) );
+        double const cellWidth = std::max( ( xmax - xmin ) / gridSize, std::numeric_limits< double >::min() );
+        double const cellHeight = std::max( ( ymax - ymin ) / gridSize, std::numeric_limits< double >::min() );
+
+        std::map< size_t, std::vector< double > > mCells;
+        for ( size_t i = 0 ; i < mLsNoCoasts.numGeometries() ; ++i ) {
+            ign::geometry::LineString const& ls = mLsNoCoasts.lineStringN(i);
+            for ( size_t j = 0 ; j < ls.numPoints() ; ++j ) {
+                // un point isole (portion d'un seul point) est traite comme un segment nul
+                if ( j+1 == ls.numPoints() && j > 0 ) break;
+                ign::geometry::Point const& p1 = ls.pointN(j);
+                ign::geometry::Point const& p2 = ls.pointN( std::min( j+1, ls.numPoints()-1 ) );
+
+                double const bounds[] = {
+                    std::min( p1.x(), p2.x() ) - distance, std::min( p1.y(), p2.y() ) - distance,
+                    std::max( p1.x(), p2.x() ) + distance, std::max( p1.y(), p2.y() ) + distance
+                };
+                size_t const col = std::min( static_cast< size_t >( ( 0.5 * ( bounds[0] + bounds[2] ) - xmin ) / cellWidth ), gridSize - 1 );
+                size_t const row = std::min( static_cast< size_t >( ( 0.5 * ( bounds[1] + bounds[3] ) - ymin ) / cellHeight ), gridSize - 1 );
+
+                std::map< size_t, std::vector< double > >::iterator mit = mCells.find( row * gridSize + col );
+                if ( mit == mCells.end() ) {
+                    mCells.insert( std::make_pair( row * gridSize + col, std::vector< double >( bounds, bounds + 4 ) ) );
+                    continue;
+                }
+                mit->second[0] = std::min( mit->second[0], bounds[0] );
+                mit->second[1] = std::min( mit->second[1], bounds[1] );
+                mit->second[2] = std::max( mit->second[2], bounds[2] );
+                mit->second[3] = std::max( mit->second[3], bounds[3] );
+            }
+        }
+
+        std::vector< ign::geometry::Envelope > vMerged;
+        for ( std::map< size_t, std::vector< double > >::const_iterator mit = mCells.begin() ; mit != mCells.end() ; ++mit )
+            vMerged.push_back( ign::geometry::Envelope( ign::geometry::Point( mit->second[0], mit->second[1] ), ign::geometry::Point( mit->second[2], mit->second[3] ) ) );
+        return vMerged;
+    }
+}
+}
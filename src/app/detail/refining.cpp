@@ -13,7 +13,8 @@ namespace detail{
     void refineAreaWithLsEndings(
         ign::geometry::MultiLineString const& mls,
         ign::geometry::MultiPolygon & mp,
-        double precision
+        double precision,
+        std::vector< RefinedVertex >* vRefined
     ) {
         for ( size_t i = 0 ; i < mls.numGeometries() ; ++i ) {
             ign::geometry::LineString const& ls = mls.lineStringN(i);
@@ -31,7 +32,11 @@ namespace detail{
                 for( size_t np = 0 ; np < mp.numGeometries() ; ++np ) {
                     for( size_t nr = 0 ; nr < mp.polygonN(np).numRings() ; ++nr ) {
                         if( mp.polygonN(np).ringN(nr).distance(vEndings[ne]) < precision) {
-                            refine(mp.polygonN(np).ringN(nr), vEndings[ne], precision);
+                            int const index = refine(mp.polygonN(np).ringN(nr), vEndings[ne], precision);
+                            if( vRefined && index >= 0 ) {
+                                RefinedVertex const refined = { np, nr, static_cast<size_t>(index) };
+                                vRefined->push_back(refined);
+                            }
                             foundTouchingRing = true;
                             break;
                         }
@@ -46,7 +51,21 @@ namespace detail{
     ///
 	///
 	///
-    void refine(
+    void unrefineArea(
+        ign::geometry::MultiPolygon & mp,
+        std::vector< RefinedVertex > const& vRefined
+    ) {
+        // ordre inverse : chaque suppression retablit le contour precedant l'insertion
+        for ( size_t i = vRefined.size() ; i > 0 ; --i ) {
+            RefinedVertex const& refined = vRefined[i-1];
+            mp.polygonN(refined.polygon).ringN(refined.ring).removePointN(refined.index);
+        }
+    };
+
+    ///
+	///
+	///
+    int refine(
         ign::geometry::LineString & ls,
         ign::geometry::Point const& point,
         double precision
@@ -58,10 +77,12 @@ namespace detail{
             if( currentLine.distance2(refPoint, true) < precision2 ) {
                 if( !refPoint.distance2(ls.pointN(ns).toVec2d()) < precision2 && !refPoint.distance2(ls.pointN(ns+1).toVec2d()) < precision2 ) {
                     ls.addPoint(point, ns+1);
+                    return static_cast<int>(ns+1);
                 }
-                return;
+                return -1;
             }
         }
+        return -1;
     };
 
 }
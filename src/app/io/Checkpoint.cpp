@@ -0,0 +1,134 @@
+// APP
+#include <app/io/Checkpoint.h>
+
+// STL
+#include <fstream>
+
+// SOCLE
+#include <ign/Exception.h>
+
+// BOOST
+#include <boost/filesystem.hpp>
+
+
+namespace app{
+namespace io{
+
+    ///
+	///
+	///
+    Checkpoint::Checkpoint(
+        std::string const& path,
+        std::string const& key
+    ):
+        _path( path ),
+        _key( key )
+    {
+    }
+
+    ///
+	///
+	///
+    bool Checkpoint::Exists(
+        std::string const& path,
+        std::string const& key
+    ) {
+        if ( path.empty() ) return false;
+
+        std::ifstream ifs( path.c_str() );
+        std::string header;
+        return ifs && std::getline( ifs, header ) && header == Checkpoint( path, key )._header();
+    }
+
+    ///
+	///
+	///
+    bool Checkpoint::load()
+    {
+        _sIds.clear();
+        _vPendingIds.clear();
+        if ( !Exists( _path, _key ) ) return false;
+
+        std::ifstream ifs( _path.c_str() );
+        std::string line;
+        std::getline( ifs, line );
+        while ( std::getline( ifs, line ) ) {
+            // ligne sans fin de ligne : ecriture interrompue
+            if ( ifs.eof() ) break;
+            if ( !line.empty() ) _sIds.insert( line );
+        }
+        return true;
+    }
+
+    ///
+	///
+	///
+    void Checkpoint::reset()
+    {
+        _sIds.clear();
+        _vPendingIds.clear();
+        if ( !isEnabled() ) return;
+
+        boost::filesystem::path const parent = boost::filesystem::path( _path ).parent_path();
+        if ( !parent.empty() ) boost::filesystem::create_directories( parent );
+
+        std::ofstream ofs( _path.c_str(), std::ios::trunc );
+        ofs << _header() << "\n";
+        if ( !ofs )
+            IGN_THROW_EXCEPTION( "[ app::io::Checkpoint ] unable to write '" + _path + "'" );
+    }
+
+    ///
+	///
+	///
+    void Checkpoint::add( std::string const& id )
+    {
+        if ( !isEnabled() ) return;
+        _vPendingIds.push_back( id );
+    }
+
+    ///
+	///
+	///
+    void Checkpoint::save()
+    {
+        if ( !isEnabled() || _vPendingIds.empty() ) return;
+
+        std::string buffer;
+        for ( size_t i = 0 ; i < _vPendingIds.size() ; ++i ) {
+            buffer += _vPendingIds[i];
+            buffer += "\n";
+            _sIds.insert( _vPendingIds[i] );
+        }
+        _vPendingIds.clear();
+
+        std::ofstream ofs( _path.c_str(), std::ios::app );
+        ofs.write( buffer.data(), buffer.size() );
+        ofs.flush();
+        if ( !ofs )
+            IGN_THROW_EXCEPTION( "[ app::io::Checkpoint ] unable to write '" + _path + "'" );
+    }
+
+    ///
+	///
+	///
+    void Checkpoint::remove()
+    {
+        _sIds.clear();
+        _vPendingIds.clear();
+        if ( !isEnabled() ) return;
+
+        boost::system::error_code ec;
+        boost::filesystem::remove( _path, ec );
+    }
+
+    ///
+	///
+	///
+    std::string Checkpoint::_header() const
+    {
+        return "AUCP 1 " + _key;
+    }
+
+}
+}
@@ -0,0 +1,39 @@
+// APP
+#include <app/io/DataSource.h>
+#include <app/io/Wkb.h>
+#include <app/tools/Hash64.h>
+
+// STL
+#include <sstream>
+
+
+namespace app{
+namespace io{
+
+    ///
+	///
+	///
+    std::string DataSource::checksum(
+        std::string const& table,
+        Query const& query
+    ) {
+        tools::Hash64 hash;
+        size_t count = 0;
+
+        std::string wkb;
+        FeatureCursorPtr cursor = getFeatures( table, query );
+        ign::feature::Feature feature;
+        while ( cursor->next( feature ) ) {
+            wkb.clear();
+            Wkb::Write( feature.getGeometry(), wkb );
+            hash.add( wkb );
+            ++count;
+        }
+
+        std::ostringstream ss;
+        ss << count << ":" << hash.toString();
+        return ss.str();
+    }
+
+}
+}
@@ -0,0 +1,67 @@
+// APP
+#include <app/io/DataSourceManager.h>
+#include <app/io/GeoPackageDataSource.h>
+#include <app/io/PostgisDataSource.h>
+#include <app/params/ThemeParameters.h>
+
+// SOCLE
+#include <ign/Exception.h>
+
+
+namespace app{
+namespace io{
+
+    ///
+	///
+	///
+    DataSourceManager::DataSourceManager():
+        _dataSource( 0 )
+    {
+    }
+
+    ///
+	///
+	///
+    DataSourceManager::~DataSourceManager()
+    {
+        delete _dataSource;
+    }
+
+    ///
+	///
+	///
+    DataSource* DataSourceManager::getDataSource()
+    {
+        if ( _dataSource == 0 ) _dataSource = NewDataSource();
+        return _dataSource;
+    }
+
+    ///
+	///
+	///
+    void DataSourceManager::setDataSource( DataSource* dataSource )
+    {
+        if ( dataSource == _dataSource ) return;
+        delete _dataSource;
+        _dataSource = dataSource;
+    }
+
+    ///
+	///
+	///
+    DataSource* DataSourceManager::NewDataSource()
+    {
+        app::params::ThemeParameters* themeParameters = app::params::ThemeParametersS::getInstance();
+        std::string const type = themeParameters->getValue( DATA_SOURCE ).toString();
+
+        if ( type.empty() || type == "postgis" )
+            return new PostgisDataSource();
+        if ( type == "gpkg" )
+            return new GeoPackageDataSource( themeParameters->getValue( DATA_SOURCE_FILE ).toString() );
+
+        IGN_THROW_EXCEPTION( "[ app::io::DataSourceManager ] unknown DATA_SOURCE '" + type + "' (expected postgis or gpkg)" );
+        return 0;
+    }
+
+}
+}
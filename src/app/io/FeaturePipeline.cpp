@@ -0,0 +1,162 @@
+// APP
+#include <app/io/FeaturePipeline.h>
+#include <app/io/HilbertOrderedCursor.h>
+
+
+namespace app{
+namespace io{
+
+    ///
+	///
+	///
+    FeaturePipeline::FeaturePipeline(
+        DataSource* dataSource,
+        std::string const& table,
+        Query const& query,
+        size_t queueSize,
+        bool spatialOrder
+    ):
+        _dataSource( dataSource ),
+        _table( table ),
+        _cursor( dataSource->getFeatures( table, query ) ),
+        _threaded( queueSize > 0 ),
+        _readQueue( queueSize ),
+        _writeQueue( queueSize ),
+        _numWritten( 0 ),
+        _numStored( 0 )
+    {
+        // le tri (lecture de l'ensemble des objets) est realise par le thread de lecture
+        if ( spatialOrder ) _cursor.reset( new HilbertOrderedCursor( std::move( _cursor ) ) );
+
+        if ( !_threaded ) return;
+
+        _reader = std::thread( &FeaturePipeline::_read, this );
+        _writer = std::thread( &FeaturePipeline::_write, this );
+    }
+
+    ///
+	///
+	///
+    FeaturePipeline::~FeaturePipeline()
+    {
+        _stop();
+    }
+
+    ///
+	///
+	///
+    bool FeaturePipeline::next( ign::feature::Feature & feature )
+    {
+        if ( !_threaded ) return _cursor->next( feature );
+
+        if ( _readQueue.pop( feature ) ) return true;
+
+        // fin de lecture : normale ou sur erreur
+        if ( _reader.joinable() ) _reader.join();
+        if ( _readerError ) std::rethrow_exception( _readerError );
+        return false;
+    }
+
+    ///
+	///
+	///
+    void FeaturePipeline::write( ign::feature::Feature const& feature )
+    {
+        ++_numWritten;
+        if ( !_threaded ) {
+            _dataSource->modifyFeature( _table, feature );
+            return;
+        }
+
+        if ( !_writeQueue.push( feature ) ) {
+            // l'ecrivain s'est arrete sur erreur
+            if ( _writer.joinable() ) _writer.join();
+            if ( _writerError ) std::rethrow_exception( _writerError );
+        }
+    }
+
+    ///
+	///
+	///
+    void FeaturePipeline::commit()
+    {
+        if ( _threaded ) {
+            std::unique_lock< std::mutex > lock( _storedMutex );
+            _stored.wait( lock, [this]{ return _writerError || _numStored == _numWritten; } );
+            if ( _writerError ) std::rethrow_exception( _writerError );
+        }
+
+        std::lock_guard< std::mutex > lock( _dataSourceMutex );
+        _dataSource->commit();
+    }
+
+    ///
+	///
+	///
+    void FeaturePipeline::finish()
+    {
+        if ( !_threaded ) return;
+
+        _writeQueue.close();
+        if ( _writer.joinable() ) _writer.join();
+        if ( _writerError ) std::rethrow_exception( _writerError );
+    }
+
+    ///
+	///
+	///
+    void FeaturePipeline::_read()
+    {
+        try {
+            ign::feature::Feature feature;
+            while ( true ) {
+                {
+                    std::lock_guard< std::mutex > lock( _dataSourceMutex );
+                    if ( !_cursor->next( feature ) ) break;
+                }
+                if ( !_readQueue.push( feature ) ) break;
+            }
+        } catch ( ... ) {
+            _readerError = std::current_exception();
+        }
+        _readQueue.close();
+    }
+
+    ///
+	///
+	///
+    void FeaturePipeline::_write()
+    {
+        try {
+            std::vector< ign::feature::Feature > vFeatures;
+            while ( _writeQueue.popAll( vFeatures ) ) {
+                std::lock_guard< std::mutex > lock( _dataSourceMutex );
+                for ( size_t i = 0 ; i < vFeatures.size() ; ++i )
+                    _dataSource->modifyFeature( _table, vFeatures[i] );
+
+                std::lock_guard< std::mutex > storedLock( _storedMutex );
+                _numStored += vFeatures.size();
+                _stored.notify_all();
+                vFeatures.clear();
+            }
+        } catch ( ... ) {
+            std::lock_guard< std::mutex > storedLock( _storedMutex );
+            _writerError = std::current_exception();
+            _stored.notify_all();
+        }
+        _writeQueue.close();
+    }
+
+    ///
+	///
+	///
+    void FeaturePipeline::_stop()
+    {
+        _readQueue.close();
+        _writeQueue.close();
+        if ( _reader.joinable() ) _reader.join();
+        if ( _writer.joinable() ) _writer.join();
+    }
+
+}
+}
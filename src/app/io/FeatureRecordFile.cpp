@@ -0,0 +1,179 @@
+// APP
+#include <app/io/FeatureRecordFile.h>
+#include <app/io/Wkb.h>
+
+// STL
+#include <cstdint>
+#include <memory>
+
+// SOCLE
+#include <ign/Exception.h>
+
+
+namespace app{
+namespace io{
+namespace detail{
+
+    //--
+    const char RECORD_MAGIC[4] = { 'A', 'U', 'F', 'R' };
+
+    //--
+    const uint32_t RECORD_VERSION = 1;
+
+    //--
+    void appendUInt32( uint32_t value, std::string & buffer )
+    {
+        char bytes[4];
+        for ( size_t i = 0 ; i < 4 ; ++i ) bytes[i] = static_cast< char >( ( value >> ( 8 * i ) ) & 0xFF );
+        buffer.append( bytes, 4 );
+    }
+
+    //--
+    void appendString( std::string const& value, std::string & buffer )
+    {
+        appendUInt32( static_cast< uint32_t >( value.size() ), buffer );
+        buffer.append( value );
+    }
+}
+
+    ///
+	///
+	///
+    FeatureRecordWriter::FeatureRecordWriter(
+        std::string const& path,
+        std::vector< std::string > const& vAttributes
+    ):
+        _ofs( path.c_str(), std::ios::binary | std::ios::trunc ),
+        _vAttributes( vAttributes ),
+        _numFeatures( 0 )
+    {
+        if ( !_ofs )
+            IGN_THROW_EXCEPTION( "[ app::io::FeatureRecordWriter ] unable to create '" + path + "'" );
+
+        _buffer.append( detail::RECORD_MAGIC, 4 );
+        detail::appendUInt32( detail::RECORD_VERSION, _buffer );
+        _ofs.write( _buffer.data(), _buffer.size() );
+    }
+
+    ///
+	///
+	///
+    FeatureRecordWriter::~FeatureRecordWriter()
+    {
+        _ofs.close();
+    }
+
+    ///
+	///
+	///
+    void FeatureRecordWriter::write( ign::feature::Feature const& feature )
+    {
+        _buffer.clear();
+        detail::appendString( feature.getId(), _buffer );
+
+        // les attributs absents de l'objet ne sont pas enregistres
+        std::vector< std::pair< std::string const*, std::string > > vValues;
+        for ( size_t i = 0 ; i < _vAttributes.size() ; ++i ) {
+            try {
+                vValues.push_back( std::make_pair( &_vAttributes[i], feature.getAttribute( _vAttributes[i] ).toString() ) );
+            } catch ( ... ) {}
+        }
+        detail::appendUInt32( static_cast< uint32_t >( vValues.size() ), _buffer );
+        for ( size_t i = 0 ; i < vValues.size() ; ++i ) {
+            detail::appendString( *vValues[i].first, _buffer );
+            detail::appendString( vValues[i].second, _buffer );
+        }
+
+        size_t const sizePos = _buffer.size();
+        detail::appendUInt32( 0, _buffer );
+        Wkb::Write( feature.getGeometry(), _buffer );
+        uint32_t const wkbSize = static_cast< uint32_t >( _buffer.size() - sizePos - 4 );
+        for ( size_t i = 0 ; i < 4 ; ++i ) _buffer[sizePos+i] = static_cast< char >( ( wkbSize >> ( 8 * i ) ) & 0xFF );
+
+        _ofs.write( _buffer.data(), _buffer.size() );
+        ++_numFeatures;
+    }
+
+    ///
+	///
+	///
+    FeatureRecordReader::FeatureRecordReader( std::string const& path ):
+        _path( path ),
+        _data( 0 ),
+        _size( 0 ),
+        _pos( 0 )
+    {
+        try {
+            _mapping = boost::interprocess::file_mapping( path.c_str(), boost::interprocess::read_only );
+            _region = boost::interprocess::mapped_region( _mapping, boost::interprocess::read_only );
+        } catch ( boost::interprocess::interprocess_exception const& e ) {
+            IGN_THROW_EXCEPTION( "[ app::io::FeatureRecordReader ] unable to map '" + path + "' : " + e.what() );
+        }
+        _region.advise( boost::interprocess::mapped_region::advice_sequential );
+
+        _data = static_cast< unsigned char const* >( _region.get_address() );
+        _size = _region.get_size();
+
+        if ( _size < 8 || std::string( reinterpret_cast< char const* >( _data ), 4 ) != std::string( detail::RECORD_MAGIC, 4 ) )
+            IGN_THROW_EXCEPTION( "[ app::io::FeatureRecordReader ] '" + path + "' is not a record file" );
+        _pos = 4;
+        if ( _readUInt32() != detail::RECORD_VERSION )
+            IGN_THROW_EXCEPTION( "[ app::io::FeatureRecordReader ] unsupported version in '" + path + "'" );
+    }
+
+    ///
+	///
+	///
+    bool FeatureRecordReader::next( ign::feature::Feature & feature )
+    {
+        if ( _pos >= _size ) return false;
+
+        feature = ign::feature::Feature();
+        feature.setId( _readString() );
+
+        uint32_t const numAttributes = _readUInt32();
+        for ( uint32_t i = 0 ; i < numAttributes ; ++i ) {
+            std::string const name = _readString();
+            feature.setAttribute( name, ign::data::String( _readString() ) );
+        }
+
+        uint32_t const wkbSize = _readUInt32();
+        if ( _pos + wkbSize > _size )
+            IGN_THROW_EXCEPTION( "[ app::io::FeatureRecordReader ] truncated record in '" + _path + "'" );
+        std::unique_ptr< ign::geometry::Geometry > geom( Wkb::Read( _data + _pos, wkbSize ) );
+        feature.setGeometry( *geom );
+        _pos += wkbSize;
+
+        return true;
+    }
+
+    ///
+	///
+	///
+    uint32_t FeatureRecordReader::_readUInt32()
+    {
+        if ( _pos + 4 > _size )
+            IGN_THROW_EXCEPTION( "[ app::io::FeatureRecordReader ] truncated record in '" + _path + "'" );
+
+        uint32_t value = 0;
+        for ( size_t i = 0 ; i < 4 ; ++i ) value |= static_cast< uint32_t >( _data[_pos+i] ) << ( 8 * i );
+        _pos += 4;
+        return value;
+    }
+
+    ///
+	///
+	///
+    std::string FeatureRecordReader::_readString()
+    {
+        uint32_t const size = _readUInt32();
+        if ( _pos + size > _size )
+            IGN_THROW_EXCEPTION( "[ app::io::FeatureRecordReader ] truncated record in '" + _path + "'" );
+
+        std::string value( reinterpret_cast< char const* >( _data + _pos ), size );
+        _pos += size;
+        return value;
+    }
+
+}
+}
@@ -0,0 +1,698 @@
+// APP
+#include <app/io/GeoPackageDataSource.h>
+#include <app/io/Wkb.h>
+#include <app/detail/addContours.h>
+
+// STL
+#include <cstring>
+#include <deque>
+#include <iomanip>
+#include <sstream>
+
+// SOCLE
+#include <ign/Exception.h>
+
+// EPG
+#include <epg/Context.h>
+#include <epg/params/EpgParameters.h>
+
+// SQLITE
+#include <sqlite3.h>
+
+
+namespace app{
+namespace io{
+namespace detail{
+
+    //-- nombre d'objets lus par requete lors d'un parcours
+    const int GPKG_FETCH_SIZE = 1024;
+
+    //-- nombre d'ecritures par transaction
+    const size_t GPKG_WRITES_PER_TRANSACTION = 10000;
+
+    //--
+    std::string quoteIdentifier( std::string const& name )
+    {
+        std::string result = "\"";
+        for ( size_t i = 0 ; i < name.size() ; ++i ) {
+            if ( name[i] == '"' ) result += '"';
+            result += name[i];
+        }
+        return result + "\"";
+    }
+
+    //--
+    std::string quoteLiteral( std::string const& value )
+    {
+        std::string result = "'";
+        for ( size_t i = 0 ; i < value.size() ; ++i ) {
+            if ( value[i] == '\'' ) result += '\'';
+            result += value[i];
+        }
+        return result + "'";
+    }
+
+    //-- les tables PostGIS sont designees par 'schema.table'
+    std::string gpkgTableName( std::string const& table )
+    {
+        size_t pos = table.find_last_of( '.' );
+        return pos == std::string::npos ? table : table.substr( pos+1 );
+    }
+
+    //--
+    void bindQueryValues( sqlite3_stmt* stmt, Query const& query )
+    {
+        std::vector< Condition > const& vConditions = query.getConditions();
+        for ( size_t i = 0 ; i < vConditions.size() ; ++i )
+            sqlite3_bind_text( stmt, static_cast< int >( i+1 ), vConditions[i].value.c_str(), -1, SQLITE_TRANSIENT );
+    }
+
+    //-- en-tete GeoPackageBinary : 'GP', version, drapeaux, srs_id, enveloppe
+    void writeGpkgGeometry( ign::geometry::Geometry const& geom, int srsId, std::string & blob )
+    {
+        blob.clear();
+        blob.push_back( 'G' );
+        blob.push_back( 'P' );
+        blob.push_back( 0 );
+
+        bool const isEmpty = geom.isEmpty();
+        // little endian, enveloppe xy (ou pas d'enveloppe si geometrie vide)
+        blob.push_back( static_cast< char >( isEmpty ? 0x11 : 0x03 ) );
+
+        int32_t srs = srsId;
+        blob.append( reinterpret_cast< char const* >( &srs ), 4 );
+
+        if ( !isEmpty ) {
+            ign::geometry::Envelope const env = geom.getEnvelope();
+            double const bounds[4] = { env.xmin(), env.xmax(), env.ymin(), env.ymax() };
+            blob.append( reinterpret_cast< char const* >( bounds ), sizeof( bounds ) );
+        }
+        Wkb::Write( geom, blob );
+    }
+
+    //--
+    ign::geometry::Geometry* readGpkgGeometry( unsigned char const* data, size_t size )
+    {
+        if ( size < 8 || data[0] != 'G' || data[1] != 'P' )
+            IGN_THROW_EXCEPTION( "[ app::io::GeoPackageDataSource ] invalid geometry blob" );
+
+        unsigned char const flags = data[3];
+        static const size_t envelopeSizes[8] = { 0, 32, 48, 48, 64, 0, 0, 0 };
+        size_t const headerSize = 8 + envelopeSizes[ ( flags >> 1 ) & 0x07 ];
+        if ( size < headerSize )
+            IGN_THROW_EXCEPTION( "[ app::io::GeoPackageDataSource ] invalid geometry blob" );
+
+        return Wkb::Read( data + headerSize, size - headerSize );
+    }
+
+    //-- ST_MinX, ST_MaxX, ST_MinY, ST_MaxY et ST_IsEmpty, utilisees par les triggers
+    //-- de mise a jour des index spatiaux (rtree) crees par les outils GeoPackage
+    void gpkgEnvelopeFunction( sqlite3_context* context, int argc, sqlite3_value** argv )
+    {
+        if ( sqlite3_value_type( argv[0] ) != SQLITE_BLOB ) {
+            sqlite3_result_null( context );
+            return;
+        }
+        unsigned char const* data = static_cast< unsigned char const* >( sqlite3_value_blob( argv[0] ) );
+        size_t const size = static_cast< size_t >( sqlite3_value_bytes( argv[0] ) );
+        int const function = *static_cast< int* >( sqlite3_user_data( context ) );
+
+        bool const isEmpty = size < 8 || ( data[3] & 0x10 );
+        if ( function == 4 ) {
+            sqlite3_result_int( context, isEmpty ? 1 : 0 );
+            return;
+        }
+        if ( isEmpty ) {
+            sqlite3_result_null( context );
+            return;
+        }
+
+        double bounds[4];
+        if ( ( data[3] & 0x0E ) != 0 && size >= 40 && ( data[3] & 0x01 ) ) {
+            std::memcpy( bounds, data + 8, sizeof( bounds ) );
+        } else {
+            try {
+                std::unique_ptr< ign::geometry::Geometry > geom( readGpkgGeometry( data, size ) );
+                ign::geometry::Envelope const env = geom->getEnvelope();
+                bounds[0] = env.xmin(); bounds[1] = env.xmax(); bounds[2] = env.ymin(); bounds[3] = env.ymax();
+            } catch ( ... ) {
+                sqlite3_result_null( context );
+                return;
+            }
+        }
+        sqlite3_result_double( context, bounds[function] );
+    }
+
+    //--
+    void registerGpkgFunctions( sqlite3* db )
+    {
+        static int functions[5] = { 0, 1, 2, 3, 4 };
+        static char const* names[5] = { "ST_MinX", "ST_MaxX", "ST_MinY", "ST_MaxY", "ST_IsEmpty" };
+        for ( size_t i = 0 ; i < 5 ; ++i )
+            sqlite3_create_function( db, names[i], 1, SQLITE_UTF8 | SQLITE_DETERMINISTIC, &functions[i], gpkgEnvelopeFunction, 0, 0 );
+    }
+
+    //--
+    class GeoPackageFeatureCursor : public FeatureCursor
+    {
+    public:
+        GeoPackageFeatureCursor(
+            sqlite3_stmt* stmt,
+            Query const& query,
+            std::string const& pkName,
+            std::string const& geomName
+        ):
+            _stmt( stmt ),
+            _query( query ),
+            _pkName( pkName ),
+            _geomName( geomName ),
+            _lastRowId( 0 ),
+            _finished( false )
+        {
+        }
+
+        virtual ~GeoPackageFeatureCursor()
+        {
+            sqlite3_finalize( _stmt );
+        }
+
+        virtual bool next( ign::feature::Feature & feature )
+        {
+            if ( _qFeatures.empty() && !_finished ) _fetch();
+            if ( _qFeatures.empty() ) return false;
+
+            feature = _qFeatures.front();
+            _qFeatures.pop_front();
+            return true;
+        }
+
+    private:
+
+        //-- lecture d'un lot d'objets ; la requete est reinitialisee a chaque lot
+        //-- afin qu'aucune lecture ne soit en cours lors des ecritures de l'appelant
+        void _fetch()
+        {
+            int const numConditions = static_cast< int >( _query.getConditions().size() );
+            bindQueryValues( _stmt, _query );
+            sqlite3_bind_int64( _stmt, numConditions+1, _lastRowId );
+            sqlite3_bind_int( _stmt, numConditions+2, GPKG_FETCH_SIZE );
+
+            int numRows = 0;
+            int rc;
+            while ( ( rc = sqlite3_step( _stmt ) ) == SQLITE_ROW ) {
+                _lastRowId = sqlite3_column_int64( _stmt, 0 );
+                _qFeatures.push_back( ign::feature::Feature() );
+                _readRow( _qFeatures.back() );
+                ++numRows;
+            }
+            sqlite3_reset( _stmt );
+
+            if ( rc != SQLITE_DONE )
+                IGN_THROW_EXCEPTION( "[ app::io::GeoPackageDataSource ] read error : " + std::string( sqlite3_errstr( rc ) ) );
+            if ( numRows < GPKG_FETCH_SIZE ) _finished = true;
+        }
+
+        //--
+        void _readRow( ign::feature::Feature & feature )
+        {
+            int const numColumns = sqlite3_column_count( _stmt );
+            for ( int i = 1 ; i < numColumns ; ++i ) {
+                if ( sqlite3_column_type( _stmt, i ) == SQLITE_NULL ) continue;
+
+                char const* name = sqlite3_column_name( _stmt, i );
+                if ( _geomName == name ) {
+                    unsigned char const* data = static_cast< unsigned char const* >( sqlite3_column_blob( _stmt, i ) );
+                    size_t const size = static_cast< size_t >( sqlite3_column_bytes( _stmt, i ) );
+                    std::unique_ptr< ign::geometry::Geometry > geom( readGpkgGeometry( data, size ) );
+                    feature.setGeometry( *geom );
+                    continue;
+                }
+
+                std::string const value( reinterpret_cast< char const* >( sqlite3_column_text( _stmt, i ) ) );
+                if ( _pkName == name ) feature.setId( value );
+                else feature.setAttribute( name, ign::data::String( value ) );
+            }
+        }
+
+    private:
+        sqlite3_stmt*                                      _stmt;
+        Query                                              _query;
+        std::string                                        _pkName;
+        std::string                                        _geomName;
+        sqlite3_int64                                      _lastRowId;
+        bool                                               _finished;
+        std::deque< ign::feature::Feature >                _qFeatures;
+    };
+}
+
+    ///
+	///
+	///
+    GeoPackageDataSource::GeoPackageDataSource( std::string const& path ):
+        _db( 0 ),
+        _path( path ),
+        _inTransaction( false ),
+        _numPendingWrites( 0 )
+    {
+        int rc = sqlite3_open_v2( path.c_str(), &_db, SQLITE_OPEN_READWRITE, 0 );
+        if ( rc != SQLITE_OK ) {
+            std::string const message = _db ? sqlite3_errmsg( _db ) : sqlite3_errstr( rc );
+            sqlite3_close( _db );
+            _db = 0;
+            IGN_THROW_EXCEPTION( "[ app::io::GeoPackageDataSource ] unable to open '" + path + "' : " + message );
+        }
+
+        // fichier local propre au processus : lectures en memoire projetee,
+        // pas de synchronisation disque a chaque transaction
+        _exec( "PRAGMA mmap_size = 1073741824" );
+        _exec( "PRAGMA cache_size = -262144" );
+        _exec( "PRAGMA synchronous = OFF" );
+        _exec( "PRAGMA journal_mode = MEMORY" );
+        _exec( "PRAGMA temp_store = MEMORY" );
+
+        detail::registerGpkgFunctions( _db );
+    }
+
+    ///
+	///
+	///
+    GeoPackageDataSource::~GeoPackageDataSource()
+    {
+        try {
+            commit();
+        } catch ( ... ) {}
+
+        for ( std::map< std::string, TableInfo >::iterator mit = _mTables.begin() ; mit != _mTables.end() ; ++mit ) {
+            sqlite3_finalize( mit->second.insertStmt );
+            sqlite3_finalize( mit->second.updateStmt );
+        }
+        sqlite3_close( _db );
+    }
+
+    ///
+	///
+	///
+    FeatureCursorPtr GeoPackageDataSource::getFeatures(
+        std::string const& table,
+        Query const& query
+    ) {
+        TableInfo const& info = _getTable(table);
+
+        std::string const where = _toSql(info, query);
+        std::string const sql = "SELECT rowid, * FROM " + detail::quoteIdentifier(info.name)
+            + " WHERE " + ( where.empty() ? "" : "(" + where + ") AND " ) + "rowid > ? ORDER BY rowid LIMIT ?";
+
+        return FeatureCursorPtr( new detail::GeoPackageFeatureCursor( _prepare(sql), query, info.pkName, info.geomName ) );
+    }
+
+    ///
+	///
+	///
+    size_t GeoPackageDataSource::numFeatures(
+        std::string const& table,
+        Query const& query
+    ) {
+        TableInfo const& info = _getTable(table);
+
+        std::string const where = _toSql(info, query);
+        sqlite3_stmt* stmt = _prepare( "SELECT COUNT(*) FROM " + detail::quoteIdentifier(info.name) + ( where.empty() ? "" : " WHERE " + where ) );
+        detail::bindQueryValues( stmt, query );
+
+        size_t count = 0;
+        if ( sqlite3_step( stmt ) == SQLITE_ROW ) count = static_cast< size_t >( sqlite3_column_int64( stmt, 0 ) );
+        sqlite3_finalize( stmt );
+        return count;
+    }
+
+    ///
+	///
+	///
+    ign::feature::Feature GeoPackageDataSource::newFeature(
+        std::string const& table
+    ) {
+        return ign::feature::Feature();
+    }
+
+    ///
+	///
+	///
+    void GeoPackageDataSource::createFeature(
+        std::string const& table,
+        ign::feature::Feature & feature
+    ) {
+        TableInfo & info = _getTable(table);
+        if ( info.insertStmt == 0 ) {
+            std::string columns = detail::quoteIdentifier(info.pkName) + ", " + detail::quoteIdentifier(info.geomName);
+            std::string values = "?, ?";
+            for ( size_t i = 0 ; i < info.vAttributes.size() ; ++i ) {
+                columns += ", " + detail::quoteIdentifier(info.vAttributes[i]);
+                values += ", ?";
+            }
+            info.insertStmt = _prepare( "INSERT INTO " + detail::quoteIdentifier(info.name) + " (" + columns + ") VALUES (" + values + ")" );
+        }
+
+        _beginWrite();
+        _bindFeature( info, info.insertStmt, feature );
+        if ( feature.getId().empty() ) sqlite3_bind_null( info.insertStmt, 1 );
+
+        int rc = sqlite3_step( info.insertStmt );
+        sqlite3_reset( info.insertStmt );
+        if ( rc != SQLITE_DONE )
+            IGN_THROW_EXCEPTION( "[ app::io::GeoPackageDataSource ] insert into '" + info.name + "' failed : " + sqlite3_errmsg( _db ) );
+
+        if ( feature.getId().empty() )
+            feature.setId( std::to_string( sqlite3_last_insert_rowid( _db ) ) );
+        _endWrite();
+    }
+
+    ///
+	///
+	///
+    void GeoPackageDataSource::modifyFeature(
+        std::string const& table,
+        ign::feature::Feature const& feature
+    ) {
+        TableInfo & info = _getTable(table);
+        if ( info.updateStmt == 0 ) {
+            std::string assignments = detail::quoteIdentifier(info.geomName) + " = ?2";
+            for ( size_t i = 0 ; i < info.vAttributes.size() ; ++i )
+                assignments += ", " + detail::quoteIdentifier(info.vAttributes[i]) + " = ?" + std::to_string( i+3 );
+            info.updateStmt = _prepare( "UPDATE " + detail::quoteIdentifier(info.name) + " SET " + assignments + " WHERE " + detail::quoteIdentifier(info.pkName) + " = ?1" );
+        }
+
+        _beginWrite();
+        _bindFeature( info, info.updateStmt, feature );
+
+        int rc = sqlite3_step( info.updateStmt );
+        sqlite3_reset( info.updateStmt );
+        if ( rc != SQLITE_DONE )
+            IGN_THROW_EXCEPTION( "[ app::io::GeoPackageDataSource ] update of '" + info.name + "' failed : " + sqlite3_errmsg( _db ) );
+        _endWrite();
+    }
+
+    ///
+	///
+	///
+    epg::tools::MultiLineStringTool* GeoPackageDataSource::newMultiLineStringTool(
+        std::string const& table,
+        Query const& query
+    ) {
+        ign::geometry::MultiLineString mls;
+
+        FeatureCursorPtr cursor = getFeatures( table, query );
+        ign::feature::Feature feature;
+        while ( cursor->next( feature ) )
+            app::detail::addContours( feature.getGeometry(), mls );
+
+        return new epg::tools::MultiLineStringTool( mls );
+    }
+
+    ///
+	///
+	///
+    void GeoPackageDataSource::createLineStringTable(
+        std::string const& table
+    ) {
+        epg::Context* context = epg::ContextS::getInstance();
+
+        std::string const idName = context->getEpgParameters().getValue(ID).toString();
+        std::string const geomName = context->getEpgParameters().getValue(GEOM).toString();
+        std::string const countryCodeName = context->getEpgParameters().getValue(COUNTRY_CODE).toString();
+
+        std::string const name = detail::gpkgTableName(table);
+        int const srsId = _getDefaultSrsId();
+
+        _forgetTable( name );
+        _exec( "DROP TABLE IF EXISTS " + detail::quoteIdentifier(name) );
+        _exec( "CREATE TABLE " + detail::quoteIdentifier(name) + " ("
+            + detail::quoteIdentifier(idName) + " INTEGER PRIMARY KEY AUTOINCREMENT, "
+            + detail::quoteIdentifier(countryCodeName) + " TEXT, "
+            + detail::quoteIdentifier(geomName) + " LINESTRING)" );
+        _exec( "CREATE INDEX " + detail::quoteIdentifier(name+"_"+countryCodeName+"_idx") + " ON " + detail::quoteIdentifier(name)
+            + " (" + detail::quoteIdentifier(countryCodeName) + ")" );
+
+        _registerGeometryTable( name, geomName, "LINESTRING", srsId );
+    }
+
+    ///
+	///
+	///
+    void GeoPackageDataSource::copyAreaTable(
+        std::string const& fromTable,
+        std::string const& toTable
+    ) {
+        std::string const from = detail::gpkgTableName(fromTable);
+        std::string const to = detail::gpkgTableName(toTable);
+        if ( from == to ) return;
+
+        _getTable(from);
+
+        sqlite3_stmt* stmt = _prepare( "SELECT sql FROM sqlite_master WHERE type = 'table' AND name = ?" );
+        sqlite3_bind_text( stmt, 1, from.c_str(), -1, SQLITE_TRANSIENT );
+        std::string createSql;
+        if ( sqlite3_step( stmt ) == SQLITE_ROW )
+            createSql = reinterpret_cast< char const* >( sqlite3_column_text( stmt, 0 ) );
+        sqlite3_finalize( stmt );
+
+        // definition des colonnes (a la suite du nom de la table)
+        size_t const start = createSql.find( '(' );
+        if ( start == std::string::npos )
+            IGN_THROW_EXCEPTION( "[ app::io::GeoPackageDataSource ] unable to read the definition of table '" + from + "'" );
+
+        _forgetTable( to );
+        _exec( "DROP TABLE IF EXISTS " + detail::quoteIdentifier(to) );
+        _exec( "CREATE TABLE " + detail::quoteIdentifier(to) + " " + createSql.substr( start ) );
+        _exec( "INSERT INTO " + detail::quoteIdentifier(to) + " SELECT * FROM " + detail::quoteIdentifier(from) );
+
+        // metadonnees GeoPackage de la table source
+        std::string const quotedFrom = detail::quoteLiteral(from);
+        std::string const quotedTo = detail::quoteLiteral(to);
+        _exec( "DELETE FROM gpkg_geometry_columns WHERE table_name = " + quotedTo );
+        _exec( "DELETE FROM gpkg_contents WHERE table_name = " + quotedTo );
+        _exec( "INSERT INTO gpkg_contents (table_name, data_type, identifier, description, min_x, min_y, max_x, max_y, srs_id)"
+            " SELECT " + quotedTo + ", data_type, " + quotedTo + ", description, min_x, min_y, max_x, max_y, srs_id FROM gpkg_contents WHERE table_name = " + quotedFrom );
+        _exec( "INSERT INTO gpkg_geometry_columns (table_name, column_name, geometry_type_name, srs_id, z, m)"
+            " SELECT " + quotedTo + ", column_name, geometry_type_name, srs_id, z, m FROM gpkg_geometry_columns WHERE table_name = " + quotedFrom );
+    }
+
+    ///
+	///
+	///
+    void GeoPackageDataSource::commit()
+    {
+        if ( !_inTransaction ) return;
+        _inTransaction = false;
+        _numPendingWrites = 0;
+        _exec( "COMMIT" );
+    }
+
+    ///
+	///
+	///
+    std::string GeoPackageDataSource::_toSql( TableInfo const& info, Query const& query ) const
+    {
+        std::vector< Condition > const& vConditions = query.getConditions();
+
+        std::string sql;
+        for ( size_t i = 0 ; i < vConditions.size() ; ++i ) {
+            if ( i > 0 ) sql += " AND ";
+            std::string const attribute = detail::quoteIdentifier( vConditions[i].attribute );
+            std::string const parameter = "?" + std::to_string( i+1 );
+            switch( vConditions[i].op )
+            {
+            case Condition::EQUALS :
+                sql += attribute + " = " + parameter;
+                break;
+            case Condition::CONTAINS :
+                sql += "instr(CAST(" + attribute + " AS TEXT), " + parameter + ") > 0";
+                break;
+            case Condition::NOT_CONTAINS :
+                sql += "instr(CAST(" + attribute + " AS TEXT), " + parameter + ") = 0";
+                break;
+            case Condition::CONTAINS_CODE :
+                sql += "instr('#' || CAST(" + attribute + " AS TEXT) || '#', '#' || " + parameter + " || '#') > 0";
+                break;
+            }
+        }
+
+        // prefiltre spatial : index rtree s'il existe, sinon enveloppes des geometries
+        std::vector< ign::geometry::Envelope > const& vEnvelopes = query.getEnvelopes();
+        if ( !vEnvelopes.empty() ) {
+            std::string const geom = detail::quoteIdentifier(info.geomName);
+            std::string const minX = info.hasRtree ? "minx" : "ST_MinX(" + geom + ")";
+            std::string const maxX = info.hasRtree ? "maxx" : "ST_MaxX(" + geom + ")";
+            std::string const minY = info.hasRtree ? "miny" : "ST_MinY(" + geom + ")";
+            std::string const maxY = info.hasRtree ? "maxy" : "ST_MaxY(" + geom + ")";
+
+            std::ostringstream ss;
+            ss << std::setprecision(17);
+            for ( size_t i = 0 ; i < vEnvelopes.size() ; ++i ) {
+                if ( i > 0 ) ss << " OR ";
+                ss << "(" << maxX << " >= " << vEnvelopes[i].xmin() << " AND " << minX << " <= " << vEnvelopes[i].xmax()
+                    << " AND " << maxY << " >= " << vEnvelopes[i].ymin() << " AND " << minY << " <= " << vEnvelopes[i].ymax() << ")";
+            }
+
+            if ( !sql.empty() ) sql += " AND ";
+            if ( info.hasRtree )
+                sql += "rowid IN (SELECT id FROM " + detail::quoteIdentifier("rtree_"+info.name+"_"+info.geomName) + " WHERE " + ss.str() + ")";
+            else
+                sql += "(" + ss.str() + ")";
+        }
+        return sql;
+    }
+
+    ///
+	///
+	///
+    GeoPackageDataSource::TableInfo & GeoPackageDataSource::_getTable( std::string const& table )
+    {
+        std::string const name = detail::gpkgTableName(table);
+
+        std::map< std::string, TableInfo >::iterator mit = _mTables.find( name );
+        if ( mit != _mTables.end() ) return mit->second;
+
+        TableInfo info;
+        info.name = name;
+        info.srsId = 0;
+        info.hasRtree = false;
+        info.insertStmt = 0;
+        info.updateStmt = 0;
+
+        sqlite3_stmt* stmt = _prepare( "SELECT column_name, srs_id FROM gpkg_geometry_columns WHERE table_name = ?" );
+        sqlite3_bind_text( stmt, 1, name.c_str(), -1, SQLITE_TRANSIENT );
+        if ( sqlite3_step( stmt ) == SQLITE_ROW ) {
+            info.geomName = reinterpret_cast< char const* >( sqlite3_column_text( stmt, 0 ) );
+            info.srsId = sqlite3_column_int( stmt, 1 );
+        }
+        sqlite3_finalize( stmt );
+
+        if ( info.geomName.empty() )
+            IGN_THROW_EXCEPTION( "[ app::io::GeoPackageDataSource ] table '" + name + "' is not a feature table of '" + _path + "'" );
+
+        stmt = _prepare( "PRAGMA table_info(" + detail::quoteIdentifier(name) + ")" );
+        while ( sqlite3_step( stmt ) == SQLITE_ROW ) {
+            std::string const column = reinterpret_cast< char const* >( sqlite3_column_text( stmt, 1 ) );
+            if ( sqlite3_column_int( stmt, 5 ) > 0 ) info.pkName = column;
+            else if ( column != info.geomName ) info.vAttributes.push_back( column );
+        }
+        sqlite3_finalize( stmt );
+
+        if ( info.pkName.empty() )
+            IGN_THROW_EXCEPTION( "[ app::io::GeoPackageDataSource ] table '" + name + "' has no primary key" );
+
+        stmt = _prepare( "SELECT 1 FROM sqlite_master WHERE type = 'table' AND name = ?" );
+        std::string const rtreeName = "rtree_" + name + "_" + info.geomName;
+        sqlite3_bind_text( stmt, 1, rtreeName.c_str(), -1, SQLITE_TRANSIENT );
+        info.hasRtree = sqlite3_step( stmt ) == SQLITE_ROW;
+        sqlite3_finalize( stmt );
+
+        return _mTables.insert( std::make_pair( name, info ) ).first->second;
+    }
+
+    ///
+	///
+	///
+    void GeoPackageDataSource::_forgetTable( std::string const& name )
+    {
+        std::map< std::string, TableInfo >::iterator mit = _mTables.find( name );
+        if ( mit == _mTables.end() ) return;
+
+        sqlite3_finalize( mit->second.insertStmt );
+        sqlite3_finalize( mit->second.updateStmt );
+        _mTables.erase( mit );
+    }
+
+    ///
+	///
+	///
+    void GeoPackageDataSource::_exec( std::string const& sql )
+    {
+        char* errorMessage = 0;
+        if ( sqlite3_exec( _db, sql.c_str(), 0, 0, &errorMessage ) != SQLITE_OK ) {
+            std::string const message = errorMessage ? errorMessage : "";
+            sqlite3_free( errorMessage );
+            IGN_THROW_EXCEPTION( "[ app::io::GeoPackageDataSource ] " + sql + " : " + message );
+        }
+    }
+
+    ///
+	///
+	///
+    sqlite3_stmt* GeoPackageDataSource::_prepare( std::string const& sql )
+    {
+        sqlite3_stmt* stmt = 0;
+        if ( sqlite3_prepare_v2( _db, sql.c_str(), -1, &stmt, 0 ) != SQLITE_OK )
+            IGN_THROW_EXCEPTION( "[ app::io::GeoPackageDataSource ] " + sql + " : " + sqlite3_errmsg( _db ) );
+        return stmt;
+    }
+
+    ///
+	///
+	///
+    void GeoPackageDataSource::_beginWrite()
+    {
+        if ( _inTransaction ) return;
+        _exec( "BEGIN" );
+        _inTransaction = true;
+    }
+
+    ///
+	///
+	///
+    void GeoPackageDataSource::_endWrite()
+    {
+        if ( ++_numPendingWrites >= detail::GPKG_WRITES_PER_TRANSACTION ) commit();
+    }
+
+    ///
+	///
+	///
+    void GeoPackageDataSource::_bindFeature( TableInfo const& info, sqlite3_stmt* stmt, ign::feature::Feature const& feature )
+    {
+        sqlite3_bind_text( stmt, 1, feature.getId().c_str(), -1, SQLITE_TRANSIENT );
+
+        std::string blob;
+        detail::writeGpkgGeometry( feature.getGeometry(), info.srsId, blob );
+        sqlite3_bind_blob( stmt, 2, blob.data(), static_cast< int >( blob.size() ), SQLITE_TRANSIENT );
+
+        for ( size_t i = 0 ; i < info.vAttributes.size() ; ++i ) {
+            int const index = static_cast< int >( i+3 );
+            std::string value;
+            try {
+                value = feature.getAttribute( info.vAttributes[i] ).toString();
+            } catch ( ... ) {
+                sqlite3_bind_null( stmt, index );
+                continue;
+            }
+            sqlite3_bind_text( stmt, index, value.c_str(), -1, SQLITE_TRANSIENT );
+        }
+    }
+
+    ///
+	///
+	///
+    void GeoPackageDataSource::_registerGeometryTable( std::string const& name, std::string const& geomName, std::string const& geometryType, int srsId )
+    {
+        std::string const srs = std::to_string( srsId );
+        _exec( "DELETE FROM gpkg_geometry_columns WHERE table_name = " + detail::quoteLiteral(name) );
+        _exec( "DELETE FROM gpkg_contents WHERE table_name = " + detail::quoteLiteral(name) );
+        _exec( "INSERT INTO gpkg_contents (table_name, data_type, identifier, srs_id) VALUES ("
+            + detail::quoteLiteral(name) + ", 'features', " + detail::quoteLiteral(name) + ", " + srs + ")" );
+        _exec( "INSERT INTO gpkg_geometry_columns (table_name, column_name, geometry_type_name, srs_id, z, m) VALUES ("
+            + detail::quoteLiteral(name) + ", " + detail::quoteLiteral(geomName) + ", " + detail::quoteLiteral(geometryType) + ", " + srs + ", 0, 0)" );
+    }
+
+    ///
+	///
+	///
+    int GeoPackageDataSource::_getDefaultSrsId()
+    {
+        int srsId = 0;
+        sqlite3_stmt* stmt = _prepare( "SELECT srs_id FROM gpkg_geometry_columns ORDER BY rowid LIMIT 1" );
+        if ( sqlite3_step( stmt ) == SQLITE_ROW ) srsId = sqlite3_column_int( stmt, 0 );
+        sqlite3_finalize( stmt );
+        return srsId;
+    }
+
+}
+}
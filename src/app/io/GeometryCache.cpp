@@ -0,0 +1,370 @@
+// APP
+#include <app/io/GeometryCache.h>
+#include <app/detail/addContours.h>
+#include <app/tools/Hash64.h>
+
+// STL
+#include <cstring>
+#include <fstream>
+
+// BOOST
+#include <boost/filesystem.hpp>
+
+// EPG
+#include <epg/log/EpgLogger.h>
+
+
+namespace app{
+namespace io{
+namespace detail{
+
+    //--
+    const char CACHE_MAGIC[4] = { 'A', 'U', 'G', 'C' };
+
+    //-- a incrementer a chaque modification du format ou des calculs mis en cache
+    const uint32_t CACHE_VERSION = 1;
+
+    //--
+    template< typename T >
+    void append( T value, std::string & buffer )
+    {
+        buffer.append( reinterpret_cast< char const* >( &value ), sizeof( T ) );
+    }
+
+    //--
+    void appendString( std::string const& value, std::string & buffer )
+    {
+        append( static_cast< uint32_t >( value.size() ), buffer );
+        buffer.append( value );
+    }
+
+    //-- lecture bornee dans la zone projetee
+    class CacheReader
+    {
+    public:
+        CacheReader( unsigned char const* data, size_t size ):
+            _data( data ),
+            _size( size ),
+            _pos( 0 )
+        {
+        }
+
+        template< typename T >
+        bool read( T & value )
+        {
+            if ( _pos + sizeof( T ) > _size ) return false;
+            std::memcpy( &value, _data + _pos, sizeof( T ) );
+            _pos += sizeof( T );
+            return true;
+        }
+
+        bool readString( std::string & value )
+        {
+            uint32_t size = 0;
+            if ( !read( size ) || _pos + size > _size ) return false;
+            value.assign( reinterpret_cast< char const* >( _data + _pos ), size );
+            _pos += size;
+            return true;
+        }
+
+        bool skip( size_t size )
+        {
+            if ( _pos + size > _size ) return false;
+            _pos += size;
+            return true;
+        }
+
+        size_t pos() const { return _pos; }
+
+    private:
+        unsigned char const*                               _data;
+        size_t                                             _size;
+        size_t                                             _pos;
+    };
+}
+
+    ///
+	///
+	///
+    GeometryCache::GeometryCache(
+        std::string const& directory,
+        std::string const& name
+    ):
+        _directory( directory ),
+        _name( name )
+    {
+        addKey( name );
+    }
+
+    ///
+	///
+	///
+    GeometryCache::~GeometryCache()
+    {
+    }
+
+    ///
+	///
+	///
+    void GeometryCache::addKey( std::string const& value )
+    {
+        _key += value;
+        _key += "\n";
+    }
+
+    ///
+	///
+	///
+    void GeometryCache::addSource(
+        DataSource & dataSource,
+        std::string const& table,
+        Query const& query
+    ) {
+        addKey( table + "\t" + query.toString() + "\t" + dataSource.checksum( table, query ) );
+    }
+
+    ///
+	///
+	///
+    std::string GeometryCache::path() const
+    {
+        return _directory + "/" + _name + "_" + tools::Hash64().add( _key ).toString() + ".bin";
+    }
+
+    ///
+	///
+	///
+    bool GeometryCache::load()
+    {
+        _unload();
+        if ( !isEnabled() ) return false;
+
+        epg::log::EpgLogger* logger = epg::log::EpgLoggerS::getInstance();
+
+        std::string const filePath = path();
+        if ( !boost::filesystem::exists( filePath ) ) {
+            logger->log( epg::log::INFO, "geometry cache miss : " + filePath );
+            return false;
+        }
+
+        try {
+            _mapping = boost::interprocess::file_mapping( filePath.c_str(), boost::interprocess::read_only );
+            _region = boost::interprocess::mapped_region( _mapping, boost::interprocess::read_only );
+        } catch ( boost::interprocess::interprocess_exception const& e ) {
+            logger->log( epg::log::WARN, "unable to map geometry cache '" + filePath + "' : " + e.what() );
+            _unload();
+            return false;
+        }
+
+        // un fichier invalide (tronque, autre version, collision de nom) est ignore : il sera reecrit
+        detail::CacheReader reader( static_cast< unsigned char const* >( _region.get_address() ), _region.get_size() );
+
+        char magic[4] = { 0, 0, 0, 0 };
+        uint32_t version = 0;
+        std::string key;
+        uint32_t numSections = 0;
+        bool valid = reader.read( magic ) && std::memcmp( magic, detail::CACHE_MAGIC, 4 ) == 0
+            && reader.read( version ) && version == detail::CACHE_VERSION
+            && reader.readString( key ) && key == _key
+            && reader.read( numSections );
+
+        for ( uint32_t i = 0 ; valid && i < numSections ; ++i ) {
+            std::string name;
+            uint64_t size = 0;
+            valid = reader.readString( name ) && reader.read( size );
+            if ( !valid ) break;
+
+            Section section;
+            section.offset = reader.pos();
+            section.size = static_cast< size_t >( size );
+            valid = reader.skip( section.size );
+            _mSections[name] = section;
+        }
+
+        if ( !valid ) {
+            logger->log( epg::log::WARN, "invalid geometry cache ignored : " + filePath );
+            _unload();
+            return false;
+        }
+
+        logger->log( epg::log::INFO, "geometry cache hit : " + filePath );
+        return true;
+    }
+
+    ///
+	///
+	///
+    bool GeometryCache::get(
+        std::string const& section,
+        std::vector< ign::geometry::LineString > & vLs
+    ) const {
+        std::map< std::string, std::vector< ign::geometry::LineString > >::const_iterator nit = _mNewSections.find( section );
+        if ( nit != _mNewSections.end() ) {
+            vLs = nit->second;
+            return true;
+        }
+
+        std::map< std::string, Section >::const_iterator mit = _mSections.find( section );
+        if ( mit == _mSections.end() ) return false;
+
+        _decode( mit->second, vLs );
+        return true;
+    }
+
+    ///
+	///
+	///
+    void GeometryCache::set(
+        std::string const& section,
+        std::vector< ign::geometry::LineString > const& vLs
+    ) {
+        if ( !isEnabled() ) return;
+        _mNewSections[section] = vLs;
+    }
+
+    ///
+	///
+	///
+    void GeometryCache::getContours(
+        std::string const& section,
+        DataSource & dataSource,
+        std::string const& table,
+        Query const& query,
+        ign::geometry::MultiLineString & mls
+    ) {
+        std::vector< ign::geometry::LineString > vLs;
+        if ( get( section, vLs ) ) {
+            for ( size_t i = 0 ; i < vLs.size() ; ++i )
+                mls.addGeometry( vLs[i] );
+        } else {
+            FeatureCursorPtr cursor = dataSource.getFeatures( table, query );
+            ign::feature::Feature feature;
+            while ( cursor->next( feature ) )
+                app::detail::addContours( feature.getGeometry(), mls );
+            if ( !isEnabled() ) return;
+
+            vLs.reserve( mls.numGeometries() );
+            for ( size_t i = 0 ; i < mls.numGeometries() ; ++i )
+                vLs.push_back( mls.lineStringN(i) );
+            set( section, vLs );
+        }
+    }
+
+    ///
+	///
+	///
+    epg::tools::MultiLineStringTool* GeometryCache::newMultiLineStringTool(
+        std::string const& section,
+        DataSource & dataSource,
+        std::string const& table,
+        Query const& query
+    ) {
+        if ( !isEnabled() ) return dataSource.newMultiLineStringTool( table, query );
+
+        ign::geometry::MultiLineString mls;
+        getContours( section, dataSource, table, query, mls );
+        return new epg::tools::MultiLineStringTool( mls );
+    }
+
+    ///
+	///
+	///
+    void GeometryCache::save()
+    {
+        if ( !isEnabled() || _mNewSections.empty() ) return;
+
+        // les sections deja en cache et non remplacees sont conservees
+        std::map< std::string, std::vector< ign::geometry::LineString > > mSections = _mNewSections;
+        for ( std::map< std::string, Section >::const_iterator mit = _mSections.begin() ; mit != _mSections.end() ; ++mit )
+            if ( mSections.find( mit->first ) == mSections.end() )
+                _decode( mit->second, mSections[mit->first] );
+        _unload();
+
+        std::string buffer;
+        buffer.append( detail::CACHE_MAGIC, 4 );
+        detail::append( detail::CACHE_VERSION, buffer );
+        detail::appendString( _key, buffer );
+        detail::append( static_cast< uint32_t >( mSections.size() ), buffer );
+
+        for ( std::map< std::string, std::vector< ign::geometry::LineString > >::const_iterator mit = mSections.begin() ; mit != mSections.end() ; ++mit ) {
+            detail::appendString( mit->first, buffer );
+
+            size_t const sizePos = buffer.size();
+            detail::append( static_cast< uint64_t >( 0 ), buffer );
+
+            std::vector< ign::geometry::LineString > const& vLs = mit->second;
+            detail::append( static_cast< uint32_t >( vLs.size() ), buffer );
+            for ( size_t i = 0 ; i < vLs.size() ; ++i ) {
+                detail::append( static_cast< uint32_t >( vLs[i].numPoints() ), buffer );
+                for ( size_t j = 0 ; j < vLs[i].numPoints() ; ++j ) {
+                    detail::append( vLs[i].pointN(j).x(), buffer );
+                    detail::append( vLs[i].pointN(j).y(), buffer );
+                }
+            }
+
+            uint64_t const size = buffer.size() - sizePos - sizeof( uint64_t );
+            std::memcpy( &buffer[sizePos], &size, sizeof( uint64_t ) );
+        }
+
+        // ecriture dans un fichier temporaire puis renommage : un fichier de cache est toujours complet
+        epg::log::EpgLogger* logger = epg::log::EpgLoggerS::getInstance();
+        std::string const filePath = path();
+        std::string const tmpPath = filePath + ".tmp";
+        try {
+            boost::filesystem::create_directories( _directory );
+            std::ofstream ofs( tmpPath.c_str(), std::ios::binary | std::ios::trunc );
+            ofs.write( buffer.data(), buffer.size() );
+            ofs.close();
+            if ( !ofs ) {
+                logger->log( epg::log::WARN, "unable to write geometry cache '" + tmpPath + "'" );
+                return;
+            }
+            boost::filesystem::rename( tmpPath, filePath );
+        } catch ( boost::filesystem::filesystem_error const& e ) {
+            logger->log( epg::log::WARN, "unable to write geometry cache '" + filePath + "' : " + e.what() );
+            return;
+        }
+
+        _mNewSections.clear();
+        load();
+    }
+
+    ///
+	///
+	///
+    void GeometryCache::_decode( Section const& section, std::vector< ign::geometry::LineString > & vLs ) const
+    {
+        detail::CacheReader reader( static_cast< unsigned char const* >( _region.get_address() ) + section.offset, section.size );
+
+        uint32_t numLs = 0;
+        reader.read( numLs );
+        vLs.clear();
+        vLs.reserve( numLs );
+        for ( uint32_t i = 0 ; i < numLs ; ++i ) {
+            uint32_t numPoints = 0;
+            reader.read( numPoints );
+
+            vLs.push_back( ign::geometry::LineString() );
+            ign::geometry::LineString & ls = vLs.back();
+            ls.reserve( numPoints );
+            for ( uint32_t j = 0 ; j < numPoints ; ++j ) {
+                double x = 0, y = 0;
+                reader.read( x );
+                reader.read( y );
+                ls.addPoint( ign::geometry::Point( x, y ) );
+            }
+        }
+    }
+
+    ///
+	///
+	///
+    void GeometryCache::_unload()
+    {
+        _mSections.clear();
+        _region = boost::interprocess::mapped_region();
+        _mapping = boost::interprocess::file_mapping();
+    }
+
+}
+}
@@ -0,0 +1,79 @@
+// APP
+#include <app/io/HilbertOrderedCursor.h>
+#include <app/tools/HilbertCurve.h>
+
+// STL
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+
+namespace app{
+namespace io{
+
+    ///
+	///
+	///
+    HilbertOrderedCursor::HilbertOrderedCursor( FeatureCursorPtr cursor ):
+        _cursor( std::move( cursor ) ),
+        _next( 0 ),
+        _sorted( false )
+    {
+    }
+
+    ///
+	///
+	///
+    bool HilbertOrderedCursor::next( ign::feature::Feature & feature )
+    {
+        if ( !_sorted ) _sort();
+        if ( _next >= _vOrder.size() ) return false;
+
+        // l'objet est cede a l'appelant
+        feature = std::move( _vFeatures[_vOrder[_next++]] );
+        return true;
+    }
+
+    ///
+	///
+	///
+    void HilbertOrderedCursor::_sort()
+    {
+        _sorted = true;
+
+        // centres des emprises (les geometries vides sont placees en fin de parcours)
+        std::vector< std::pair< double, double > > vCenters;
+        double xmin = std::numeric_limits< double >::max(), ymin = xmin;
+        double xmax = -xmin, ymax = -xmin;
+        ign::feature::Feature feature;
+        while ( _cursor->next( feature ) ) {
+            ign::geometry::Envelope const envelope = feature.getGeometry().getEnvelope();
+            if ( envelope.isNull() ) {
+                vCenters.push_back( std::make_pair( std::numeric_limits< double >::quiet_NaN(), 0. ) );
+            } else {
+                vCenters.push_back( std::make_pair( ( envelope.xmin() + envelope.xmax() ) / 2, ( envelope.ymin() + envelope.ymax() ) / 2 ) );
+                xmin = std::min( xmin, vCenters.back().first );
+                xmax = std::max( xmax, vCenters.back().first );
+                ymin = std::min( ymin, vCenters.back().second );
+                ymax = std::max( ymax, vCenters.back().second );
+            }
+            _vFeatures.push_back( feature );
+        }
+        _cursor.reset();
+        if ( _vFeatures.empty() ) return;
+        if ( xmin > xmax ) xmin = xmax = ymin = ymax = 0;
+
+        tools::HilbertCurve const curve( ign::geometry::Envelope( ign::geometry::Point( xmin, ymin ), ign::geometry::Point( xmax, ymax ) ) );
+        std::vector< std::pair< uint64_t, size_t > > vKeys( _vFeatures.size() );
+        for ( size_t i = 0 ; i < vCenters.size() ; ++i )
+            vKeys[i] = std::make_pair( std::isnan( vCenters[i].first ) ? std::numeric_limits< uint64_t >::max() : curve.key( vCenters[i].first, vCenters[i].second ), i );
+        // a rang egal, l'ordre de lecture est conserve
+        std::sort( vKeys.begin(), vKeys.end() );
+
+        _vOrder.reserve( vKeys.size() );
+        for ( size_t i = 0 ; i < vKeys.size() ; ++i ) _vOrder.push_back( vKeys[i].second );
+    }
+
+}
+}
@@ -0,0 +1,272 @@
+// APP
+#include <app/io/IntermediateDataSource.h>
+
+// SOCLE
+#include <ign/Exception.h>
+
+// EPG
+#include <epg/log/EpgLogger.h>
+
+
+namespace app{
+namespace io{
+namespace detail{
+
+    //-- nombre maximum d'objets en attente d'enregistrement
+    const size_t INTERMEDIATE_QUEUE_SIZE = 4096;
+
+    //-- parcours dont les lectures sont serialisees avec les autres acces a la source
+    class LockedFeatureCursor : public FeatureCursor
+    {
+    public:
+        LockedFeatureCursor( FeatureCursorPtr cursor, std::mutex & mutex ):
+            _cursor( std::move( cursor ) ),
+            _mutex( mutex )
+        {
+        }
+
+        virtual bool next( ign::feature::Feature & feature )
+        {
+            std::lock_guard< std::mutex > lock( _mutex );
+            return _cursor->next( feature );
+        }
+
+    private:
+        FeatureCursorPtr                                   _cursor;
+        std::mutex &                                       _mutex;
+    };
+}
+
+    ///
+	///
+	///
+    IntermediateDataSource::IntermediateDataSource(
+        DataSource* dataSource,
+        std::vector< std::string > const& vTables,
+        bool persist
+    ):
+        _dataSource( dataSource ),
+        _sTables( vTables.begin(), vTables.end() ),
+        _persist( persist ),
+        _writeQueue( detail::INTERMEDIATE_QUEUE_SIZE )
+    {
+        if ( _persist ) _writer = std::thread( &IntermediateDataSource::_write, this );
+    }
+
+    ///
+	///
+	///
+    IntermediateDataSource::~IntermediateDataSource()
+    {
+        try {
+            finish();
+        } catch ( ign::Exception const& e ) {
+            epg::log::EpgLoggerS::getInstance()->log( epg::log::ERROR, "intermediate tables not persisted : " + std::string( e.diagnostic() ) );
+        } catch ( std::exception const& e ) {
+            epg::log::EpgLoggerS::getInstance()->log( epg::log::ERROR, "intermediate tables not persisted : " + std::string( e.what() ) );
+        }
+        delete _dataSource;
+    }
+
+    ///
+	///
+	///
+    FeatureCursorPtr IntermediateDataSource::getFeatures(
+        std::string const& table,
+        Query const& query
+    ) {
+        std::lock_guard< std::mutex > lock( _dataSourceMutex );
+        FeatureCursorPtr cursor = _inMemory( table ) ? _memory.getFeatures( table, query ) : _dataSource->getFeatures( table, query );
+        return FeatureCursorPtr( new detail::LockedFeatureCursor( std::move( cursor ), _dataSourceMutex ) );
+    }
+
+    ///
+	///
+	///
+    size_t IntermediateDataSource::numFeatures(
+        std::string const& table,
+        Query const& query
+    ) {
+        std::lock_guard< std::mutex > lock( _dataSourceMutex );
+        return _inMemory( table ) ? _memory.numFeatures( table, query ) : _dataSource->numFeatures( table, query );
+    }
+
+    ///
+	///
+	///
+    ign::feature::Feature IntermediateDataSource::newFeature(
+        std::string const& table
+    ) {
+        std::lock_guard< std::mutex > lock( _dataSourceMutex );
+        // en cas d'enregistrement, l'objet doit etre conforme au schema de la table sous-jacente
+        if ( _inMemory( table ) && !_persist ) return _memory.newFeature( table );
+        return _dataSource->newFeature( table );
+    }
+
+    ///
+	///
+	///
+    void IntermediateDataSource::createFeature(
+        std::string const& table,
+        ign::feature::Feature & feature
+    ) {
+        if ( !_inMemory( table ) ) {
+            std::lock_guard< std::mutex > lock( _dataSourceMutex );
+            _dataSource->createFeature( table, feature );
+            return;
+        }
+
+        if ( _persist ) {
+            // copie avant attribution de l'identifiant : la source sous-jacente attribue le sien
+            PendingFeature pending;
+            pending.table = table;
+            pending.feature = feature;
+            if ( !_writeQueue.push( pending ) ) finish();
+        }
+
+        std::lock_guard< std::mutex > lock( _dataSourceMutex );
+        _memory.createFeature( table, feature );
+    }
+
+    ///
+	///
+	///
+    void IntermediateDataSource::modifyFeature(
+        std::string const& table,
+        ign::feature::Feature const& feature
+    ) {
+        if ( _inMemory( table ) )
+            IGN_THROW_EXCEPTION( "[ app::io::IntermediateDataSource ] intermediate table '" + table + "' cannot be modified" );
+
+        std::lock_guard< std::mutex > lock( _dataSourceMutex );
+        _dataSource->modifyFeature( table, feature );
+    }
+
+    ///
+	///
+	///
+    epg::tools::MultiLineStringTool* IntermediateDataSource::newMultiLineStringTool(
+        std::string const& table,
+        Query const& query
+    ) {
+        std::lock_guard< std::mutex > lock( _dataSourceMutex );
+        return _inMemory( table ) ? _memory.newMultiLineStringTool( table, query ) : _dataSource->newMultiLineStringTool( table, query );
+    }
+
+    ///
+	///
+	///
+    void IntermediateDataSource::createLineStringTable(
+        std::string const& table
+    ) {
+        if ( _sTables.find( table ) == _sTables.end() ) {
+            std::lock_guard< std::mutex > lock( _dataSourceMutex );
+            _dataSource->createLineStringTable( table );
+            return;
+        }
+
+        // les objets d'une version precedente de la table doivent etre enregistres avant sa recreation
+        if ( _persist && _inMemory( table ) ) {
+            finish();
+            _writer = std::thread( &IntermediateDataSource::_write, this );
+        }
+
+        std::lock_guard< std::mutex > lock( _dataSourceMutex );
+        if ( _persist ) _dataSource->createLineStringTable( table );
+        _memory.createLineStringTable( table );
+    }
+
+    ///
+	///
+	///
+    void IntermediateDataSource::copyAreaTable(
+        std::string const& fromTable,
+        std::string const& toTable
+    ) {
+        std::lock_guard< std::mutex > lock( _dataSourceMutex );
+        _dataSource->copyAreaTable( fromTable, toTable );
+    }
+
+    ///
+	///
+	///
+    void IntermediateDataSource::createCodeIndex(
+        std::string const& table,
+        std::string const& attribute
+    ) {
+        // les tables intermediaires sont indexees lors de leur creation
+        if ( _sTables.find( table ) != _sTables.end() ) return;
+
+        std::lock_guard< std::mutex > lock( _dataSourceMutex );
+        _dataSource->createCodeIndex( table, attribute );
+    }
+
+    ///
+	///
+	///
+    std::string IntermediateDataSource::checksum(
+        std::string const& table,
+        Query const& query
+    ) {
+        if ( _inMemory( table ) ) return DataSource::checksum( table, query );
+
+        std::lock_guard< std::mutex > lock( _dataSourceMutex );
+        return _dataSource->checksum( table, query );
+    }
+
+    ///
+	///
+	///
+    void IntermediateDataSource::commit()
+    {
+        std::lock_guard< std::mutex > lock( _dataSourceMutex );
+        _dataSource->commit();
+    }
+
+    ///
+	///
+	///
+    void IntermediateDataSource::finish()
+    {
+        if ( !_writer.joinable() ) return;
+
+        _writeQueue.close();
+        _writer.join();
+        _writeQueue.reopen();
+
+        if ( _writerError ) {
+            std::exception_ptr error = _writerError;
+            _writerError = std::exception_ptr();
+            std::rethrow_exception( error );
+        }
+    }
+
+    ///
+	///
+	///
+    bool IntermediateDataSource::_inMemory( std::string const& table ) const
+    {
+        return _sTables.find( table ) != _sTables.end() && _memory.hasTable( table );
+    }
+
+    ///
+	///
+	///
+    void IntermediateDataSource::_write()
+    {
+        try {
+            std::vector< PendingFeature > vPending;
+            while ( _writeQueue.popAll( vPending ) ) {
+                std::lock_guard< std::mutex > lock( _dataSourceMutex );
+                for ( size_t i = 0 ; i < vPending.size() ; ++i )
+                    _dataSource->createFeature( vPending[i].table, vPending[i].feature );
+                vPending.clear();
+            }
+        } catch ( ... ) {
+            _writerError = std::current_exception();
+        }
+        _writeQueue.close();
+    }
+
+}
+}
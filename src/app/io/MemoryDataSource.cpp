@@ -0,0 +1,202 @@
+// APP
+#include <app/io/MemoryDataSource.h>
+#include <app/detail/addContours.h>
+
+// SOCLE
+#include <ign/Exception.h>
+
+// BOOST
+#include <boost/lexical_cast.hpp>
+
+
+namespace app{
+namespace io{
+namespace detail{
+
+    //--
+    class MemoryFeatureCursor : public FeatureCursor
+    {
+    public:
+        MemoryFeatureCursor( std::vector< ign::feature::Feature > const& vFeatures, Query const& query ):
+            _vFeatures( vFeatures ),
+            _query( query ),
+            _current( 0 )
+        {
+        }
+
+        virtual bool next( ign::feature::Feature & feature )
+        {
+            while ( _current < _vFeatures.size() ) {
+                ign::feature::Feature const& candidate = _vFeatures[_current++];
+                if ( !_query.matches( candidate ) ) continue;
+                feature = candidate;
+                return true;
+            }
+            return false;
+        }
+
+    private:
+        std::vector< ign::feature::Feature > const&        _vFeatures;
+        Query                                              _query;
+        size_t                                             _current;
+    };
+}
+
+    ///
+	///
+	///
+    MemoryDataSource::MemoryDataSource()
+    {
+    }
+
+    ///
+	///
+	///
+    MemoryDataSource::~MemoryDataSource()
+    {
+    }
+
+    ///
+	///
+	///
+    FeatureCursorPtr MemoryDataSource::getFeatures( 
+        std::string const& table, 
+        Query const& query 
+    ) {
+        return FeatureCursorPtr( new detail::MemoryFeatureCursor( _getTable(table).vFeatures, query ) );
+    }
+
+    ///
+	///
+	///
+    size_t MemoryDataSource::numFeatures( 
+        std::string const& table, 
+        Query const& query 
+    ) {
+        std::vector< ign::feature::Feature > const& vFeatures = _getTable(table).vFeatures;
+
+        size_t count = 0;
+        for ( size_t i = 0 ; i < vFeatures.size() ; ++i )
+            if ( query.matches( vFeatures[i] ) ) ++count;
+        return count;
+    }
+
+    ///
+	///
+	///
+    ign::feature::Feature MemoryDataSource::newFeature( 
+        std::string const& table 
+    ) {
+        return ign::feature::Feature();
+    }
+
+    ///
+	///
+	///
+    void MemoryDataSource::createFeature( 
+        std::string const& table, 
+        ign::feature::Feature & feature 
+    ) {
+        Table & t = _getTable(table);
+        if ( feature.getId().empty() )
+            feature.setId( boost::lexical_cast<std::string>( t.nextId++ ) );
+
+        t.mIndex[feature.getId()] = t.vFeatures.size();
+        t.vFeatures.push_back( feature );
+    }
+
+    ///
+	///
+	///
+    void MemoryDataSource::modifyFeature( 
+        std::string const& table, 
+        ign::feature::Feature const& feature 
+    ) {
+        Table & t = _getTable(table);
+        std::map< std::string, size_t >::const_iterator mit = t.mIndex.find( feature.getId() );
+        if ( mit == t.mIndex.end() )
+            IGN_THROW_EXCEPTION( "[ app::io::MemoryDataSource ] Feature '"+feature.getId()+"' not found in table '"+table+"'." );
+
+        t.vFeatures[mit->second] = feature;
+    }
+
+    ///
+	///
+	///
+    epg::tools::MultiLineStringTool* MemoryDataSource::newMultiLineStringTool( 
+        std::string const& table, 
+        Query const& query 
+    ) {
+        std::vector< ign::feature::Feature > const& vFeatures = _getTable(table).vFeatures;
+
+        ign::geometry::MultiLineString mls;
+        for ( size_t i = 0 ; i < vFeatures.size() ; ++i ) {
+            if ( !query.matches( vFeatures[i] ) ) continue;
+            app::detail::addContours( vFeatures[i].getGeometry(), mls );
+        }
+        return new epg::tools::MultiLineStringTool( mls );
+    }
+
+    ///
+	///
+	///
+    void MemoryDataSource::createLineStringTable( 
+        std::string const& table 
+    ) {
+        clearTable( table );
+    }
+
+    ///
+	///
+	///
+    void MemoryDataSource::copyAreaTable( 
+        std::string const& fromTable, 
+        std::string const& toTable 
+    ) {
+        if ( fromTable == toTable ) return;
+        _mTables[toTable] = _getTable(fromTable);
+    }
+
+    ///
+	///
+	///
+    void MemoryDataSource::clearTable( std::string const& table )
+    {
+        Table & t = _mTables[table];
+        t.vFeatures.clear();
+        t.mIndex.clear();
+        t.nextId = 1;
+    }
+
+    ///
+	///
+	///
+    bool MemoryDataSource::hasTable( std::string const& table ) const
+    {
+        return _mTables.find( table ) != _mTables.end();
+    }
+
+    ///
+	///
+	///
+    std::vector< ign::feature::Feature > const& MemoryDataSource::getTable( std::string const& table ) const
+    {
+        std::map< std::string, Table >::const_iterator mit = _mTables.find( table );
+        if ( mit == _mTables.end() )
+            IGN_THROW_EXCEPTION( "[ app::io::MemoryDataSource ] Table '"+table+"' not found." );
+        return mit->second.vFeatures;
+    }
+
+    ///
+	///
+	///
+    MemoryDataSource::Table & MemoryDataSource::_getTable( std::string const& table )
+    {
+        std::map< std::string, Table >::iterator mit = _mTables.find( table );
+        if ( mit == _mTables.end() )
+            IGN_THROW_EXCEPTION( "[ app::io::MemoryDataSource ] Table '"+table+"' not found." );
+        return mit->second;
+    }
+
+}
+}
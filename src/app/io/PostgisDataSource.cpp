@@ -0,0 +1,315 @@
+// APP
+#include <app/io/PostgisDataSource.h>
+
+// STL
+#include <iomanip>
+
+// EPG
+#include <epg/Context.h>
+#include <epg/log/EpgLogger.h>
+#include <epg/params/EpgParameters.h>
+#include <epg/sql/DataBaseManager.h>
+#include <ome2/feature/sql/NotDestroyedTools.h>
+#include <ome2/utils/CopyTableUtils.h>
+
+
+namespace app{
+namespace io{
+namespace detail{
+
+    //--
+    std::string escape( std::string const& value )
+    {
+        std::string result;
+        for ( size_t i = 0 ; i < value.size() ; ++i ) {
+            if ( value[i] == '\'' ) result += '\'';
+            result += value[i];
+        }
+        return result;
+    }
+
+    //-- nom d'index (sans le schema eventuel de la table)
+    std::string indexName( std::string const& table, std::string const& suffix )
+    {
+        size_t pos = table.find_last_of( '.' );
+        return ( pos == std::string::npos ? table : table.substr( pos+1 ) ) + "_" + suffix;
+    }
+
+    //-- expression indexee des listes de codes ('fr#be')
+    std::string codeArray( std::string const& attribute )
+    {
+        return "string_to_array(" + attribute + "::text, '#')";
+    }
+
+    //--
+    class PostgisFeatureCursor : public FeatureCursor
+    {
+    public:
+        PostgisFeatureCursor( ign::feature::FeatureIteratorPtr it ):
+            _it( it )
+        {
+        }
+
+        virtual bool next( ign::feature::Feature & feature )
+        {
+            if ( !_it->hasNext() ) return false;
+            feature = _it->next();
+            return true;
+        }
+
+    private:
+        ign::feature::FeatureIteratorPtr                   _it;
+    };
+}
+
+    ///
+	///
+	///
+    PostgisDataSource::PostgisDataSource()
+    {
+    }
+
+    ///
+	///
+	///
+    PostgisDataSource::~PostgisDataSource()
+    {
+    }
+
+    ///
+	///
+	///
+    FeatureCursorPtr PostgisDataSource::getFeatures( 
+        std::string const& table, 
+        Query const& query 
+    ) {
+        ign::feature::FeatureIteratorPtr it = ome2::feature::sql::NotDestroyedTools::GetFeatures( *_getFeatureStore(table), ign::feature::FeatureFilter(toSql(table, query)) );
+        return FeatureCursorPtr( new detail::PostgisFeatureCursor( it ) );
+    }
+
+    ///
+	///
+	///
+    size_t PostgisDataSource::numFeatures( 
+        std::string const& table, 
+        Query const& query 
+    ) {
+        return ome2::feature::sql::NotDestroyedTools::NumFeatures( *_getFeatureStore(table), ign::feature::FeatureFilter(toSql(table, query)) );
+    }
+
+    ///
+	///
+	///
+    ign::feature::Feature PostgisDataSource::newFeature( 
+        std::string const& table 
+    ) {
+        return _getFeatureStore(table)->newFeature();
+    }
+
+    ///
+	///
+	///
+    void PostgisDataSource::createFeature( 
+        std::string const& table, 
+        ign::feature::Feature & feature 
+    ) {
+        _getFeatureStore(table)->createFeature( feature );
+    }
+
+    ///
+	///
+	///
+    void PostgisDataSource::modifyFeature( 
+        std::string const& table, 
+        ign::feature::Feature const& feature 
+    ) {
+        _getFeatureStore(table)->modifyFeature( feature );
+    }
+
+    ///
+	///
+	///
+    epg::tools::MultiLineStringTool* PostgisDataSource::newMultiLineStringTool( 
+        std::string const& table, 
+        Query const& query 
+    ) {
+        ign::feature::sql::FeatureStorePostgis* fs = _getFeatureStore(table);
+        return new epg::tools::MultiLineStringTool( ome2::feature::sql::NotDestroyedTools::GetFeatureFilter(toSql(table, query), fs), *fs );
+    }
+
+    ///
+	///
+	///
+    void PostgisDataSource::createLineStringTable( 
+        std::string const& table 
+    ) {
+        epg::Context* context = epg::ContextS::getInstance();
+
+        std::string const idName = context->getEpgParameters().getValue(ID).toString();
+	    std::string const geomName = context->getEpgParameters().getValue(GEOM).toString();
+        std::string const countryCodeName = context->getEpgParameters().getValue(COUNTRY_CODE).toString();
+
+        std::ostringstream ss;
+        ss << "DROP TABLE IF EXISTS " << table << " ;";
+
+        ss << "CREATE TABLE " << table
+            << " (" 
+            << idName << " uuid NOT NULL DEFAULT gen_random_uuid(), "
+            << countryCodeName << " varchar(255), "
+            << geomName << " geometry(LineString,3035)"
+            << ");"
+            << " CREATE INDEX IF NOT EXISTS " + detail::indexName(table, countryCodeName+"_idx") + " ON " + table
+            << " USING btree ("+countryCodeName+");"
+            << " CREATE INDEX IF NOT EXISTS " + detail::indexName(table, countryCodeName+"_codes_idx") + " ON " + table
+            << " USING gin ("+detail::codeArray(countryCodeName)+");";
+
+        context->getDataBaseManager().getConnection()->update(ss.str());
+        _sCodeIndexes.insert( table+"."+countryCodeName );
+    }
+
+    ///
+	///
+	///
+    void PostgisDataSource::copyAreaTable( 
+        std::string const& fromTable, 
+        std::string const& toTable 
+    ) {
+        if ( fromTable == toTable ) return;
+
+        // copie d'origine (CopyTableUtils) : la table cible est celle designee par le
+        // parametre AREA_TABLE, positionne le temps de la copie sur toTable
+        epg::params::EpgParameters & epgParams = epg::ContextS::getInstance()->getEpgParameters();
+        std::string const areaTable = epgParams.getValue( AREA_TABLE ).toString();
+
+        epgParams.setParameter( AREA_TABLE, ign::data::String( toTable ) );
+        try {
+            ome2::utils::CopyTableUtils::copyAreaTable( fromTable, "", false, true );
+        } catch ( ... ) {
+            epgParams.setParameter( AREA_TABLE, ign::data::String( areaTable ) );
+            throw;
+        }
+        epgParams.setParameter( AREA_TABLE, ign::data::String( areaTable ) );
+    }
+
+    ///
+	///
+	///
+    std::string PostgisDataSource::checksum( 
+        std::string const& table, 
+        Query const& query 
+    ) {
+        std::string const geomName = epg::ContextS::getInstance()->getEpgParameters().getValue( GEOM ).toString();
+        std::string const where = toSql( table, query );
+
+        // les empreintes des geometries sont triees : le resultat ne depend pas de l'ordre physique des lignes
+        std::string const sql = "SELECT count(*) || ':' || coalesce(md5(string_agg(h, '' ORDER BY h)), '') FROM ("
+            "SELECT md5(ST_AsBinary(" + geomName + ")) AS h FROM " + table + ( where.empty() ? "" : " WHERE " + where ) + ") AS t;";
+
+        ign::sql::SqlResultSetPtr result = epg::ContextS::getInstance()->getDataBaseManager().getConnection()->query( sql );
+        return result->getFieldValue(0,0).toString();
+    }
+
+    ///
+	///
+	///
+    std::string PostgisDataSource::toSql( std::string const& table, Query const& query )
+    {
+        std::vector< Condition > const& vConditions = query.getConditions();
+
+        std::string sql;
+        for ( size_t i = 0 ; i < vConditions.size() ; ++i ) {
+            if ( i > 0 ) sql += " AND ";
+            std::string const value = detail::escape( vConditions[i].value );
+            switch( vConditions[i].op )
+            {
+            case Condition::EQUALS :
+                sql += vConditions[i].attribute + " = '" + value + "'";
+                break;
+            case Condition::CONTAINS :
+                sql += vConditions[i].attribute + "::text LIKE '%" + value + "%'";
+                break;
+            case Condition::NOT_CONTAINS :
+                sql += vConditions[i].attribute + "::text NOT LIKE '%" + value + "%'";
+                break;
+            case Condition::CONTAINS_CODE :
+                sql += detail::codeArray( vConditions[i].attribute ) + " @> ARRAY['" + value + "']";
+                break;
+            }
+        }
+
+        std::vector< ign::geometry::Envelope > const& vEnvelopes = query.getEnvelopes();
+        if ( !vEnvelopes.empty() ) {
+            std::string const geomName = epg::ContextS::getInstance()->getEpgParameters().getValue( GEOM ).toString();
+            int const srid = _getSrid( table );
+
+            std::ostringstream ss;
+            ss << std::setprecision(15);
+            if ( !sql.empty() ) ss << " AND ";
+            ss << "(";
+            for ( size_t i = 0 ; i < vEnvelopes.size() ; ++i ) {
+                if ( i > 0 ) ss << " OR ";
+                ss << geomName << " && ST_MakeEnvelope(" 
+                    << vEnvelopes[i].xmin() << "," << vEnvelopes[i].ymin() << "," 
+                    << vEnvelopes[i].xmax() << "," << vEnvelopes[i].ymax() << "," << srid << ")";
+            }
+            ss << ")";
+            sql += ss.str();
+        }
+        return sql;
+    }
+
+    ///
+	///
+	///
+    void PostgisDataSource::createCodeIndex( 
+        std::string const& table, 
+        std::string const& attribute 
+    ) {
+        if ( !_sCodeIndexes.insert( table+"."+attribute ).second ) return;
+
+        std::string const sql = "CREATE INDEX IF NOT EXISTS " + detail::indexName(table, attribute+"_codes_idx") + " ON " + table
+            + " USING gin (" + detail::codeArray(attribute) + ");";
+        try {
+            epg::ContextS::getInstance()->getDataBaseManager().getConnection()->update(sql);
+        } catch ( ign::Exception const& e ) {
+            // droits insuffisants par exemple : la requete reste valide, sans index
+            epg::log::EpgLoggerS::getInstance()->log( epg::log::WARN, "unable to create code index on " + table + "." + attribute + " : " + e.diagnostic() );
+        }
+    }
+
+    ///
+	///
+	///
+    int PostgisDataSource::_getSrid( std::string const& table )
+    {
+        std::map< std::string, int >::const_iterator mit = _mSrids.find( table );
+        if ( mit != _mSrids.end() ) return mit->second;
+
+        std::string const geomName = epg::ContextS::getInstance()->getEpgParameters().getValue( GEOM ).toString();
+        ign::sql::SqlResultSetPtr result = epg::ContextS::getInstance()->getDataBaseManager().getConnection()->query(
+            "SELECT ST_SRID(" + geomName + ") FROM " + table + " LIMIT 1;"
+        );
+        int const srid = result->size() > 0 ? result->getFieldValue(0,0).toInteger() : 0;
+        _mSrids[table] = srid;
+        return srid;
+    }
+
+    ///
+	///
+	///
+    ign::feature::sql::FeatureStorePostgis* PostgisDataSource::_getFeatureStore( std::string const& table )
+    {
+        epg::Context* context = epg::ContextS::getInstance();
+        epg::params::EpgParameters const& epgParams = context->getEpgParameters();
+
+        if ( table == epgParams.getValue( TARGET_BOUNDARY_TABLE ).toString() )
+            return context->getFeatureStore( epg::TARGET_BOUNDARY );
+
+        std::string const idName = epgParams.getValue( ID ).toString();
+        std::string const geomName = epgParams.getValue( GEOM ).toString();
+
+        return context->getDataBaseManager().getFeatureStore(table, idName, geomName);
+    }
+
+}
+}
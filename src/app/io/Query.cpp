@@ -0,0 +1,149 @@
+//STL
+#include <sstream>
+
+// APP
+#include <app/io/Query.h>
+
+
+namespace app{
+namespace io{
+
+    ///
+	///
+	///
+    Query & Query::equals( std::string const& attribute, std::string const& value )
+    {
+        Condition condition = { attribute, Condition::EQUALS, value };
+        _vConditions.push_back( condition );
+        return *this;
+    }
+
+    ///
+	///
+	///
+    Query & Query::contains( std::string const& attribute, std::string const& value )
+    {
+        Condition condition = { attribute, Condition::CONTAINS, value };
+        _vConditions.push_back( condition );
+        return *this;
+    }
+
+    ///
+	///
+	///
+    Query & Query::notContains( std::string const& attribute, std::string const& value )
+    {
+        Condition condition = { attribute, Condition::NOT_CONTAINS, value };
+        _vConditions.push_back( condition );
+        return *this;
+    }
+
+    ///
+	///
+	///
+    Query & Query::containsCode( std::string const& attribute, std::string const& value )
+    {
+        Condition condition = { attribute, Condition::CONTAINS_CODE, value };
+        _vConditions.push_back( condition );
+        return *this;
+    }
+
+    ///
+	///
+	///
+    Query & Query::intersects( std::vector< ign::geometry::Envelope > const& vEnvelopes )
+    {
+        _vEnvelopes.insert( _vEnvelopes.end(), vEnvelopes.begin(), vEnvelopes.end() );
+        return *this;
+    }
+
+    ///
+	///
+	///
+    bool Query::matches( ign::feature::Feature const& feature ) const
+    {
+        for ( size_t i = 0 ; i < _vConditions.size() ; ++i ) {
+            std::string const value = feature.getAttribute( _vConditions[i].attribute ).toString();
+            switch( _vConditions[i].op )
+            {
+            case Condition::EQUALS :
+                if ( value != _vConditions[i].value ) return false;
+                break;
+            case Condition::CONTAINS :
+                if ( value.find( _vConditions[i].value ) == std::string::npos ) return false;
+                break;
+            case Condition::NOT_CONTAINS :
+                if ( value.find( _vConditions[i].value ) != std::string::npos ) return false;
+                break;
+            case Condition::CONTAINS_CODE :
+                if ( !hasCode( value, _vConditions[i].value ) ) return false;
+                break;
+            }
+        }
+
+        if ( _vEnvelopes.empty() ) return true;
+
+        ign::geometry::Envelope const envelope = feature.getGeometry().getEnvelope();
+        for ( size_t i = 0 ; i < _vEnvelopes.size() ; ++i )
+            if ( envelope.intersects( _vEnvelopes[i] ) ) return true;
+        return false;
+    }
+
+    ///
+	///
+	///
+    std::string Query::toString() const
+    {
+        std::string result;
+        for ( size_t i = 0 ; i < _vConditions.size() ; ++i ) {
+            if ( i > 0 ) result += " AND ";
+            switch( _vConditions[i].op )
+            {
+            case Condition::EQUALS :
+                result += _vConditions[i].attribute + " = '" + _vConditions[i].value + "'";
+                break;
+            case Condition::CONTAINS :
+                result += _vConditions[i].attribute + " CONTAINS '" + _vConditions[i].value + "'";
+                break;
+            case Condition::NOT_CONTAINS :
+                result += _vConditions[i].attribute + " NOT CONTAINS '" + _vConditions[i].value + "'";
+                break;
+            case Condition::CONTAINS_CODE :
+                result += _vConditions[i].attribute + " HAS CODE '" + _vConditions[i].value + "'";
+                break;
+            }
+        }
+        if ( !_vEnvelopes.empty() ) {
+            if ( !result.empty() ) result += " AND ";
+            // coordonnees completes (sans arrondi) : la representation sert aussi de
+            // cle aux enregistrements de lectures et aux fichiers de cache
+            std::ostringstream ss;
+            ss.precision( 17 );
+            ss << "INTERSECTS " << _vEnvelopes.size() << " ENVELOPES";
+            for ( size_t i = 0 ; i < _vEnvelopes.size() ; ++i ) {
+                ss << ( i == 0 ? " (" : ", " ) << _vEnvelopes[i].xmin() << " " << _vEnvelopes[i].ymin()
+                    << " " << _vEnvelopes[i].xmax() << " " << _vEnvelopes[i].ymax();
+            }
+            ss << ")";
+            result += ss.str();
+        }
+        return result;
+    }
+
+    ///
+	///
+	///
+    bool hasCode( std::string const& codes, std::string const& code )
+    {
+        size_t start = 0;
+        while ( start <= codes.size() ) {
+            size_t end = codes.find( '#', start );
+            if ( end == std::string::npos ) end = codes.size();
+            if ( codes.compare( start, end-start, code ) == 0 ) return true;
+            start = end+1;
+        }
+        return false;
+    }
+
+}
+}
@@ -0,0 +1,233 @@
+// APP
+#include <app/io/RecordingDataSource.h>
+#include <app/io/FeatureRecordFile.h>
+#include <app/detail/addContours.h>
+
+// STL
+#include <algorithm>
+#include <sstream>
+
+// SOCLE
+#include <ign/Exception.h>
+
+// BOOST
+#include <boost/filesystem.hpp>
+
+
+namespace app{
+namespace io{
+namespace detail{
+
+    //--
+    class RecordingFeatureCursor : public FeatureCursor
+    {
+    public:
+        RecordingFeatureCursor( FeatureCursorPtr cursor, std::string const& path, std::vector< std::string > const& vAttributes ):
+            _cursor( std::move( cursor ) ),
+            _writer( path, vAttributes )
+        {
+        }
+
+        virtual bool next( ign::feature::Feature & feature )
+        {
+            if ( !_cursor->next( feature ) ) return false;
+            _writer.write( feature );
+            return true;
+        }
+
+    private:
+        FeatureCursorPtr                                   _cursor;
+        FeatureRecordWriter                                _writer;
+    };
+}
+
+    ///
+	///
+	///
+    RecordingDataSource::RecordingDataSource(
+        DataSource* dataSource,
+        std::string const& directory,
+        std::vector< std::string > const& vAttributes
+    ):
+        _dataSource( dataSource ),
+        _directory( directory ),
+        _vAttributes( vAttributes ),
+        _numRecords( 0 )
+    {
+        boost::filesystem::create_directories( directory );
+
+        std::string const indexPath = directory + "/" + IndexFileName();
+        _index.open( indexPath.c_str(), std::ios::trunc );
+        if ( !_index )
+            IGN_THROW_EXCEPTION( "[ app::io::RecordingDataSource ] unable to create '" + indexPath + "'" );
+    }
+
+    ///
+	///
+	///
+    RecordingDataSource::~RecordingDataSource()
+    {
+        _index.close();
+        delete _dataSource;
+    }
+
+    ///
+	///
+	///
+    FeatureCursorPtr RecordingDataSource::getFeatures(
+        std::string const& table,
+        Query const& query
+    ) {
+        std::string const path = _addRecord( FEATURES, table, query );
+        return FeatureCursorPtr( new detail::RecordingFeatureCursor( _dataSource->getFeatures( table, query ), path, _getAttributes( query ) ) );
+    }
+
+    ///
+	///
+	///
+    size_t RecordingDataSource::numFeatures(
+        std::string const& table,
+        Query const& query
+    ) {
+        size_t count = _dataSource->numFeatures( table, query );
+        _index << Key( COUNT, table, query ) << "\t" << count << std::endl;
+        return count;
+    }
+
+    ///
+	///
+	///
+    ign::feature::Feature RecordingDataSource::newFeature(
+        std::string const& table
+    ) {
+        return _dataSource->newFeature( table );
+    }
+
+    ///
+	///
+	///
+    void RecordingDataSource::createFeature(
+        std::string const& table,
+        ign::feature::Feature & feature
+    ) {
+        _dataSource->createFeature( table, feature );
+    }
+
+    ///
+	///
+	///
+    void RecordingDataSource::modifyFeature(
+        std::string const& table,
+        ign::feature::Feature const& feature
+    ) {
+        _dataSource->modifyFeature( table, feature );
+    }
+
+    ///
+	///
+	///
+    epg::tools::MultiLineStringTool* RecordingDataSource::newMultiLineStringTool(
+        std::string const& table,
+        Query const& query
+    ) {
+        ign::geometry::MultiLineString mls;
+
+        FeatureCursorPtr cursor = _dataSource->getFeatures( table, query );
+        ign::feature::Feature feature;
+        while ( cursor->next( feature ) )
+            app::detail::addContours( feature.getGeometry(), mls );
+
+        // les contours sont enregistres sous la forme d'un unique objet
+        ign::feature::Feature fContours;
+        fContours.setGeometry( mls );
+        FeatureRecordWriter writer( _addRecord( CONTOURS, table, query ), std::vector< std::string >() );
+        writer.write( fContours );
+
+        return new epg::tools::MultiLineStringTool( mls );
+    }
+
+    ///
+	///
+	///
+    void RecordingDataSource::createLineStringTable(
+        std::string const& table
+    ) {
+        _dataSource->createLineStringTable( table );
+    }
+
+    ///
+	///
+	///
+    void RecordingDataSource::copyAreaTable(
+        std::string const& fromTable,
+        std::string const& toTable
+    ) {
+        _dataSource->copyAreaTable( fromTable, toTable );
+    }
+
+    ///
+	///
+	///
+    void RecordingDataSource::createCodeIndex(
+        std::string const& table,
+        std::string const& attribute
+    ) {
+        _dataSource->createCodeIndex( table, attribute );
+    }
+
+    ///
+	///
+	///
+    std::string RecordingDataSource::checksum(
+        std::string const& table,
+        Query const& query
+    ) {
+        std::string const value = _dataSource->checksum( table, query );
+        _index << Key( CHECKSUM, table, query ) << "\t" << value << std::endl;
+        return value;
+    }
+
+    ///
+	///
+	///
+    void RecordingDataSource::commit()
+    {
+        _dataSource->commit();
+    }
+
+    ///
+	///
+	///
+    std::string RecordingDataSource::Key( ReadType type, std::string const& table, Query const& query )
+    {
+        static const char* typeNames[4] = { "FEATURES", "CONTOURS", "COUNT", "CHECKSUM" };
+        return std::string( typeNames[type] ) + "\t" + table + "\t" + query.toString();
+    }
+
+    ///
+	///
+	///
+    std::string RecordingDataSource::_addRecord( ReadType type, std::string const& table, Query const& query )
+    {
+        std::ostringstream ss;
+        ss << "record_" << _numRecords++ << ".bin";
+
+        _index << Key( type, table, query ) << "\t" << ss.str() << std::endl;
+        return _directory + "/" + ss.str();
+    }
+
+    ///
+	///
+	///
+    std::vector< std::string > RecordingDataSource::_getAttributes( Query const& query ) const
+    {
+        std::vector< std::string > vAttributes = _vAttributes;
+        std::vector< Condition > const& vConditions = query.getConditions();
+        for ( size_t i = 0 ; i < vConditions.size() ; ++i )
+            if ( std::find( vAttributes.begin(), vAttributes.end(), vConditions[i].attribute ) == vAttributes.end() )
+                vAttributes.push_back( vConditions[i].attribute );
+        return vAttributes;
+    }
+
+}
+}
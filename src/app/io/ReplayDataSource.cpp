@@ -0,0 +1,159 @@
+// APP
+#include <app/io/ReplayDataSource.h>
+#include <app/io/RecordingDataSource.h>
+#include <app/io/FeatureRecordFile.h>
+
+// STL
+#include <fstream>
+
+// SOCLE
+#include <ign/Exception.h>
+
+// BOOST
+#include <boost/lexical_cast.hpp>
+
+
+namespace app{
+namespace io{
+
+    ///
+	///
+	///
+    ReplayDataSource::ReplayDataSource( std::string const& directory ):
+        _directory( directory ),
+        _nextId( 0 )
+    {
+        std::string const indexPath = directory + "/" + RecordingDataSource::IndexFileName();
+        std::ifstream index( indexPath.c_str() );
+        if ( !index )
+            IGN_THROW_EXCEPTION( "[ app::io::ReplayDataSource ] unable to open '" + indexPath + "'" );
+
+        // chaque ligne : cle (type, table, requete) puis fichier, comptage ou empreinte
+        std::string line;
+        while ( std::getline( index, line ) ) {
+            size_t pos = line.find_last_of( '\t' );
+            if ( pos == std::string::npos ) continue;
+            Records & records = _mRecords[line.substr( 0, pos )];
+            if ( records.vValues.empty() ) records.next = 0;
+            records.vValues.push_back( line.substr( pos+1 ) );
+        }
+    }
+
+    ///
+	///
+	///
+    ReplayDataSource::~ReplayDataSource()
+    {
+    }
+
+    ///
+	///
+	///
+    FeatureCursorPtr ReplayDataSource::getFeatures(
+        std::string const& table,
+        Query const& query
+    ) {
+        std::string const& file = _nextRecord( RecordingDataSource::Key( RecordingDataSource::FEATURES, table, query ) );
+        return FeatureCursorPtr( new FeatureRecordReader( _directory + "/" + file ) );
+    }
+
+    ///
+	///
+	///
+    size_t ReplayDataSource::numFeatures(
+        std::string const& table,
+        Query const& query
+    ) {
+        return boost::lexical_cast< size_t >( _nextRecord( RecordingDataSource::Key( RecordingDataSource::COUNT, table, query ) ) );
+    }
+
+    ///
+	///
+	///
+    ign::feature::Feature ReplayDataSource::newFeature(
+        std::string const& table
+    ) {
+        return ign::feature::Feature();
+    }
+
+    ///
+	///
+	///
+    void ReplayDataSource::createFeature(
+        std::string const& table,
+        ign::feature::Feature & feature
+    ) {
+        if ( feature.getId().empty() )
+            feature.setId( boost::lexical_cast<std::string>( _nextId++ ) );
+    }
+
+    ///
+	///
+	///
+    void ReplayDataSource::modifyFeature(
+        std::string const& table,
+        ign::feature::Feature const& feature
+    ) {
+    }
+
+    ///
+	///
+	///
+    epg::tools::MultiLineStringTool* ReplayDataSource::newMultiLineStringTool(
+        std::string const& table,
+        Query const& query
+    ) {
+        std::string const& file = _nextRecord( RecordingDataSource::Key( RecordingDataSource::CONTOURS, table, query ) );
+
+        FeatureRecordReader reader( _directory + "/" + file );
+        ign::feature::Feature fContours;
+        if ( !reader.next( fContours ) )
+            IGN_THROW_EXCEPTION( "[ app::io::ReplayDataSource ] empty contour record '" + file + "'" );
+
+        return new epg::tools::MultiLineStringTool( fContours.getGeometry().asMultiLineString() );
+    }
+
+    ///
+	///
+	///
+    void ReplayDataSource::createLineStringTable(
+        std::string const& table
+    ) {
+    }
+
+    ///
+	///
+	///
+    void ReplayDataSource::copyAreaTable(
+        std::string const& fromTable,
+        std::string const& toTable
+    ) {
+    }
+
+    ///
+	///
+	///
+    std::string ReplayDataSource::checksum(
+        std::string const& table,
+        Query const& query
+    ) {
+        return _nextRecord( RecordingDataSource::Key( RecordingDataSource::CHECKSUM, table, query ) );
+    }
+
+    ///
+	///
+	///
+    std::string const& ReplayDataSource::_nextRecord( std::string const& key )
+    {
+        std::map< std::string, Records >::iterator mit = _mRecords.find( key );
+        if ( mit == _mRecords.end() )
+            IGN_THROW_EXCEPTION( "[ app::io::ReplayDataSource ] no recorded read for '" + key + "' in '" + _directory + "'" );
+
+        Records & records = mit->second;
+        std::string const& value = records.vValues[records.next];
+        if ( records.next + 1 < records.vValues.size() ) ++records.next;
+        return value;
+    }
+
+}
+}
@@ -0,0 +1,147 @@
+// APP
+#include <app/io/ResultManifest.h>
+
+// SOCLE
+#include <ign/Exception.h>
+
+// BOOST
+#include <boost/filesystem.hpp>
+
+// EPG
+#include <epg/log/EpgLogger.h>
+
+
+namespace app{
+namespace io{
+namespace detail{
+
+    //--
+    const std::string MANIFEST_HASH = "manifest_hash";
+
+    //--
+    const std::string MANIFEST_WRITTEN = "manifest_written";
+
+    //--
+    std::string tmpManifestPath( std::string const& path )
+    {
+        return path + ".tmp";
+    }
+}
+
+    ///
+	///
+	///
+    ResultManifest::ResultManifest( std::string const& path ):
+        _path( path ),
+        _numReused( 0 )
+    {
+        if ( !isEnabled() ) return;
+
+        if ( boost::filesystem::exists( path ) ) {
+            // un manifeste illisible est ignore : tous les objets sont recalcules
+            try {
+                FeatureRecordReader reader( path );
+                ign::feature::Feature feature;
+                while ( reader.next( feature ) ) {
+                    Entry & entry = _mPrevious[feature.getId()];
+                    entry.hash = feature.getAttribute( detail::MANIFEST_HASH ).toString();
+                    entry.written = feature.getAttribute( detail::MANIFEST_WRITTEN ).toString() == "1";
+                    entry.feature = feature;
+                }
+            } catch ( ign::Exception const& e ) {
+                epg::log::EpgLoggerS::getInstance()->log( epg::log::WARN, "invalid manifest ignored : " + path + " : " + e.diagnostic() );
+                _mPrevious.clear();
+            }
+        }
+
+        boost::filesystem::path const parent = boost::filesystem::path( path ).parent_path();
+        if ( !parent.empty() ) boost::filesystem::create_directories( parent );
+
+        std::vector< std::string > vAttributes;
+        vAttributes.push_back( detail::MANIFEST_HASH );
+        vAttributes.push_back( detail::MANIFEST_WRITTEN );
+        _writer.reset( new FeatureRecordWriter( detail::tmpManifestPath( path ), vAttributes ) );
+    }
+
+    ///
+	///
+	///
+    ResultManifest::~ResultManifest()
+    {
+        if ( !_writer ) return;
+
+        _writer.reset();
+        boost::system::error_code ec;
+        boost::filesystem::remove( detail::tmpManifestPath( _path ), ec );
+    }
+
+    ///
+	///
+	///
+    bool ResultManifest::find(
+        ign::feature::Feature & feature,
+        std::string const& hash,
+        bool & written
+    ) {
+        if ( !isEnabled() ) return false;
+
+        std::map< std::string, Entry >::iterator mit = _mPrevious.find( feature.getId() );
+        if ( mit == _mPrevious.end() || mit->second.hash != hash ) return false;
+
+        feature.setGeometry( mit->second.feature.getGeometry() );
+        written = mit->second.written;
+        add( feature, hash, written );
+
+        _mPrevious.erase( mit );
+        ++_numReused;
+        return true;
+    }
+
+    ///
+	///
+	///
+    void ResultManifest::add(
+        ign::feature::Feature const& feature,
+        std::string const& hash,
+        bool written
+    ) {
+        if ( !isEnabled() ) return;
+
+        ign::feature::Feature entry;
+        entry.setId( feature.getId() );
+        entry.setAttribute( detail::MANIFEST_HASH, ign::data::String( hash ) );
+        entry.setAttribute( detail::MANIFEST_WRITTEN, ign::data::String( written ? "1" : "0" ) );
+        entry.setGeometry( feature.getGeometry() );
+        _writer->write( entry );
+    }
+
+    ///
+	///
+	///
+    void ResultManifest::carryForward(
+        std::string const& id
+    ) {
+        if ( !isEnabled() ) return;
+
+        // l'empreinte enregistree decrit les entrees du resultat enregistre : si elles
+        // ont change depuis, l'objet sera recalcule lors de l'execution suivante
+        std::map< std::string, Entry >::iterator mit = _mPrevious.find( id );
+        if ( mit == _mPrevious.end() ) return;
+
+        add( mit->second.feature, mit->second.hash, mit->second.written );
+        _mPrevious.erase( mit );
+    }
+
+    ///
+	///
+	///
+    void ResultManifest::commit()
+    {
+        if ( !_writer ) return;
+
+        _writer.reset();
+        boost::filesystem::rename( detail::tmpManifestPath( _path ), _path );
+    }
+
+}
+}
@@ -0,0 +1,330 @@
+// APP
+#include <app/io/SnapshotDataSource.h>
+#include <app/io/FeatureRecordFile.h>
+#include <app/detail/addContours.h>
+
+// STL
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <memory>
+
+// SOCLE
+#include <ign/Exception.h>
+
+// BOOST
+#include <boost/filesystem.hpp>
+
+// EPG
+#include <epg/tools/StringTools.h>
+
+
+namespace app{
+namespace io{
+namespace detail{
+
+    //--
+    const std::string SNAPSHOT_HEADER = "AUSN 1";
+
+    //-- parcours des partitions d'une table filtre par la requete
+    class SnapshotFeatureCursor : public FeatureCursor
+    {
+    public:
+        SnapshotFeatureCursor( std::vector< std::string > const& vPaths, Query const& query, bool distinct ):
+            _vPaths( vPaths ),
+            _query( query ),
+            _distinct( distinct ),
+            _current( 0 )
+        {
+        }
+
+        virtual bool next( ign::feature::Feature & feature )
+        {
+            while ( true ) {
+                if ( !_reader ) {
+                    if ( _current >= _vPaths.size() ) return false;
+                    _reader.reset( new FeatureRecordReader( _vPaths[_current++] ) );
+                }
+                if ( !_reader->next( feature ) ) {
+                    _reader.reset();
+                    continue;
+                }
+                if ( !_query.matches( feature ) ) continue;
+                // un objet a plusieurs codes figure dans plusieurs partitions
+                if ( _distinct && !_sIds.insert( feature.getId() ).second ) continue;
+                return true;
+            }
+        }
+
+    private:
+        std::vector< std::string >                         _vPaths;
+        Query                                              _query;
+        bool                                               _distinct;
+        size_t                                             _current;
+        std::unique_ptr< FeatureRecordReader >             _reader;
+        std::set< std::string >                            _sIds;
+    };
+
+    //--
+    bool isValidCode( std::string const& code )
+    {
+        if ( code.empty() ) return false;
+        for ( size_t i = 0 ; i < code.size() ; ++i )
+            if ( !std::isalnum( static_cast< unsigned char >( code[i] ) ) && code[i] != '_' && code[i] != '-' ) return false;
+        return true;
+    }
+}
+
+    ///
+	///
+	///
+    SnapshotDataSource::SnapshotDataSource(
+        DataSource* dataSource,
+        std::string const& directory
+    ):
+        _dataSource( dataSource ),
+        _directory( directory )
+    {
+        std::string const indexPath = directory + "/" + IndexFileName();
+        std::ifstream index( indexPath.c_str() );
+        std::string line;
+        if ( !index || !std::getline( index, line ) || line != detail::SNAPSHOT_HEADER )
+            IGN_THROW_EXCEPTION( "[ app::io::SnapshotDataSource ] '" + indexPath + "' is not a snapshot index" );
+
+        // chaque ligne : table, attribut de partition, sous-repertoire
+        while ( std::getline( index, line ) ) {
+            std::vector< std::string > vFields;
+            epg::tools::StringTools::Split( line, "\t", vFields );
+            if ( vFields.size() != 3 ) continue;
+
+            SnapshotTable & snapshotTable = _mTables[vFields[0]];
+            snapshotTable.partitionAttribute = vFields[1];
+            snapshotTable.directory = directory + "/" + vFields[2];
+        }
+    }
+
+    ///
+	///
+	///
+    SnapshotDataSource::~SnapshotDataSource()
+    {
+        delete _dataSource;
+    }
+
+    ///
+	///
+	///
+    void SnapshotDataSource::Build(
+        DataSource & dataSource,
+        std::string const& directory,
+        std::vector< TableSpec > const& vTables,
+        std::set< std::string > const& sCodes,
+        std::vector< std::string > const& vAttributes
+    ) {
+        boost::filesystem::create_directories( directory );
+
+        std::string const indexPath = directory + "/" + IndexFileName();
+        std::ofstream index( indexPath.c_str(), std::ios::trunc );
+        if ( !index )
+            IGN_THROW_EXCEPTION( "[ app::io::SnapshotDataSource ] unable to create '" + indexPath + "'" );
+        index << detail::SNAPSHOT_HEADER << std::endl;
+
+        for ( size_t t = 0 ; t < vTables.size() ; ++t ) {
+            TableSpec const& spec = vTables[t];
+
+            std::string const subDirectory = "table_" + std::to_string( t );
+            boost::filesystem::create_directories( directory + "/" + subDirectory );
+
+            std::vector< std::string > vTableAttributes = vAttributes;
+            if ( std::find( vTableAttributes.begin(), vTableAttributes.end(), spec.partitionAttribute ) == vTableAttributes.end() )
+                vTableAttributes.push_back( spec.partitionAttribute );
+
+            std::map< std::string, std::shared_ptr< FeatureRecordWriter > > mWriters;
+
+            FeatureCursorPtr cursor = dataSource.getFeatures( spec.table, Query() );
+            ign::feature::Feature feature;
+            while ( cursor->next( feature ) ) {
+                std::vector< std::string > vCodes;
+                epg::tools::StringTools::Split( feature.getAttribute( spec.partitionAttribute ).toString(), "#", vCodes );
+
+                for ( size_t i = 0 ; i < vCodes.size() ; ++i ) {
+                    if ( !detail::isValidCode( vCodes[i] ) ) continue;
+                    if ( !sCodes.empty() && sCodes.find( vCodes[i] ) == sCodes.end() ) continue;
+
+                    std::shared_ptr< FeatureRecordWriter > & writer = mWriters[vCodes[i]];
+                    if ( !writer ) writer.reset( new FeatureRecordWriter( directory + "/" + subDirectory + "/" + vCodes[i] + ".bin", vTableAttributes ) );
+                    writer->write( feature );
+                }
+            }
+
+            index << spec.table << "\t" << spec.partitionAttribute << "\t" << subDirectory << std::endl;
+        }
+    }
+
+    ///
+	///
+	///
+    FeatureCursorPtr SnapshotDataSource::getFeatures(
+        std::string const& table,
+        Query const& query
+    ) {
+        SnapshotTable const* snapshotTable = _getTable( table );
+        if ( !snapshotTable ) return _dataSource->getFeatures( table, query );
+
+        // partition designee par la requete
+        std::vector< Condition > const& vConditions = query.getConditions();
+        for ( size_t i = 0 ; i < vConditions.size() ; ++i ) {
+            if ( vConditions[i].attribute != snapshotTable->partitionAttribute ) continue;
+            if ( vConditions[i].op != Condition::EQUALS && vConditions[i].op != Condition::CONTAINS_CODE ) continue;
+
+            std::vector< std::string > vPaths;
+            std::string const path = snapshotTable->directory + "/" + vConditions[i].value + ".bin";
+            if ( detail::isValidCode( vConditions[i].value ) && boost::filesystem::exists( path ) ) vPaths.push_back( path );
+            return FeatureCursorPtr( new detail::SnapshotFeatureCursor( vPaths, query, false ) );
+        }
+
+        // sinon parcours de toutes les partitions
+        std::vector< std::string > vPaths;
+        for ( boost::filesystem::directory_iterator it( snapshotTable->directory ) ; it != boost::filesystem::directory_iterator() ; ++it )
+            vPaths.push_back( it->path().string() );
+        std::sort( vPaths.begin(), vPaths.end() );
+        return FeatureCursorPtr( new detail::SnapshotFeatureCursor( vPaths, query, true ) );
+    }
+
+    ///
+	///
+	///
+    size_t SnapshotDataSource::numFeatures(
+        std::string const& table,
+        Query const& query
+    ) {
+        if ( !_getTable( table ) ) return _dataSource->numFeatures( table, query );
+
+        size_t count = 0;
+        FeatureCursorPtr cursor = getFeatures( table, query );
+        ign::feature::Feature feature;
+        while ( cursor->next( feature ) ) ++count;
+        return count;
+    }
+
+    ///
+	///
+	///
+    ign::feature::Feature SnapshotDataSource::newFeature(
+        std::string const& table
+    ) {
+        _checkWritable( table );
+        return _dataSource->newFeature( table );
+    }
+
+    ///
+	///
+	///
+    void SnapshotDataSource::createFeature(
+        std::string const& table,
+        ign::feature::Feature & feature
+    ) {
+        _checkWritable( table );
+        _dataSource->createFeature( table, feature );
+    }
+
+    ///
+	///
+	///
+    void SnapshotDataSource::modifyFeature(
+        std::string const& table,
+        ign::feature::Feature const& feature
+    ) {
+        _checkWritable( table );
+        _dataSource->modifyFeature( table, feature );
+    }
+
+    ///
+	///
+	///
+    epg::tools::MultiLineStringTool* SnapshotDataSource::newMultiLineStringTool(
+        std::string const& table,
+        Query const& query
+    ) {
+        if ( !_getTable( table ) ) return _dataSource->newMultiLineStringTool( table, query );
+
+        ign::geometry::MultiLineString mls;
+        FeatureCursorPtr cursor = getFeatures( table, query );
+        ign::feature::Feature feature;
+        while ( cursor->next( feature ) )
+            app::detail::addContours( feature.getGeometry(), mls );
+        return new epg::tools::MultiLineStringTool( mls );
+    }
+
+    ///
+	///
+	///
+    void SnapshotDataSource::createLineStringTable(
+        std::string const& table
+    ) {
+        _checkWritable( table );
+        _dataSource->createLineStringTable( table );
+    }
+
+    ///
+	///
+	///
+    void SnapshotDataSource::copyAreaTable(
+        std::string const& fromTable,
+        std::string const& toTable
+    ) {
+        _checkWritable( toTable );
+        _dataSource->copyAreaTable( fromTable, toTable );
+    }
+
+    ///
+	///
+	///
+    void SnapshotDataSource::createCodeIndex(
+        std::string const& table,
+        std::string const& attribute
+    ) {
+        // les tables de l'instantane sont partitionnees par pays
+        if ( _getTable( table ) ) return;
+        _dataSource->createCodeIndex( table, attribute );
+    }
+
+    ///
+	///
+	///
+    std::string SnapshotDataSource::checksum(
+        std::string const& table,
+        Query const& query
+    ) {
+        if ( _getTable( table ) ) return DataSource::checksum( table, query );
+        return _dataSource->checksum( table, query );
+    }
+
+    ///
+	///
+	///
+    void SnapshotDataSource::commit()
+    {
+        _dataSource->commit();
+    }
+
+    ///
+	///
+	///
+    SnapshotDataSource::SnapshotTable const* SnapshotDataSource::_getTable( std::string const& table ) const
+    {
+        std::map< std::string, SnapshotTable >::const_iterator mit = _mTables.find( table );
+        return mit == _mTables.end() ? 0 : &mit->second;
+    }
+
+    ///
+	///
+	///
+    void SnapshotDataSource::_checkWritable( std::string const& table ) const
+    {
+        if ( _getTable( table ) )
+            IGN_THROW_EXCEPTION( "[ app::io::SnapshotDataSource ] snapshot table '" + table + "' is read only" );
+    }
+
+}
+}
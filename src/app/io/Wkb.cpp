@@ -0,0 +1,297 @@
+// APP
+#include <app/io/Wkb.h>
+
+// STL
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+// SOCLE
+#include <ign/Exception.h>
+
+
+namespace app{
+namespace io{
+namespace detail{
+
+    //--
+    enum WkbType {
+        WKB_POINT = 1,
+        WKB_LINESTRING = 2,
+        WKB_POLYGON = 3,
+        WKB_MULTILINESTRING = 5,
+        WKB_MULTIPOLYGON = 6
+    };
+
+    //--
+    void writeUInt32( uint32_t value, std::string & buffer )
+    {
+        char bytes[4];
+        for ( size_t i = 0 ; i < 4 ; ++i ) bytes[i] = static_cast< char >( ( value >> ( 8 * i ) ) & 0xFF );
+        buffer.append( bytes, 4 );
+    }
+
+    //--
+    void writeDouble( double value, std::string & buffer )
+    {
+        uint64_t bits;
+        std::memcpy( &bits, &value, 8 );
+        char bytes[8];
+        for ( size_t i = 0 ; i < 8 ; ++i ) bytes[i] = static_cast< char >( ( bits >> ( 8 * i ) ) & 0xFF );
+        buffer.append( bytes, 8 );
+    }
+
+    //--
+    void writeHeader( WkbType type, std::string & buffer )
+    {
+        buffer.push_back( 1 ); // little endian
+        writeUInt32( type, buffer );
+    }
+
+    //--
+    void writePoints( ign::geometry::LineString const& ls, std::string & buffer )
+    {
+        writeUInt32( static_cast< uint32_t >( ls.numPoints() ), buffer );
+        for ( size_t i = 0 ; i < ls.numPoints() ; ++i ) {
+            writeDouble( ls.pointN(i).x(), buffer );
+            writeDouble( ls.pointN(i).y(), buffer );
+        }
+    }
+
+    //--
+    void writePolygon( ign::geometry::Polygon const& polygon, std::string & buffer )
+    {
+        writeHeader( WKB_POLYGON, buffer );
+        writeUInt32( static_cast< uint32_t >( polygon.numRings() ), buffer );
+        for ( size_t i = 0 ; i < polygon.numRings() ; ++i )
+            writePoints( polygon.ringN(i), buffer );
+    }
+
+    //--
+    class WkbReader
+    {
+    public:
+        WkbReader( unsigned char const* data, size_t size ):
+            _data( data ),
+            _size( size ),
+            _pos( 0 ),
+            _littleEndian( true )
+        {
+        }
+
+        size_t position() const { return _pos; }
+
+        ign::geometry::Geometry* readGeometry()
+        {
+            size_t numOrdinates = 2;
+            WkbType type = _readHeader( numOrdinates );
+            switch( type )
+            {
+            case WKB_POINT :
+                {
+                    std::unique_ptr< ign::geometry::Point > point( new ign::geometry::Point() );
+                    *point = _readPoint( numOrdinates );
+                    return point.release();
+                }
+            case WKB_LINESTRING :
+                {
+                    std::unique_ptr< ign::geometry::LineString > ls( new ign::geometry::LineString() );
+                    _readPoints( numOrdinates, *ls );
+                    return ls.release();
+                }
+            case WKB_POLYGON :
+                {
+                    std::unique_ptr< ign::geometry::Polygon > polygon( new ign::geometry::Polygon() );
+                    _readPolygonBody( numOrdinates, *polygon );
+                    return polygon.release();
+                }
+            case WKB_MULTILINESTRING :
+                {
+                    std::unique_ptr< ign::geometry::MultiLineString > mls( new ign::geometry::MultiLineString() );
+                    uint32_t const numGeometries = _readUInt32();
+                    for ( uint32_t i = 0 ; i < numGeometries ; ++i ) {
+                        size_t numSubOrdinates = 2;
+                        if ( _readHeader( numSubOrdinates ) != WKB_LINESTRING ) _throw( "MultiLineString member is not a LineString" );
+                        ign::geometry::LineString ls;
+                        _readPoints( numSubOrdinates, ls );
+                        mls->addGeometry( ls );
+                    }
+                    return mls.release();
+                }
+            case WKB_MULTIPOLYGON :
+                {
+                    std::unique_ptr< ign::geometry::MultiPolygon > mp( new ign::geometry::MultiPolygon() );
+                    uint32_t const numGeometries = _readUInt32();
+                    for ( uint32_t i = 0 ; i < numGeometries ; ++i ) {
+                        size_t numSubOrdinates = 2;
+                        if ( _readHeader( numSubOrdinates ) != WKB_POLYGON ) _throw( "MultiPolygon member is not a Polygon" );
+                        ign::geometry::Polygon polygon;
+                        _readPolygonBody( numSubOrdinates, polygon );
+                        mp->addGeometry( polygon );
+                    }
+                    return mp.release();
+                }
+            }
+            _throw( "unsupported geometry type" );
+            return 0;
+        }
+
+    private:
+
+        //--
+        void _throw( std::string const& message ) const
+        {
+            IGN_THROW_EXCEPTION( "[ app::io::Wkb ] " + message );
+        }
+
+        //--
+        void _check( size_t n ) const
+        {
+            if ( _pos + n > _size ) _throw( "unexpected end of buffer" );
+        }
+
+        //--
+        uint32_t _readUInt32()
+        {
+            _check( 4 );
+            uint32_t value = 0;
+            for ( size_t i = 0 ; i < 4 ; ++i ) {
+                uint32_t const byte = _data[_pos + ( _littleEndian ? i : 3 - i )];
+                value |= byte << ( 8 * i );
+            }
+            _pos += 4;
+            return value;
+        }
+
+        //--
+        double _readDouble()
+        {
+            _check( 8 );
+            uint64_t bits = 0;
+            for ( size_t i = 0 ; i < 8 ; ++i ) {
+                uint64_t const byte = _data[_pos + ( _littleEndian ? i : 7 - i )];
+                bits |= byte << ( 8 * i );
+            }
+            _pos += 8;
+            double value;
+            std::memcpy( &value, &bits, 8 );
+            return value;
+        }
+
+        //-- lit l'ordre des octets et le type (ISO : +1000 Z, +2000 M, +3000 ZM ; EWKB : drapeaux)
+        WkbType _readHeader( size_t & numOrdinates )
+        {
+            _check( 1 );
+            _littleEndian = _data[_pos++] == 1;
+            uint32_t type = _readUInt32();
+
+            numOrdinates = 2;
+            if ( type & 0x80000000 ) ++numOrdinates;
+            if ( type & 0x40000000 ) ++numOrdinates;
+            if ( type & 0x20000000 ) {
+                _readUInt32(); // srid EWKB
+            }
+            type &= 0x0FFFFFFF;
+
+            if ( type >= 3000 ) { numOrdinates = 4; type -= 3000; }
+            else if ( type >= 2000 ) { numOrdinates = 3; type -= 2000; }
+            else if ( type >= 1000 ) { numOrdinates = 3; type -= 1000; }
+
+            return static_cast< WkbType >( type );
+        }
+
+        //--
+        ign::geometry::Point _readPoint( size_t numOrdinates )
+        {
+            double const x = _readDouble();
+            double const y = _readDouble();
+            for ( size_t k = 2 ; k < numOrdinates ; ++k ) _readDouble();
+            return ign::geometry::Point( x, y );
+        }
+
+        //--
+        void _readPoints( size_t numOrdinates, ign::geometry::LineString & ls )
+        {
+            uint32_t const numPoints = _readUInt32();
+            _check( static_cast< size_t >( numPoints ) * numOrdinates * 8 );
+            ls.reserve( numPoints );
+            for ( uint32_t i = 0 ; i < numPoints ; ++i )
+                ls.addPoint( _readPoint( numOrdinates ) );
+        }
+
+        //--
+        void _readPolygonBody( size_t numOrdinates, ign::geometry::Polygon & polygon )
+        {
+            uint32_t const numRings = _readUInt32();
+            for ( uint32_t i = 0 ; i < numRings ; ++i ) {
+                ign::geometry::LineString ring;
+                _readPoints( numOrdinates, ring );
+                if ( i == 0 ) polygon = ign::geometry::Polygon( ring );
+                else polygon.addInteriorRing( ring );
+            }
+        }
+
+    private:
+        unsigned char const*                               _data;
+        size_t                                             _size;
+        size_t                                             _pos;
+        bool                                               _littleEndian;
+    };
+}
+
+    ///
+	///
+	///
+    void Wkb::Write( 
+        ign::geometry::Geometry const& geom, 
+        std::string & buffer 
+    ) {
+        switch( geom.getGeometryType() )
+        {
+        case ign::geometry::Geometry::GeometryTypePoint :
+            detail::writeHeader( detail::WKB_POINT, buffer );
+            detail::writeDouble( geom.asPoint().x(), buffer );
+            detail::writeDouble( geom.asPoint().y(), buffer );
+            break;
+        case ign::geometry::Geometry::GeometryTypeLineString :
+            detail::writeHeader( detail::WKB_LINESTRING, buffer );
+            detail::writePoints( geom.asLineString(), buffer );
+            break;
+        case ign::geometry::Geometry::GeometryTypePolygon :
+            detail::writePolygon( geom.asPolygon(), buffer );
+            break;
+        case ign::geometry::Geometry::GeometryTypeMultiLineString :
+            detail::writeHeader( detail::WKB_MULTILINESTRING, buffer );
+            detail::writeUInt32( static_cast< uint32_t >( geom.asMultiLineString().numGeometries() ), buffer );
+            for ( size_t i = 0 ; i < geom.asMultiLineString().numGeometries() ; ++i ) {
+                detail::writeHeader( detail::WKB_LINESTRING, buffer );
+                detail::writePoints( geom.asMultiLineString().lineStringN(i), buffer );
+            }
+            break;
+        case ign::geometry::Geometry::GeometryTypeMultiPolygon :
+            detail::writeHeader( detail::WKB_MULTIPOLYGON, buffer );
+            detail::writeUInt32( static_cast< uint32_t >( geom.asMultiPolygon().numGeometries() ), buffer );
+            for ( size_t i = 0 ; i < geom.asMultiPolygon().numGeometries() ; ++i )
+                detail::writePolygon( geom.asMultiPolygon().polygonN(i), buffer );
+            break;
+        default :
+            IGN_THROW_EXCEPTION( "[ app::io::Wkb ] Geometry type '"+ign::geometry::Geometry::GeometryTypeName(geom.getGeometryType())+"' not allowed." );
+        }
+    }
+
+    ///
+	///
+	///
+    ign::geometry::Geometry* Wkb::Read( 
+        unsigned char const* data, 
+        size_t size,
+        size_t* readSize
+    ) {
+        detail::WkbReader reader( data, size );
+        ign::geometry::Geometry* geom = reader.readGeometry();
+        if ( readSize ) *readSize = reader.position();
+        return geom;
+    }
+
+}
+}
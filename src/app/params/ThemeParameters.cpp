@@ -17,6 +17,10 @@ namespace params{
 	{
 		_initParameter( DB_CONF_FILE, "DB_CONF_FILE" );
 		_initParameter( WORKING_SCHEMA, "WORKING_SCHEMA" );
+		_initParameter( DATA_SOURCE, "DATA_SOURCE" );
+		_initParameter( DATA_SOURCE_FILE, "DATA_SOURCE_FILE" );
+		_initParameter( GEOMETRY_CACHE_DIRECTORY, "GEOMETRY_CACHE_DIRECTORY" );
+		_initParameter( INTERMEDIATE_TABLES, "INTERMEDIATE_TABLES" );
 		_initParameter( BOUNDARY_TYPE_INLAND_WATER_BOUNDARY, "BOUNDARY_TYPE_INLAND_WATER_BOUNDARY" );
 		_initParameter( AREA_TABLE_INIT, "AREA_TABLE_INIT" );
 		_initParameter( AREA_TABLE_INIT_BASE, "AREA_TABLE_INIT_BASE" );
@@ -38,6 +42,23 @@ namespace params{
 		_initParameter( AU_COAST_SEARCH_DIST, "AU_COAST_SEARCH_DIST" );
 		_initParameter( AU_COAST_SNAP_DIST, "AU_COAST_SNAP_DIST" );
 		_initParameter( AU_SEGMENT_MIN_LENGTH, "AU_SEGMENT_MIN_LENGTH" );
+		_initParameter( AU_FEATURE_TIME_BUDGET, "AU_FEATURE_TIME_BUDGET" );
+		_initParameter( AU_PIPELINE_QUEUE_SIZE, "AU_PIPELINE_QUEUE_SIZE" );
+		_initParameter( AU_SPATIAL_ORDER, "AU_SPATIAL_ORDER" );
+		_initParameter( AU_BOUNDARY_TILE_SIZE, "AU_BOUNDARY_TILE_SIZE" );
+		_initParameter( AU_BOUNDARY_TILE_CACHE_SIZE, "AU_BOUNDARY_TILE_CACHE_SIZE" );
+		_initParameter( AU_MANIFEST_DIRECTORY, "AU_MANIFEST_DIRECTORY" );
+		_initParameter( AU_CHECKPOINT_DIRECTORY, "AU_CHECKPOINT_DIRECTORY" );
+		_initParameter( AU_CHECKPOINT_INTERVAL, "AU_CHECKPOINT_INTERVAL" );
+		_initParameter( AU_RESUME, "AU_RESUME" );
+		_initParameter( AU_SHARD_COUNT, "AU_SHARD_COUNT" );
+		_initParameter( AU_TARGET_IDS, "AU_TARGET_IDS" );
+		_initParameter( AU_TARGET_BBOX, "AU_TARGET_BBOX" );
+		_initParameter( AU_TARGET_SOURCE_TABLE, "AU_TARGET_SOURCE_TABLE" );
+		_initParameter( AU_PREFILTER_CHECK, "AU_PREFILTER_CHECK" );
+
+		_initParameter( ALLOCATION_TRACKING, "ALLOCATION_TRACKING" );
+		_initParameter( ALLOCATION_TRACKING_TOP_K, "ALLOCATION_TRACKING_TOP_K" );
 	}
 
 	///
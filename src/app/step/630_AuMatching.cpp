@@ -1,10 +1,12 @@
 #include <app/step/630_AuMatching.h>
 
-// EPG
-#include <ome2/utils/CopyTableUtils.h>
-
 // APP
 #include <app/calcul/AuMatchingOp.h>
+#include <app/io/Checkpoint.h>
+#include <app/io/DataSourceManager.h>
+
+// EPG
+#include <epg/log/EpgLogger.h>
 
 namespace app {
 	namespace step {
@@ -22,15 +24,32 @@ namespace app {
 		///
 		void AuMatching::onCompute(bool verbose = false)
 		{
-			// copie 
-			_epgParams.setParameter(AREA_TABLE, ign::data::String(getCurrentWorkingTableName(AREA_TABLE_INIT)));
-			ome2::utils::CopyTableUtils::copyAreaTable(getLastWorkingTableName(AREA_TABLE_INIT), "", false, true);
-
-			// traitement
 			app::params::ThemeParameters* themeParameters = app::params::ThemeParametersS::getInstance();
 			std::string countryCodeW = themeParameters->getParameter(COUNTRY_CODE_W).getValue().toString();
 
-			app::calcul::AuMatchingOp::Compute(countryCodeW, verbose);
+			// copie (sauf en reprise : la table de travail contient deja les resultats valides,
+			// et en relance ciblee)
+			std::string const currentTableName = getCurrentWorkingTableName(AREA_TABLE_INIT);
+			_epgParams.setParameter(AREA_TABLE, ign::data::String(currentTableName));
+
+			bool const resume = themeParameters->getValue(AU_RESUME).toString() == "1" 
+				&& io::Checkpoint::Exists(app::calcul::AuMatchingOp::CheckpointPath(countryCodeW), currentTableName);
+			// relance ciblee : les objets selectionnes sont recalcules a partir de la table d'entree
+			// et reecrits dans la table de travail existante
+			bool const targeted = !themeParameters->getValue(AU_TARGET_IDS).toString().empty() 
+				|| !themeParameters->getValue(AU_TARGET_BBOX).toString().empty();
+			if ( targeted ) {
+				themeParameters->setParameter(AU_TARGET_SOURCE_TABLE, ign::data::String(getLastWorkingTableName(AREA_TABLE_INIT)));
+				epg::log::EpgLoggerS::getInstance()->log(epg::log::INFO, "targeted run on " + currentTableName);
+			} else if ( resume ) {
+				epg::log::EpgLoggerS::getInstance()->log(epg::log::INFO, "resuming " + currentTableName + " from checkpoint");
+			} else {
+				io::DataSourceManagerS::getInstance()->getDataSource()->copyAreaTable(getLastWorkingTableName(AREA_TABLE_INIT), currentTableName);
+			}
+
+			// traitement
+
+			app::calcul::AuMatchingOp::Compute(countryCodeW, verbose, _sharedIndexes);
 
 		}
 
@@ -0,0 +1,303 @@
+//APP
+#include <app/tools/AllocationTracker.h>
+
+//STL
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+#include <sstream>
+
+//SYSTEM
+#include <malloc.h>
+
+//EPG
+#include <epg/log/EpgLogger.h>
+
+
+namespace app{
+namespace tools{
+namespace detail{
+
+    //--
+    struct AllocationCounters
+    {
+        size_t                                             numAllocations;
+        size_t                                             numDeallocations;
+        size_t                                             allocatedBytes;
+        long long                                          liveBytes;
+        long long                                          peakLiveBytes;
+    };
+
+    //-- initialisation statique (pas de garde) : utilisable depuis operator new
+    thread_local AllocationCounters                        tlsCounters = { 0, 0, 0, 0, 0 };
+
+    //--
+    AllocationTracker::Level                               level = AllocationTracker::NONE;
+
+#ifdef APP_ALLOCATION_TRACKING
+    //--
+    inline void* allocate( size_t size )
+    {
+        void* ptr = std::malloc( size == 0 ? 1 : size );
+        if ( ptr == 0 ) return 0;
+
+        AllocationCounters & counters = tlsCounters;
+        size_t const usableSize = malloc_usable_size( ptr );
+        ++counters.numAllocations;
+        counters.allocatedBytes += usableSize;
+        counters.liveBytes += usableSize;
+        if ( counters.liveBytes > counters.peakLiveBytes ) counters.peakLiveBytes = counters.liveBytes;
+        return ptr;
+    }
+
+    //--
+    inline void deallocate( void* ptr )
+    {
+        if ( ptr == 0 ) return;
+
+        AllocationCounters & counters = tlsCounters;
+        ++counters.numDeallocations;
+        counters.liveBytes -= malloc_usable_size( ptr );
+        std::free( ptr );
+    }
+#endif
+}
+
+    ///
+	///
+	///
+    std::string AllocationStats::toString() const
+    {
+        std::ostringstream ss;
+        ss << "allocations=" << numAllocations 
+            << " deallocations=" << numDeallocations
+            << " allocated_bytes=" << allocatedBytes
+            << " live_bytes=" << liveBytes
+            << " peak_live_bytes=" << peakLiveBytes;
+        return ss.str();
+    }
+
+    ///
+	///
+	///
+    bool AllocationTracker::IsAvailable()
+    {
+#ifdef APP_ALLOCATION_TRACKING
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    ///
+	///
+	///
+    void AllocationTracker::SetLevel( Level level )
+    {
+        detail::level = level;
+    }
+
+    ///
+	///
+	///
+    AllocationTracker::Level AllocationTracker::GetLevel()
+    {
+        return detail::level;
+    }
+
+    ///
+	///
+	///
+    AllocationStats AllocationTracker::Current()
+    {
+        detail::AllocationCounters const& counters = detail::tlsCounters;
+        AllocationStats stats;
+        stats.numAllocations = counters.numAllocations;
+        stats.numDeallocations = counters.numDeallocations;
+        stats.allocatedBytes = counters.allocatedBytes;
+        stats.liveBytes = counters.liveBytes;
+        stats.peakLiveBytes = counters.peakLiveBytes;
+        return stats;
+    }
+
+    ///
+	///
+	///
+    AllocationScope::AllocationScope():
+        _start( AllocationTracker::Current() ),
+        _outerPeak( _start.peakLiveBytes )
+    {
+        // le pic est mesure a partir du volume vivant courant
+        detail::tlsCounters.peakLiveBytes = _start.liveBytes;
+    }
+
+    ///
+	///
+	///
+    AllocationScope::~AllocationScope()
+    {
+        detail::tlsCounters.peakLiveBytes = std::max( _outerPeak, detail::tlsCounters.peakLiveBytes );
+    }
+
+    ///
+	///
+	///
+    AllocationStats AllocationScope::stats() const
+    {
+        AllocationStats current = AllocationTracker::Current();
+        AllocationStats stats;
+        stats.numAllocations = current.numAllocations - _start.numAllocations;
+        stats.numDeallocations = current.numDeallocations - _start.numDeallocations;
+        stats.allocatedBytes = current.allocatedBytes - _start.allocatedBytes;
+        stats.liveBytes = current.liveBytes - _start.liveBytes;
+        stats.peakLiveBytes = current.peakLiveBytes - _start.liveBytes;
+        return stats;
+    }
+
+    ///
+	///
+	///
+    AllocationPhase::AllocationPhase( std::string const& name ):
+        _name( name )
+    {
+    }
+
+    ///
+	///
+	///
+    AllocationPhase::~AllocationPhase()
+    {
+        if ( !AllocationTracker::IsAvailable() || AllocationTracker::GetLevel() < AllocationTracker::PHASE ) return;
+
+        epg::log::EpgLoggerS::getInstance()->log( epg::log::INFO, "[ALLOC] " + _name + " : " + _scope.stats().toString() );
+    }
+
+    ///
+	///
+	///
+    AllocationRanking::AllocationRanking( size_t size ):
+        _size( size )
+    {
+    }
+
+    ///
+	///
+	///
+    void AllocationRanking::add( std::string const& id, AllocationStats const& stats )
+    {
+        if ( _size == 0 ) return;
+        if ( _heap.size() == _size && stats.allocatedBytes <= _heap.top().first ) return;
+
+        _heap.push( std::make_pair( stats.allocatedBytes, std::make_pair( id, stats ) ) );
+        if ( _heap.size() > _size ) _heap.pop();
+    }
+
+    ///
+	///
+	///
+    void AllocationRanking::log( std::string const& title ) const
+    {
+        std::priority_queue< Entry, std::vector< Entry >, EntryGreater > heap = _heap;
+        std::vector< Entry > vEntries;
+        while ( !heap.empty() ) {
+            vEntries.push_back( heap.top() );
+            heap.pop();
+        }
+
+        epg::log::EpgLogger* logger = epg::log::EpgLoggerS::getInstance();
+        for ( size_t i = vEntries.size() ; i > 0 ; --i ) {
+            std::ostringstream ss;
+            ss << "[ALLOC] " << title << " #" << vEntries.size() - i + 1 
+                << " [id] " << vEntries[i-1].second.first << " : " << vEntries[i-1].second.second.toString();
+            logger->log( epg::log::INFO, ss.str() );
+        }
+    }
+
+}
+}
+
+#ifdef APP_ALLOCATION_TRACKING
+    ///
+	///
+	///
+    void* operator new( size_t size )
+    {
+        void* ptr = app::tools::detail::allocate( size );
+        if ( ptr == 0 ) throw std::bad_alloc();
+        return ptr;
+    }
+
+    ///
+	///
+	///
+    void* operator new[]( size_t size )
+    {
+        void* ptr = app::tools::detail::allocate( size );
+        if ( ptr == 0 ) throw std::bad_alloc();
+        return ptr;
+    }
+
+    ///
+	///
+	///
+    void* operator new( size_t size, std::nothrow_t const& ) noexcept
+    {
+        return app::tools::detail::allocate( size );
+    }
+
+    ///
+	///
+	///
+    void* operator new[]( size_t size, std::nothrow_t const& ) noexcept
+    {
+        return app::tools::detail::allocate( size );
+    }
+
+    ///
+	///
+	///
+    void operator delete( void* ptr ) noexcept
+    {
+        app::tools::detail::deallocate( ptr );
+    }
+
+    ///
+	///
+	///
+    void operator delete[]( void* ptr ) noexcept
+    {
+        app::tools::detail::deallocate( ptr );
+    }
+
+    ///
+	///
+	///
+    void operator delete( void* ptr, size_t ) noexcept
+    {
+        app::tools::detail::deallocate( ptr );
+    }
+
+    ///
+	///
+	///
+    void operator delete[]( void* ptr, size_t ) noexcept
+    {
+        app::tools::detail::deallocate( ptr );
+    }
+
+    ///
+	///
+	///
+    void operator delete( void* ptr, std::nothrow_t const& ) noexcept
+    {
+        app::tools::detail::deallocate( ptr );
+    }
+
+    ///
+	///
+	///
+    void operator delete[]( void* ptr, std::nothrow_t const& ) noexcept
+    {
+        app::tools::detail::deallocate( ptr );
+    }
+#endif
@@ -0,0 +1,189 @@
+//APP
+#include <app/tools/LocalTileCache.h>
+#include <app/tools/Hash64.h>
+
+//STL
+#include <algorithm>
+#include <cmath>
+
+
+namespace app{
+namespace detail{
+
+    //-- empreinte des coordonnees d'une portion
+    uint64_t pieceHash( ign::geometry::LineString const& ls )
+    {
+        app::tools::Hash64 hash;
+        for ( size_t i = 0 ; i < ls.numPoints() ; ++i ) {
+            double const xy[] = { ls.pointN(i).x(), ls.pointN(i).y() };
+            hash.add( xy, sizeof( xy ) );
+        }
+        return hash.value();
+    }
+
+    //--
+    bool sameCoordinates( ign::geometry::LineString const& ls1, ign::geometry::LineString const& ls2 )
+    {
+        if ( ls1.numPoints() != ls2.numPoints() ) return false;
+        for ( size_t i = 0 ; i < ls1.numPoints() ; ++i ) {
+            if ( ls1.pointN(i).x() != ls2.pointN(i).x() || ls1.pointN(i).y() != ls2.pointN(i).y() ) return false;
+        }
+        return true;
+    }
+}
+
+namespace tools{
+
+    ///
+	///
+	///
+    LocalTileCache::LocalTileCache(
+        epg::tools::MultiLineStringTool const* tool,
+        double tileSize,
+        size_t maxTiles
+    ):
+        _tool( tool ),
+        _tileSize( tileSize ),
+        _maxTiles( std::max( maxTiles, size_t(1) ) ),
+        _numQueries( 0 ),
+        _numHits( 0 ),
+        _numMisses( 0 )
+    {
+    }
+
+    ///
+	///
+	///
+    void LocalTileCache::getLocal(
+        ign::geometry::Envelope const& envelope,
+        std::vector< ign::geometry::LineString const* > & vLs
+    ) {
+        vLs.clear();
+
+        if ( _tileSize <= 0 ) {
+            _mlsLocal = ign::geometry::MultiLineString();
+            _tool->getLocal( envelope, _mlsLocal );
+            for ( size_t i = 0 ; i < _mlsLocal.numGeometries() ; ++i )
+                vLs.push_back( &_mlsLocal.lineStringN(i) );
+            return;
+        }
+
+        // les tuiles de la requete precedente ne sont evincees qu'ici : les vues
+        // restituees restent valides jusqu'a l'appel suivant
+        _evict();
+
+        ++_numQueries;
+        int64_t const imin = _index( envelope.xmin() ), imax = _index( envelope.xmax() );
+        int64_t const jmin = _index( envelope.ymin() ), jmax = _index( envelope.ymax() );
+        for ( int64_t i = imin ; i <= imax ; ++i ) {
+            for ( int64_t j = jmin ; j <= jmax ; ++j ) {
+                Tile const& tile = _getTile( TileKey( i, j ) );
+                for ( size_t k = 0 ; k < tile.vPieces.size() ; ++k ) {
+                    // une portion a cheval sur plusieurs tuiles n'est restituee qu'une fois
+                    Piece* piece = tile.vPieces[k];
+                    if ( piece->lastQuery == _numQueries || !piece->envelope.intersects( envelope ) ) continue;
+                    piece->lastQuery = _numQueries;
+                    vLs.push_back( &piece->ls );
+                }
+            }
+        }
+    }
+
+    ///
+	///
+	///
+    int64_t LocalTileCache::_index( double value ) const
+    {
+        return static_cast< int64_t >( std::floor( value / _tileSize ) );
+    }
+
+    ///
+	///
+	///
+    LocalTileCache::Tile const& LocalTileCache::_getTile( TileKey const& key )
+    {
+        std::map< TileKey, Tile >::iterator mit = _mTiles.find( key );
+        if ( mit != _mTiles.end() ) {
+            ++_numHits;
+            _lru.splice( _lru.begin(), _lru, mit->second.lruPosition );
+            return mit->second;
+        }
+        ++_numMisses;
+
+        Tile & tile = _mTiles[key];
+        _lru.push_front( key );
+        tile.lruPosition = _lru.begin();
+
+        // tuile legerement elargie : les arrondis de _index ne peuvent pas ecarter une portion
+        ign::geometry::Envelope tileEnvelope(
+            ign::geometry::Point( key.first * _tileSize, key.second * _tileSize ),
+            ign::geometry::Point( ( key.first + 1 ) * _tileSize, ( key.second + 1 ) * _tileSize )
+        );
+        tileEnvelope.expandBy( _tileSize * 1e-6 );
+        ign::geometry::MultiLineString mls;
+        _tool->getLocal( tileEnvelope, mls );
+
+        // des portions de coordonnees identiques (objets sources distincts de meme
+        // geometrie) sont extraites ensemble par chaque tuile : elles sont distinguees
+        // par leur rang parmi les portions identiques de l'extraction
+        tile.vPieces.reserve( mls.numGeometries() );
+        for ( size_t i = 0 ; i < mls.numGeometries() ; ++i ) {
+            ign::geometry::LineString const& ls = mls.lineStringN(i);
+            uint64_t const hash = detail::pieceHash( ls );
+            size_t occurrence = 0;
+            for ( size_t k = 0 ; k < tile.vPieces.size() ; ++k )
+                if ( tile.vPieces[k]->hash == hash && detail::sameCoordinates( tile.vPieces[k]->ls, ls ) ) ++occurrence;
+            tile.vPieces.push_back( _getPiece( ls, hash, occurrence ) );
+        }
+        return tile;
+    }
+
+    ///
+	///
+	///
+    LocalTileCache::Piece* LocalTileCache::_getPiece( ign::geometry::LineString const& ls, uint64_t hash, size_t occurrence )
+    {
+        // portion deja extraite pour une autre tuile
+        std::pair< std::multimap< uint64_t, Piece >::iterator, std::multimap< uint64_t, Piece >::iterator > range = _mPieces.equal_range( hash );
+        for ( std::multimap< uint64_t, Piece >::iterator mit = range.first ; mit != range.second ; ++mit ) {
+            if ( mit->second.occurrence != occurrence || !detail::sameCoordinates( mit->second.ls, ls ) ) continue;
+            ++mit->second.numTiles;
+            return &mit->second;
+        }
+
+        std::multimap< uint64_t, Piece >::iterator mit = _mPieces.insert( std::make_pair( hash, Piece() ) );
+        Piece & piece = mit->second;
+        piece.ls = ls;
+        piece.envelope = ls.getEnvelope();
+        piece.hash = hash;
+        piece.occurrence = occurrence;
+        piece.numTiles = 1;
+        piece.lastQuery = 0;
+        return &piece;
+    }
+
+    ///
+	///
+	///
+    void LocalTileCache::_evict()
+    {
+        while ( _mTiles.size() > _maxTiles ) {
+            std::map< TileKey, Tile >::iterator tit = _mTiles.find( _lru.back() );
+            for ( size_t i = 0 ; i < tit->second.vPieces.size() ; ++i ) {
+                Piece* piece = tit->second.vPieces[i];
+                if ( --piece->numTiles > 0 ) continue;
+
+                std::pair< std::multimap< uint64_t, Piece >::iterator, std::multimap< uint64_t, Piece >::iterator > range = _mPieces.equal_range( piece->hash );
+                for ( std::multimap< uint64_t, Piece >::iterator mit = range.first ; mit != range.second ; ++mit ) {
+                    if ( &mit->second != piece ) continue;
+                    _mPieces.erase( mit );
+                    break;
+                }
+            }
+            _mTiles.erase( tit );
+            _lru.pop_back();
+        }
+    }
+
+}
+}
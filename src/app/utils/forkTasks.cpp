@@ -0,0 +1,88 @@
+// APP
+#include <app/utils/forkTasks.h>
+
+// STL
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <map>
+
+// SOCLE
+#include <ign/Exception.h>
+
+// EPG
+#include <epg/log/EpgLogger.h>
+#include <epg/tools/TimeTools.h>
+
+// POSIX
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+
+namespace app{
+namespace utils{
+
+    //--
+    std::vector< size_t > forkTasks(
+        std::vector< std::string > const& vLabels,
+        size_t parallelism,
+        std::function< int ( size_t ) > const& task
+    ) {
+        epg::log::EpgLogger* logger = epg::log::EpgLoggerS::getInstance();
+        if ( parallelism == 0 ) parallelism = 1;
+
+        std::vector< size_t > vFailures;
+        std::map< pid_t, size_t > mRunning;
+        size_t next = 0;
+
+        // les sorties en attente ne doivent pas etre dupliquees dans les processus fils
+        std::cout.flush();
+
+        while ( next < vLabels.size() || !mRunning.empty() ) {
+            while ( next < vLabels.size() && mRunning.size() < parallelism ) {
+                size_t const index = next++;
+
+                pid_t const pid = fork();
+                if ( pid == 0 ) {
+                    int status = 1;
+                    try {
+                        status = task( index );
+                    } catch ( ign::Exception & e ) {
+                        logger->log( epg::log::ERROR, vLabels[index] + " : " + std::string( e.diagnostic() ) );
+                    } catch ( std::exception & e ) {
+                        logger->log( epg::log::ERROR, vLabels[index] + " : " + std::string( e.what() ) );
+                    } catch ( ... ) {}
+                    std::cout.flush();
+                    _exit( status );
+                }
+                if ( pid < 0 )
+                    IGN_THROW_EXCEPTION( "[ app::utils::forkTasks ] unable to start process for '" + vLabels[index] + "' : " + std::strerror( errno ) );
+
+                mRunning[pid] = index;
+                logger->log( epg::log::INFO, "[START] " + vLabels[index] + " (pid " + std::to_string( pid ) + "): " + epg::tools::TimeTools::getTime() );
+            }
+
+            int status = 0;
+            pid_t const pid = waitpid( -1, &status, 0 );
+            if ( pid < 0 ) {
+                if ( errno == EINTR ) continue;
+                IGN_THROW_EXCEPTION( std::string( "[ app::utils::forkTasks ] waitpid failed : " ) + std::strerror( errno ) );
+            }
+
+            std::map< pid_t, size_t >::iterator mit = mRunning.find( pid );
+            if ( mit == mRunning.end() ) continue;
+
+            if ( WIFEXITED( status ) && WEXITSTATUS( status ) == 0 ) {
+                logger->log( epg::log::INFO, "[END] " + vLabels[mit->second] + ": " + epg::tools::TimeTools::getTime() );
+            } else {
+                logger->log( epg::log::ERROR, "[FAILED] " + vLabels[mit->second] + " (status " + std::to_string( status ) + "): " + epg::tools::TimeTools::getTime() );
+                vFailures.push_back( mit->second );
+            }
+            mRunning.erase( mit );
+        }
+
+        return vFailures;
+    }
+}
+}
@@ -0,0 +1,77 @@
+// APP
+#include <app/utils/readParameterGrid.h>
+
+// STL
+#include <cstdlib>
+#include <fstream>
+
+// SOCLE
+#include <ign/Exception.h>
+
+// EPG
+#include <epg/tools/StringTools.h>
+
+
+namespace app{
+namespace utils{
+namespace detail{
+
+    //--
+    std::string trim( std::string const& value )
+    {
+        size_t const first = value.find_first_not_of( " \t\r" );
+        if ( first == std::string::npos ) return "";
+        return value.substr( first, value.find_last_not_of( " \t\r" ) - first + 1 );
+    }
+}
+
+    //--
+    std::vector< ParameterSet > readParameterGrid(
+        std::string const& path
+    ) {
+        std::ifstream ifs( path.c_str() );
+        if ( !ifs )
+            IGN_THROW_EXCEPTION( "[ app::utils::readParameterGrid ] unable to open '" + path + "'" );
+
+        std::vector< std::pair< std::string, std::vector< std::string > > > vAxes;
+        std::string line;
+        while ( std::getline( ifs, line ) ) {
+            line = detail::trim( line );
+            if ( line.empty() || line[0] == '#' ) continue;
+
+            size_t const pos = line.find( '=' );
+            if ( pos == std::string::npos )
+                IGN_THROW_EXCEPTION( "[ app::utils::readParameterGrid ] invalid line in '" + path + "' : " + line );
+
+            std::vector< std::string > vTokens, vValues;
+            epg::tools::StringTools::Split( line.substr( pos + 1 ), ",", vTokens );
+            for ( size_t i = 0 ; i < vTokens.size() ; ++i ) {
+                std::string const value = detail::trim( vTokens[i] );
+                char* end = 0;
+                std::strtod( value.c_str(), &end );
+                if ( value.empty() || *end != '\0' )
+                    IGN_THROW_EXCEPTION( "[ app::utils::readParameterGrid ] invalid value '" + value + "' in '" + path + "'" );
+                vValues.push_back( value );
+            }
+            if ( vValues.empty() )
+                IGN_THROW_EXCEPTION( "[ app::utils::readParameterGrid ] no value in '" + path + "' : " + line );
+
+            vAxes.push_back( std::make_pair( detail::trim( line.substr( 0, pos ) ), vValues ) );
+        }
+
+        // produit cartesien
+        std::vector< ParameterSet > vSets( 1 );
+        for ( size_t a = 0 ; a < vAxes.size() ; ++a ) {
+            std::vector< ParameterSet > vNewSets;
+            for ( size_t s = 0 ; s < vSets.size() ; ++s ) {
+                for ( size_t v = 0 ; v < vAxes[a].second.size() ; ++v ) {
+                    vNewSets.push_back( vSets[s] );
+                    vNewSets.back().push_back( std::make_pair( vAxes[a].first, vAxes[a].second[v] ) );
+                }
+            }
+            vSets.swap( vNewSets );
+        }
+        return vSets;
+    }
+}
+}
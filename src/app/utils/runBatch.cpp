@@ -0,0 +1,41 @@
+// APP
+#include <app/utils/runBatch.h>
+#include <app/utils/forkTasks.h>
+
+// POSIX
+#include <unistd.h>
+
+
+namespace app{
+namespace utils{
+
+    //--
+    std::vector< std::string > runBatch(
+        std::string const& executable,
+        std::vector< std::string > const& vArgs,
+        std::vector< std::string > const& vCountries,
+        size_t parallelism
+    ) {
+        // arguments prepares avant le fork : le processus fils ne fait qu'executer
+        std::vector< std::vector< std::string > > vvChildArgs( vCountries.size(), vArgs );
+        std::vector< std::vector< char* > > vvArgv( vCountries.size() );
+        for ( size_t c = 0 ; c < vCountries.size() ; ++c ) {
+            vvChildArgs[c].push_back( vCountries[c] );
+            vvArgv[c].push_back( const_cast< char* >( executable.c_str() ) );
+            for ( size_t i = 0 ; i < vvChildArgs[c].size() ; ++i )
+                vvArgv[c].push_back( const_cast< char* >( vvChildArgs[c][i].c_str() ) );
+            vvArgv[c].push_back( 0 );
+        }
+
+        std::vector< size_t > vFailedIndex = forkTasks( vCountries, parallelism, [&]( size_t c ) {
+            execvp( executable.c_str(), vvArgv[c].data() );
+            return 127;
+        } );
+
+        std::vector< std::string > vFailures;
+        for ( size_t i = 0 ; i < vFailedIndex.size() ; ++i )
+            vFailures.push_back( vCountries[vFailedIndex[i]] );
+        return vFailures;
+    }
+}
+}
@@ -1,3 +1,7 @@
+//STL
+#include <cstdlib>
+#include <memory>
+#include <set>
 
 //BOOST
 #include <boost/program_options.hpp>
@@ -6,6 +10,7 @@
 #include <epg/Context.h>
 #include <epg/log/EpgLogger.h>
 #include <epg/log/ShapeLogger.h>
+#include <epg/tools/StringTools.h>
 #include <epg/tools/TimeTools.h>
 #include <epg/params/tools/loadParameters.h>
 
@@ -13,11 +18,33 @@
 #include <ome2/utils/setTableName.h>
 
 //APP
+#include <app/calcul/AuMatchingOp.h>
+#include <app/calcul/AuMatchingSweep.h>
+#include <app/calcul/ContextBundle.h>
+#include <app/io/DataSourceManager.h>
+#include <app/io/IntermediateDataSource.h>
+#include <app/io/RecordingDataSource.h>
+#include <app/io/ReplayDataSource.h>
+#include <app/io/SnapshotDataSource.h>
 #include <app/params/ThemeParameters.h>
 #include <app/step/tools/initSteps.h>
+#include <app/tools/AllocationTracker.h>
+#include <app/utils/readParameterGrid.h>
+#include <app/utils/runBatch.h>
 
 namespace po = boost::program_options;
 
+namespace {
+
+    //-- structures preparees de l'etape 630, conservees d'un niveau a l'autre : liberees
+    //-- en sortie de portee, y compris sur exception
+    struct IndexesGuard {
+        IndexesGuard( app::calcul::AuMatchingIndexes& indexes ): _indexes( indexes ) {}
+        ~IndexesGuard() { _indexes.clear(); }
+        app::calcul::AuMatchingIndexes& _indexes;
+    };
+}
+
 int main(int argc, char *argv[])
 {
     epg::Context* context = epg::ContextS::getInstance();
@@ -29,10 +56,24 @@ int main(int argc, char *argv[])
     std::string     stepCode = "";
     std::string     countryCode = "";
     std::string     level = "";
+    std::string     recordDirectory = "";
+    std::string     replayDirectory = "";
+    std::string     snapshotDirectory = "";
+    std::string     sweepFile = "";
+    std::string     targetIdsFile = "";
+    std::string     targetBbox = "";
+    std::string     dumpAuId = "";
+    std::string     replayBundleDirectory = "";
+    size_t          parallelism = 1;
+    size_t          numLoops = 1;
+    bool            resume = false;
     bool            verbose = true;
 
+    //structures preparees de l'etape 630 partagees par les niveaux administratifs traites
+    app::calcul::AuMatchingIndexes sharedIndexes;
+
     epg::step::StepSuite< app::params::ThemeParametersS > stepSuite;
-    app::step::tools::initSteps(stepSuite);
+    app::step::tools::initSteps(stepSuite, &sharedIndexes);
 
     std::ostringstream OperatorDetail;
 	OperatorDetail << "set step :" << std::endl
@@ -43,18 +84,27 @@ int main(int argc, char *argv[])
         ("help", "produce help message")
         ("c", po::value< std::string >(&epgParametersFile)     , "conf file" )
         ("d", po::value< std::string >(&dbName)                , "data base name" )
-        ("l", po::value< std::string >(&level)                 , "administrative level" )
+        ("l", po::value< std::string >(&level)                 , "administrative level(s), comma separated (e.g. 3,4)" )
         ("s", po::value< std::string >(&suffix)                , "working table suffix" )
         ("sp", po::value< std::string >(&stepCode), OperatorDetail.str().c_str())
+        ("record", po::value< std::string >(&recordDirectory)  , "record the reads in the given directory" )
+        ("replay", po::value< std::string >(&replayDirectory)  , "serve the reads from a record directory (writes are discarded)" )
+        ("resume", po::bool_switch(&resume)                    , "resume step 630 from its last checkpoint" )
+        ("j", po::value< size_t >(&parallelism)                , "number of countries (batch mode) or parameter sets (sweep mode) processed simultaneously" )
+        ("sweep", po::value< std::string >(&sweepFile)         , "evaluate the parameter grid of the given file on step 630 without writing anything" )
+        ("ids", po::value< std::string >(&targetIdsFile)       , "rerun step 630 in place on the administrative units listed in the given file" )
+        ("bbox", po::value< std::string >(&targetBbox)         , "rerun step 630 in place on the administrative units intersecting xmin,ymin,xmax,ymax" )
+        ("dump-context", po::value< std::string >(&dumpAuId)   , "write the step 630 context of the given administrative unit to a replay bundle (in the log directory)" )
+        ("replay-bundle", po::value< std::string >(&replayBundleDirectory), "run step 630 on a replay bundle, without database" )
+        ("loops", po::value< size_t >(&numLoops)               , "number of runs of the replay bundle (profiling)" )
+        ("snapshot", po::value< std::string >(&snapshotDirectory), "read the shared tables from a snapshot directory (set by the batch mode)" )
     ;
 
     stepCode = stepSuite.getStepsRange();
 
-    //main log
+    //main log (ouvert une fois le pays connu : un fichier par pays en mode batch)
     std::string     logFileName = "log.txt";
-    std::ofstream   logFile( logFileName.c_str() ) ;
-
-    logFile << "[START] " << epg::tools::TimeTools::getTime() << std::endl;
+    std::ofstream   logFile;
 
     int returnValue = 0;
     try{
@@ -75,23 +125,56 @@ int main(int argc, char *argv[])
         // Récupérer les arguments libres (non reconnus)
         std::vector<std::string> countries = po::collect_unrecognized(parsed.options, po::include_positional);
 
-        if ( countries.size() != 1 ) {
-            std::string mError = "spécifier un et un seul pays en argument";
+        if ( countries.empty() ) {
+            std::string mError = "spécifier au moins un pays en argument";
             IGN_THROW_EXCEPTION(mError);
         }
+        // plusieurs pays : mode batch, les parametres et les noms de tables sont
+        // ceux du premier pays, chaque pays est traite par un processus dedie
+        bool const batch = countries.size() > 1;
         countryCode = countries.front();
 
+        if ( !snapshotDirectory.empty() ) logFileName = "log_" + countryCode + ".txt";
+        logFile.open( logFileName.c_str() );
+        logFile << "[START] " << epg::tools::TimeTools::getTime() << std::endl;
+
+        if ( !recordDirectory.empty() && !replayDirectory.empty() ) {
+            std::string mError = "les options record et replay sont exclusives";
+            IGN_THROW_EXCEPTION(mError);
+        }
+        if ( batch && ( !recordDirectory.empty() || !replayDirectory.empty() || !snapshotDirectory.empty() || !targetIdsFile.empty() || !targetBbox.empty() ) ) {
+            std::string mError = "les options record, replay, snapshot, ids et bbox ne s'appliquent qu'a un seul pays";
+            IGN_THROW_EXCEPTION(mError);
+        }
+        if ( !targetIdsFile.empty() && !targetBbox.empty() ) {
+            std::string mError = "les options ids et bbox sont exclusives";
+            IGN_THROW_EXCEPTION(mError);
+        }
+        //contexte de calcul d'une unite administrative (etape 630) : s'appuie sur l'enregistrement ou le rejeu des lectures
+        bool const bundle = !dumpAuId.empty() || !replayBundleDirectory.empty();
+        if ( bundle && ( batch || !recordDirectory.empty() || !replayDirectory.empty() || !sweepFile.empty() || !targetIdsFile.empty() || !targetBbox.empty() || resume ) ) {
+            std::string mError = "les options dump-context et replay-bundle ne s'appliquent qu'a un seul pays et sont incompatibles avec les options record, replay, sweep, ids, bbox et resume";
+            IGN_THROW_EXCEPTION(mError);
+        }
+        if ( !dumpAuId.empty() && !replayBundleDirectory.empty() ) {
+            std::string mError = "les options dump-context et replay-bundle sont exclusives";
+            IGN_THROW_EXCEPTION(mError);
+        }
+        if ( !replayBundleDirectory.empty() ) replayDirectory = replayBundleDirectory;
+
         //parametres EPG
 		context->loadEpgParameters( epgParametersFile );
 
         //Initialisation du log de prod
         logDirectory = context->getConfigParameters().getValue( LOG_DIRECTORY ).toString();
+        //processus d'un batch : un repertoire de log par pays
+        if ( !snapshotDirectory.empty() ) logDirectory += "/" + countryCode;
 
         //test si le dossier de log existe sinon le creer
         boost::filesystem::path logDir(logDirectory);
         if (!boost::filesystem::is_directory(logDir))
         {
-            if (!boost::filesystem::create_directory(logDir))
+            if (!boost::filesystem::create_directories(logDir))
             {
                 std::string mError = "the directory " + logDirectory + " cannot be created";
                 IGN_THROW_EXCEPTION(mError);
@@ -101,49 +184,222 @@ int main(int argc, char *argv[])
         //repertoire de travail
         context->setLogDirectory( logDirectory );
 
+        std::string const dumpDirectory = dumpAuId.empty() ? "" : logDirectory + "/630_" + countryCode + "_" + dumpAuId;
+        if ( !dumpDirectory.empty() ) recordDirectory = dumpDirectory;
+
         //theme parameters
         themeParametersFile = context->getConfigParameters().getValue( THEME_PARAMETER_FILE ).toString();
 		app::params::ThemeParameters* themeParameters = app::params::ThemeParametersS::getInstance();
         epg::params::tools::loadParams( *themeParameters, themeParametersFile, countryCode );
+        if ( !replayBundleDirectory.empty() ) app::calcul::ContextBundle::LoadParameters( replayBundleDirectory );
         if ( themeParameters->getValue(COAST_TABLE).toString() == "" )
             themeParameters->setParameter(COAST_TABLE, ign::data::String(themeParameters->getValue(AREA_TABLE_INIT).toString() + themeParameters->getValue(COAST_TABLE_SUFFIX).toString()));
         if ( themeParameters->getValue(NOCOAST_TABLE).toString() == "" ) 
             themeParameters->setParameter(NOCOAST_TABLE, ign::data::String(themeParameters->getValue(AREA_TABLE_INIT).toString() + themeParameters->getValue(NOCOAST_TABLE_SUFFIX).toString()));
+        if ( resume ) {
+            if ( themeParameters->getValue(AU_CHECKPOINT_DIRECTORY).toString().empty() ) {
+                std::string mError = "l'option resume necessite le parametre AU_CHECKPOINT_DIRECTORY";
+                IGN_THROW_EXCEPTION(mError);
+            }
+            themeParameters->setParameter(AU_RESUME, ign::data::String("1"));
+        }
+        //relance ciblee de l'etape 630
+        bool const targeted = !targetIdsFile.empty() || !targetBbox.empty();
+        if ( targeted ) {
+            if ( !sweepFile.empty() || resume ) {
+                std::string mError = "les options ids et bbox sont incompatibles avec les options sweep et resume";
+                IGN_THROW_EXCEPTION(mError);
+            }
+            themeParameters->setParameter(AU_TARGET_IDS, ign::data::String(targetIdsFile));
+            themeParameters->setParameter(AU_TARGET_BBOX, ign::data::String(targetBbox));
+            stepCode = "630";
+        }
 
         //info de connection db
-        context->loadEpgParameters( themeParameters->getValue(DB_CONF_FILE).toString() );
-        if( dbName != "" )
-            context->getConfigParameters().setParameter(DATABASE, ign::data::String(dbName));
+        bool const usePostgis = replayDirectory.empty() && ( themeParameters->getValue(DATA_SOURCE).toString().empty() || themeParameters->getValue(DATA_SOURCE).toString() == "postgis" );
+        if ( usePostgis ) {
+            context->loadEpgParameters( themeParameters->getValue(DB_CONF_FILE).toString() );
+            if( dbName != "" )
+                context->getConfigParameters().setParameter(DATABASE, ign::data::String(dbName));
+        }
 
         //epg logger
         epg::log::EpgLogger* logger = epg::log::EpgLoggerS::getInstance();
         // logger->setProdOfstream( logDirectory+"/au_matching.log" );
         logger->setDevOfstream( logDirectory+"/au_matching.log" );
+
+        //suivi des allocations
+        int allocationTracking = static_cast<int>( themeParameters->getValue(ALLOCATION_TRACKING).toDouble() );
+        if ( allocationTracking > 0 && !app::tools::AllocationTracker::IsAvailable() ) {
+            logger->log(epg::log::WARN, "ALLOCATION_TRACKING ignored : application not compiled with the ALLOCATION_TRACKING option");
+            allocationTracking = 0;
+        }
+        app::tools::AllocationTracker::SetLevel( static_cast<app::tools::AllocationTracker::Level>( std::min( allocationTracking, 2 ) ) );
         
-        //table de travail
-        if ( !suffix.empty() ) {
+        //table de travail (une par niveau administratif)
+        std::vector<std::string> vLevels;
+        epg::tools::StringTools::Split( level.empty() ? themeParameters->getValue(LOWEST_LEVEL).toString() : level, ",", vLevels );
+        if ( vLevels.empty() ) vLevels.push_back( "" );
+        if ( vLevels.size() > 1 && suffix.empty() ) {
+            std::string mError = "le traitement de plusieurs niveaux necessite l'option s";
+            IGN_THROW_EXCEPTION(mError);
+        }
+        if ( vLevels.size() > 1 && ( targeted || bundle ) ) {
+            std::string mError = "les options ids, bbox, dump-context et replay-bundle ne s'appliquent qu'a un seul niveau";
+            IGN_THROW_EXCEPTION(mError);
+        }
+        auto areaTableName = [&]( std::string const& tableLevel ) {
             std::string tableBaseName = themeParameters->getValue(AREA_TABLE_INIT_BASE).toString();
-            level = level.empty() ? themeParameters->getValue(LOWEST_LEVEL).toString() : level;
             std::string levelTemplate = "<LEVEL>";
             size_t pos = tableBaseName.find(levelTemplate);
             if (pos != std::string::npos) {
-                tableBaseName.replace(pos, levelTemplate.length(), level);
+                tableBaseName.replace(pos, levelTemplate.length(), tableLevel);
             }
-            std::string tableName = tableBaseName + "_" + countryCode + "_" + suffix;
-            themeParameters->setParameter(AREA_TABLE_INIT, ign::data::String(tableName));
+            return tableBaseName + "_" + countryCode + "_" + suffix;
+        };
+        //rejeu : table enregistree dans le contexte
+        if ( !suffix.empty() && replayBundleDirectory.empty() ) {
+            themeParameters->setParameter(AREA_TABLE_INIT, ign::data::String(areaTableName(vLevels.front())));
         }
 
         //set BDD search path
-        context->getDataBaseManager().setSearchPath(themeParameters->getValue(WORKING_SCHEMA).toString());
+        if ( usePostgis )
+            context->getDataBaseManager().setSearchPath(themeParameters->getValue(WORKING_SCHEMA).toString());
         ome2::utils::setTableName<app::params::ThemeParametersS>(AREA_TABLE_INIT);
         ome2::utils::setTableName<app::params::ThemeParametersS>(LANDMASK_TABLE);
         ome2::utils::setTableName<epg::params::EpgParametersS>(TARGET_BOUNDARY_TABLE);
 
+        if ( batch ) {
+            //instantane des tables partagees (frontieres, masque terrestre) partitionne par pays
+            epg::params::EpgParameters const& epgParams = context->getEpgParameters();
+            std::string const snapshotPath = logDirectory + "/snapshot";
+
+            std::vector< app::io::SnapshotDataSource::TableSpec > vTables( 2 );
+            vTables[0].table = themeParameters->getValue(LANDMASK_TABLE).toString();
+            vTables[0].partitionAttribute = epgParams.getValue(COUNTRY_CODE).toString();
+            vTables[1].table = epgParams.getValue(TARGET_BOUNDARY_TABLE).toString();
+            vTables[1].partitionAttribute = epgParams.getValue(COUNTRY_CODE).toString();
+
+            std::vector< std::string > vAttributes;
+            vAttributes.push_back( epgParams.getValue(BOUNDARY_TYPE).toString() );
+            vAttributes.push_back( themeParameters->getValue(LAND_COVER_TYPE).toString() );
+
+            logger->log(epg::log::INFO, "[START] snapshot: " + epg::tools::TimeTools::getTime());
+            {
+                std::unique_ptr< app::io::DataSource > dataSource( app::io::DataSourceManager::NewDataSource() );
+                app::io::SnapshotDataSource::Build( *dataSource, snapshotPath, vTables, std::set< std::string >( countries.begin(), countries.end() ), vAttributes );
+            }
+            logger->log(epg::log::INFO, "[END] snapshot: " + epg::tools::TimeTools::getTime());
+
+            //arguments communs : ceux de la ligne de commande, hors pays et parallelisme
+            std::vector< std::string > vArgs;
+            for ( size_t i = 0 ; i < parsed.options.size() ; ++i ) {
+                if ( parsed.options[i].unregistered || parsed.options[i].position_key >= 0 || parsed.options[i].string_key == "j" ) continue;
+                vArgs.insert( vArgs.end(), parsed.options[i].original_tokens.begin(), parsed.options[i].original_tokens.end() );
+            }
+            vArgs.push_back( "--snapshot" );
+            vArgs.push_back( snapshotPath );
+
+            std::vector< std::string > vFailures = app::utils::runBatch( argv[0], vArgs, countries, parallelism );
+            boost::filesystem::remove_all( snapshotPath );
+
+            if ( !vFailures.empty() ) {
+                std::string mError = "echec du traitement des pays :";
+                for ( size_t i = 0 ; i < vFailures.size() ; ++i ) mError += " " + vFailures[i];
+                IGN_THROW_EXCEPTION(mError);
+            }
+        } else {
+            //source de donnees : rejeu des lectures ou source decrite par DATA_SOURCE
+            app::io::DataSource* dataSource = 0;
+            if ( !replayDirectory.empty() ) {
+                dataSource = new app::io::ReplayDataSource( replayDirectory );
+                logger->log(epg::log::INFO, "replaying reads from " + replayDirectory);
+            } else {
+                dataSource = app::io::DataSourceManager::NewDataSource();
+            }
+
+            //tables partagees lues dans l'instantane construit par le mode batch
+            if ( !snapshotDirectory.empty() ) {
+                dataSource = new app::io::SnapshotDataSource( dataSource, snapshotDirectory );
+                logger->log(epg::log::INFO, "reading shared tables from snapshot " + snapshotDirectory);
+            }
+
+            //tables intermediaires conservees en memoire entre les etapes
+            std::string const intermediateTables = themeParameters->getValue(INTERMEDIATE_TABLES).toString();
+            app::io::IntermediateDataSource* intermediateDataSource = 0;
+            if ( intermediateTables == "memory" || intermediateTables == "memory_only" ) {
+                std::vector< std::string > vTables;
+                vTables.push_back( themeParameters->getValue(COAST_TABLE).toString() );
+                vTables.push_back( themeParameters->getValue(NOCOAST_TABLE).toString() );
+                intermediateDataSource = new app::io::IntermediateDataSource( dataSource, vTables, intermediateTables == "memory" );
+                dataSource = intermediateDataSource;
+            } else if ( !intermediateTables.empty() && intermediateTables != "database" ) {
+                delete dataSource;
+                std::string mError = "valeur inconnue pour INTERMEDIATE_TABLES : " + intermediateTables + " (database, memory ou memory_only)";
+                IGN_THROW_EXCEPTION(mError);
+            }
+
+            //enregistrement des lectures
+            if ( !recordDirectory.empty() ) {
+                epg::params::EpgParameters const& epgParams = context->getEpgParameters();
+                std::vector< std::string > vAttributes;
+                vAttributes.push_back( epgParams.getValue(COUNTRY_CODE).toString() );
+                vAttributes.push_back( epgParams.getValue(BOUNDARY_TYPE).toString() );
+                vAttributes.push_back( themeParameters->getValue(LAND_COVER_TYPE).toString() );
+                dataSource = new app::io::RecordingDataSource( dataSource, recordDirectory, vAttributes );
+                logger->log(epg::log::INFO, "recording reads in " + recordDirectory);
+            }
+            app::io::DataSourceManagerS::getInstance()->setDataSource( dataSource );
+
+            //index des codes pays de la table des frontieres, lue par pays a chaque etape
+            dataSource->createCodeIndex( context->getEpgParameters().getValue(TARGET_BOUNDARY_TABLE).toString(), context->getEpgParameters().getValue(COUNTRY_CODE).toString() );
 
-        logger->log(epg::log::INFO, "[ START AU MATCHING PROCESS ] " + epg::tools::TimeTools::getTime());
 
-        //lancement du traitement
-		stepSuite.run(stepCode, verbose);
+            logger->log(epg::log::INFO, "[ START AU MATCHING PROCESS ] " + epg::tools::TimeTools::getTime());
+
+            //balayage des parametres de l'etape 630 sur la table initiale (niveau le plus bas demande)
+            if ( !sweepFile.empty() ) {
+                std::vector< app::utils::ParameterSet > vParameterSets = app::utils::readParameterGrid( sweepFile );
+                context->getEpgParameters().setParameter( AREA_TABLE, ign::data::String( themeParameters->getValue(AREA_TABLE_INIT).toString() ) );
+                app::calcul::AuMatchingSweep::Compute( countryCode, vParameterSets, parallelism, logDirectory + "/630_" + countryCode + "_sweep.csv" );
+            } else if ( bundle ) {
+                //contexte de calcul d'une unite administrative de la table initiale
+                context->getEpgParameters().setParameter( AREA_TABLE, ign::data::String( themeParameters->getValue(AREA_TABLE_INIT).toString() ) );
+                if ( !dumpDirectory.empty() )
+                    app::calcul::ContextBundle::Dump( countryCode, dumpAuId, dumpDirectory );
+                else
+                    app::calcul::ContextBundle::Replay( countryCode, replayBundleDirectory, numLoops );
+            } else {
+                //lancement du traitement : toutes les etapes pour le premier niveau, la seule
+                //etape 630 (dependante du niveau) pour les suivants, avec les index du premier
+                bool multiLevel = false;
+                if ( vLevels.size() > 1 ) {
+                    std::vector<std::string> vRanges;
+                    epg::tools::StringTools::Split( stepCode, ",", vRanges );
+                    for ( size_t i = 0 ; i < vRanges.size() ; ++i ) {
+                        size_t const pos = vRanges[i].find('-');
+                        int const first = std::atoi( vRanges[i].substr(0, pos).c_str() );
+                        int const last = pos == std::string::npos ? first : std::atoi( vRanges[i].substr(pos+1).c_str() );
+                        if ( first <= 630 && 630 <= last ) multiLevel = true;
+                    }
+                }
+                IndexesGuard indexesGuard( sharedIndexes );
+
+                if ( multiLevel ) logger->log(epg::log::INFO, "[ LEVEL " + vLevels.front() + " ] " + epg::tools::TimeTools::getTime());
+                stepSuite.run(stepCode, verbose);
+
+                for ( size_t i = 1 ; multiLevel && i < vLevels.size() ; ++i ) {
+                    themeParameters->setParameter(AREA_TABLE_INIT, ign::data::String(areaTableName(vLevels[i])));
+                    ome2::utils::setTableName<app::params::ThemeParametersS>(AREA_TABLE_INIT);
+
+                    logger->log(epg::log::INFO, "[ LEVEL " + vLevels[i] + " ] " + epg::tools::TimeTools::getTime());
+                    stepSuite.run("630", verbose);
+                }
+            }
+
+            //fin de l'enregistrement des tables intermediaires
+            if ( intermediateDataSource ) intermediateDataSource->finish();
+        }
 
 		logger->log(epg::log::INFO, "[ END AU MATCHING PROCESS ] " + epg::tools::TimeTools::getTime());
     }
@@ -164,6 +420,7 @@ int main(int argc, char *argv[])
 
     logFile << "[END] " << epg::tools::TimeTools::getTime() << std::endl;
 
+    app::io::DataSourceManagerS::kill();
     epg::ContextS::kill();
     epg::log::EpgLoggerS::kill();
     epg::log::ShapeLoggerS::kill();
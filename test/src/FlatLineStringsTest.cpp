@@ -0,0 +1,119 @@
+//STL
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+//SOCLE
+#include <ign/geometry.h>
+
+//APP
+#include <app/tools/FlatLineStrings.h>
+
+namespace {
+
+    //-- tolerance de contact de extractNotTouchingParts
+    double const TOLERANCE = 0.1;
+
+    //-- ecart admis entre les deux calculs (coordonnees de l'ordre de 1e6 en EPSG:3035)
+    double const EPSILON = 1e-8;
+
+    //-- ecart a la tolerance des points places de part et d'autre du seuil
+    double const MARGIN = 1e-6;
+
+    //-- origine des coordonnees de test
+    double const X0 = 4321000.;
+    double const Y0 = 3210000.;
+
+    //-- compare la distance calculee sur les tableaux a celle du socle (segment construit
+    //-- en LineString, comme avant l'indexation a plat), ainsi que la decision de contact
+    bool check(
+        app::tools::FlatLineStrings const& flat,
+        size_t segment,
+        ign::geometry::Point const& point,
+        std::string const& label
+    ) {
+        double const flatDistance = flat.segmentDistance( segment, point.x(), point.y() );
+        double const ignDistance = ign::geometry::LineString( flat.pointN(segment), flat.pointN(segment+1) ).distance( point );
+
+        bool const sameDistance = std::abs( flatDistance - ignDistance ) <= EPSILON;
+        bool const sameContact = ( flatDistance <= TOLERANCE ) == ( ignDistance <= TOLERANCE );
+        if ( sameDistance && sameContact ) return true;
+
+        std::cerr.precision( 17 );
+        std::cerr << label << " : segment " << segment << ", point (" << point.x() << "," << point.y() << ") : "
+            << flatDistance << " instead of " << ignDistance << std::endl;
+        return false;
+    }
+
+}
+
+/// @brief Verifie que FlatLineStrings::segmentDistance restitue la distance du socle
+/// (ign::geometry) et la meme decision de contact a la tolerance de 0.1 utilisee par
+/// extractNotTouchingParts : segments degeneres, points alignes avec le segment de
+/// part et d'autre du seuil et points aleatoires
+int main()
+{
+    app::tools::FlatLineStrings flat;
+    std::vector< size_t > vSegments;
+
+    // segments quelconques
+    std::mt19937 generator( 42 );
+    std::uniform_real_distribution< double > offset( -50., 50. );
+    ign::geometry::LineString ls;
+    for ( size_t i = 0 ; i < 200 ; ++i ) ls.addPoint( ign::geometry::Point( X0 + 10. * i + offset( generator ), Y0 + offset( generator ) ) );
+    flat.add( ls );
+    for ( size_t i = flat.begin(0) ; i+1 < flat.end(0) ; ++i ) vSegments.push_back( i );
+
+    // segments degeneres (points confondus) et tres courts
+    ign::geometry::LineString degenerated;
+    degenerated.addPoint( ign::geometry::Point( X0, Y0 ) );
+    degenerated.addPoint( ign::geometry::Point( X0, Y0 ) );
+    degenerated.addPoint( ign::geometry::Point( X0 + 1e-9, Y0 ) );
+    degenerated.addPoint( ign::geometry::Point( X0 + 1e-9, Y0 + 1e-9 ) );
+    flat.add( degenerated );
+
+    size_t numFailures = 0;
+
+    // points aleatoires au voisinage de chaque segment
+    std::uniform_real_distribution< double > near( -0.3, 0.3 );
+    for ( size_t k = 0 ; k < vSegments.size() ; ++k ) {
+        size_t const i = vSegments[k];
+        for ( size_t n = 0 ; n < 20 ; ++n ) {
+            ign::geometry::Point const point( flat.x(i) + near( generator ) * ( 1 + n ), flat.y(i) + near( generator ) * ( 1 + n ) );
+            if ( !check( flat, i, point, "random" ) ) ++numFailures;
+        }
+    }
+
+    // points alignes avec le segment, au-dela de ses extremites, de part et d'autre de la tolerance
+    double const vDistances[] = { TOLERANCE - MARGIN, TOLERANCE + MARGIN, 0., 0.05, 0.2 };
+    for ( size_t k = 0 ; k < vSegments.size() ; ++k ) {
+        size_t const i = vSegments[k];
+        double const dx = flat.x(i+1) - flat.x(i), dy = flat.y(i+1) - flat.y(i);
+        double const length = std::sqrt( dx*dx + dy*dy );
+        for ( double distance : vDistances ) {
+            if ( !check( flat, i, ign::geometry::Point( flat.x(i+1) + distance * dx / length, flat.y(i+1) + distance * dy / length ), "collinear after end" ) ) ++numFailures;
+            if ( !check( flat, i, ign::geometry::Point( flat.x(i) - distance * dx / length, flat.y(i) - distance * dy / length ), "collinear before start" ) ) ++numFailures;
+            // a la perpendiculaire du milieu du segment
+            if ( !check( flat, i, ign::geometry::Point( flat.x(i) + 0.5 * dx - distance * dy / length, flat.y(i) + 0.5 * dy + distance * dx / length ), "perpendicular" ) ) ++numFailures;
+        }
+    }
+
+    // segments degeneres
+    for ( size_t i = flat.begin(1) ; i+1 < flat.end(1) ; ++i ) {
+        for ( double distance : vDistances ) {
+            if ( !check( flat, i, ign::geometry::Point( flat.x(i) + distance, flat.y(i) ), "degenerated" ) ) ++numFailures;
+            if ( !check( flat, i, ign::geometry::Point( flat.x(i) - distance * M_SQRT1_2, flat.y(i) + distance * M_SQRT1_2 ), "degenerated" ) ) ++numFailures;
+        }
+    }
+
+    if ( numFailures > 0 ) {
+        std::cerr << "FlatLineStrings : " << numFailures << " mismatches" << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::cout << "FlatLineStrings : OK" << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,143 @@
+//STL
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+//SOCLE
+#include <ign/geometry.h>
+
+//EPG
+#include <epg/tools/MultiLineStringTool.h>
+
+//APP
+#include <app/tools/LocalTileCache.h>
+
+namespace {
+
+    //-- cote des tuiles
+    double const TILE_SIZE = 100.;
+
+    //-- polylignes traversant de nombreuses tuiles : horizontales, diagonales, anneau,
+    //-- ainsi que des copies et des lignes superposees (frontieres partagees)
+    ign::geometry::MultiLineString makeLines()
+    {
+        ign::geometry::MultiLineString mls;
+        for ( int k = 0 ; k < 8 ; ++k ) {
+            ign::geometry::LineString ls;
+            for ( int i = 0 ; i <= 300 ; ++i )
+                ls.addPoint( ign::geometry::Point( -250. + 5. * i, 37. + 100. * k + 20. * std::sin( 0.1 * i ) ) );
+            mls.addGeometry( ls );
+        }
+        for ( int k = 0 ; k < 4 ; ++k ) {
+            ign::geometry::LineString ls;
+            for ( int i = 0 ; i <= 200 ; ++i )
+                ls.addPoint( ign::geometry::Point( -100. + 250. * k + 4. * i, -50. + 4.5 * i ) );
+            mls.addGeometry( ls );
+        }
+        ign::geometry::LineString ring;
+        for ( int i = 0 ; i < 360 ; ++i )
+            ring.addPoint( ign::geometry::Point( 500. + 333. * std::cos( i * M_PI / 180. ), 400. + 333. * std::sin( i * M_PI / 180. ) ) );
+        ign::geometry::Point const start = ring.startPoint();
+        ring.addPoint( start );
+        mls.addGeometry( ring );
+
+        // meme geometrie portee par deux et trois objets distincts
+        ign::geometry::LineString const shared = mls.lineStringN(2);
+        mls.addGeometry( shared );
+        mls.addGeometry( ring );
+        mls.addGeometry( ring );
+
+        // ligne superposee a une partie de la precedente, dans le meme sens et en sens inverse
+        ign::geometry::LineString overlapping, reversed;
+        for ( size_t i = 50 ; i <= 220 ; ++i ) overlapping.addPoint( shared.pointN(i) );
+        for ( size_t i = 220 ; i >= 120 ; --i ) reversed.addPoint( shared.pointN(i) );
+        mls.addGeometry( overlapping );
+        mls.addGeometry( reversed );
+        return mls;
+    }
+
+    //-- representation canonique d'une portion
+    std::string toString( ign::geometry::LineString const& ls )
+    {
+        std::ostringstream ss;
+        ss.precision( 17 );
+        for ( size_t i = 0 ; i < ls.numPoints() ; ++i )
+            ss << ls.pointN(i).x() << " " << ls.pointN(i).y() << ",";
+        return ss.str();
+    }
+
+    //-- compare les portions restituees par le cache a l'extraction directe
+    bool check( epg::tools::MultiLineStringTool const& tool, app::tools::LocalTileCache & cache, ign::geometry::Envelope const& envelope )
+    {
+        ign::geometry::MultiLineString mlsExpected;
+        tool.getLocal( envelope, mlsExpected );
+        std::vector< std::string > vExpected;
+        for ( size_t i = 0 ; i < mlsExpected.numGeometries() ; ++i )
+            vExpected.push_back( toString( mlsExpected.lineStringN(i) ) );
+
+        std::vector< ign::geometry::LineString const* > vLs;
+        cache.getLocal( envelope, vLs );
+        std::vector< std::string > vFound;
+        for ( size_t i = 0 ; i < vLs.size() ; ++i )
+            vFound.push_back( toString( *vLs[i] ) );
+
+        std::sort( vExpected.begin(), vExpected.end() );
+        std::sort( vFound.begin(), vFound.end() );
+        if ( vExpected == vFound ) return true;
+
+        std::cerr << "mismatch on envelope (" << envelope.xmin() << "," << envelope.ymin() << "," << envelope.xmax() << "," << envelope.ymax() << ") : "
+            << vFound.size() << " pieces, " << vExpected.size() << " expected" << std::endl;
+        return false;
+    }
+
+}
+
+/// @brief Verifie que LocalTileCache restitue les memes portions que
+/// MultiLineStringTool::getLocal, en nombre et en coordonnees, y compris pour
+/// les portions a cheval sur plusieurs tuiles, les portions de meme geometrie
+/// issues d'objets distincts, les lignes superposees et apres eviction des tuiles
+int main()
+{
+    ign::geometry::MultiLineString mls = makeLines();
+    epg::tools::MultiLineStringTool tool( mls );
+
+    // emprises alignees sur les bords des tuiles, a cheval et aleatoires
+    std::vector< ign::geometry::Envelope > vEnvelopes;
+    vEnvelopes.push_back( ign::geometry::Envelope( ign::geometry::Point( 0., 0. ), ign::geometry::Point( TILE_SIZE, TILE_SIZE ) ) );
+    vEnvelopes.push_back( ign::geometry::Envelope( ign::geometry::Point( 99., 30. ), ign::geometry::Point( 101., 45. ) ) );
+    vEnvelopes.push_back( ign::geometry::Envelope( ign::geometry::Point( -300., -300. ), ign::geometry::Point( 1300., 1300. ) ) );
+    std::mt19937 generator( 42 );
+    std::uniform_real_distribution< double > position( -300., 1200. );
+    std::uniform_real_distribution< double > size( 0., 350. );
+    for ( size_t i = 0 ; i < 2000 ; ++i ) {
+        double const x = position( generator ), y = position( generator );
+        vEnvelopes.push_back( ign::geometry::Envelope( ign::geometry::Point( x, y ), ign::geometry::Point( x + size( generator ), y + size( generator ) ) ) );
+    }
+
+    // sans cache, cache suffisant et cache reduit (evictions frequentes)
+    size_t const vMaxTiles[] = { 1024, 4 };
+    std::vector< app::tools::LocalTileCache* > vCaches;
+    vCaches.push_back( new app::tools::LocalTileCache( &tool, 0., 1 ) );
+    for ( size_t maxTiles : vMaxTiles )
+        vCaches.push_back( new app::tools::LocalTileCache( &tool, TILE_SIZE, maxTiles ) );
+
+    size_t numFailures = 0;
+    for ( size_t i = 0 ; i < vCaches.size() ; ++i ) {
+        for ( size_t j = 0 ; j < vEnvelopes.size() ; ++j ) {
+            if ( !check( tool, *vCaches[i], vEnvelopes[j] ) ) ++numFailures;
+        }
+        delete vCaches[i];
+    }
+
+    if ( numFailures > 0 ) {
+        std::cerr << "LocalTileCache : " << numFailures << " mismatches" << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::cout << "LocalTileCache : OK" << std::endl;
+    return EXIT_SUCCESS;
+}
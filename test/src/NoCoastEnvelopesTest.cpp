@@ -0,0 +1,175 @@
+//STL
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+//SOCLE
+#include <ign/geometry.h>
+
+//APP
+#include <app/detail/getNoCoastEnvelopes.h>
+
+namespace {
+
+    //-- distance de recherche (AU_BOUNDARY_SEARCH_DIST)
+    double const SEARCH_DIST = 80.;
+
+    //-- cote des mailles de la partition en unites administratives
+    double const AU_SIZE = 1000.;
+
+    //-- nombre de mailles de la partition par cote (pays de 200 km x 200 km)
+    size_t const NUM_AU = 200;
+
+    //-- frontiere terrestre : ligne brisee sinueuse le long de la diagonale du pays,
+    //-- decoupee en nbParts portions, et une enclave fermee
+    ign::geometry::MultiLineString makeBoundary( size_t nbParts )
+    {
+        std::mt19937 generator( 42 );
+        std::uniform_real_distribution< double > noise( -300., 300. );
+
+        size_t const numPoints = 4000;
+        std::vector< ign::geometry::Point > vPoints;
+        for ( size_t i = 0 ; i <= numPoints ; ++i ) {
+            double const t = NUM_AU * AU_SIZE * i / numPoints;
+            vPoints.push_back( ign::geometry::Point( t + 5000. * std::sin( t / 20000. ) + noise( generator ), t + noise( generator ) ) );
+        }
+
+        ign::geometry::MultiLineString mls;
+        size_t const partSize = numPoints / nbParts;
+        for ( size_t k = 0 ; k < nbParts ; ++k ) {
+            ign::geometry::LineString ls;
+            for ( size_t i = k * partSize ; i <= std::min( ( k + 1 ) * partSize, numPoints ) ; ++i ) ls.addPoint( vPoints[i] );
+            mls.addGeometry( ls );
+        }
+
+        ign::geometry::LineString enclave;
+        for ( int i = 0 ; i < 100 ; ++i )
+            enclave.addPoint( ign::geometry::Point( 150000. + 3000. * std::cos( i * M_PI / 50. ), 40000. + 3000. * std::sin( i * M_PI / 50. ) ) );
+        ign::geometry::Point const start = enclave.startPoint();
+        enclave.addPoint( start );
+        mls.addGeometry( enclave );
+        return mls;
+    }
+
+    //-- distance d'un point a un segment
+    double segmentDistance( ign::geometry::Point const& p, ign::geometry::Point const& a, ign::geometry::Point const& b )
+    {
+        double const dx = b.x() - a.x(), dy = b.y() - a.y();
+        double const length2 = dx*dx + dy*dy;
+        double t = length2 > 0 ? ( ( p.x() - a.x() ) * dx + ( p.y() - a.y() ) * dy ) / length2 : 0;
+        t = std::min( std::max( t, 0. ), 1. );
+        double const ex = p.x() - a.x() - t * dx, ey = p.y() - a.y() - t * dy;
+        return std::sqrt( ex*ex + ey*ey );
+    }
+
+    //-- distance d'un point a une emprise (nulle a l'interieur)
+    double envelopeDistance( ign::geometry::Point const& p, ign::geometry::Envelope const& envelope )
+    {
+        double const dx = std::max( std::max( envelope.xmin() - p.x(), p.x() - envelope.xmax() ), 0. );
+        double const dy = std::max( std::max( envelope.ymin() - p.y(), p.y() - envelope.ymax() ), 0. );
+        return std::sqrt( dx*dx + dy*dy );
+    }
+
+    //-- le segment [a,b] traverse-t-il l'emprise (decoupage de Liang-Barsky)
+    bool crosses( ign::geometry::Point const& a, ign::geometry::Point const& b, ign::geometry::Envelope const& envelope )
+    {
+        double const dx = b.x() - a.x(), dy = b.y() - a.y();
+        double const vP[] = { -dx, dx, -dy, dy };
+        double const vQ[] = { a.x() - envelope.xmin(), envelope.xmax() - a.x(), a.y() - envelope.ymin(), envelope.ymax() - a.y() };
+        double t0 = 0., t1 = 1.;
+        for ( size_t k = 0 ; k < 4 ; ++k ) {
+            if ( vP[k] == 0 ) {
+                if ( vQ[k] < 0 ) return false;
+                continue;
+            }
+            double const r = vQ[k] / vP[k];
+            if ( vP[k] < 0 ) t0 = std::max( t0, r );
+            else t1 = std::min( t1, r );
+            if ( t0 > t1 ) return false;
+        }
+        return true;
+    }
+
+    //-- la maille est-elle a moins de distance de la frontiere (distance exacte entre
+    //-- l'emprise et chaque segment)
+    bool isNearBoundary( ign::geometry::MultiLineString const& mls, ign::geometry::Envelope const& envelope, double distance )
+    {
+        ign::geometry::Point const vCorners[] = {
+            ign::geometry::Point( envelope.xmin(), envelope.ymin() ), ign::geometry::Point( envelope.xmax(), envelope.ymin() ),
+            ign::geometry::Point( envelope.xmax(), envelope.ymax() ), ign::geometry::Point( envelope.xmin(), envelope.ymax() )
+        };
+        for ( size_t i = 0 ; i < mls.numGeometries() ; ++i ) {
+            ign::geometry::LineString const& ls = mls.lineStringN(i);
+            for ( size_t j = 0 ; j + 1 < ls.numPoints() ; ++j ) {
+                ign::geometry::Point const& a = ls.pointN(j);
+                ign::geometry::Point const& b = ls.pointN(j+1);
+                if ( std::min( a.x(), b.x() ) > envelope.xmax() + distance || std::max( a.x(), b.x() ) < envelope.xmin() - distance ) continue;
+                if ( std::min( a.y(), b.y() ) > envelope.ymax() + distance || std::max( a.y(), b.y() ) < envelope.ymin() - distance ) continue;
+
+                if ( envelopeDistance( a, envelope ) <= distance || envelopeDistance( b, envelope ) <= distance ) return true;
+                if ( crosses( a, b, envelope ) ) return true;
+                for ( size_t c = 0 ; c < 4 ; ++c )
+                    if ( segmentDistance( vCorners[c], a, b ) <= distance ) return true;
+            }
+        }
+        return false;
+    }
+
+    //-- la maille intersecte-t-elle l'une des emprises du prefiltre
+    bool isSelected( std::vector< ign::geometry::Envelope > const& vEnvelopes, ign::geometry::Envelope const& envelope )
+    {
+        for ( size_t i = 0 ; i < vEnvelopes.size() ; ++i )
+            if ( vEnvelopes[i].intersects( envelope ) ) return true;
+        return false;
+    }
+
+}
+
+/// @brief Verifie que le prefiltre spatial de lecture des unites administratives
+/// (getNoCoastEnvelopes) retient toute unite administrative situee a moins de la
+/// distance de recherche d'une portion hors cotes, avec et sans fusion des emprises,
+/// et mesure sa selectivite sur une partition reguliere du pays
+int main()
+{
+    size_t numFailures = 0;
+
+    // frontiere en quelques portions (emprises non fusionnees) ou en nombreuses portions (fusion)
+    size_t const vNbParts[] = { 4, 40, 400 };
+    for ( size_t nbParts : vNbParts ) {
+        ign::geometry::MultiLineString const mls = makeBoundary( nbParts );
+        std::vector< ign::geometry::Envelope > const vEnvelopes = app::detail::getNoCoastEnvelopes( mls, SEARCH_DIST );
+        if ( vEnvelopes.size() > 64 ) {
+            std::cerr << nbParts << " parts : " << vEnvelopes.size() << " envelopes" << std::endl;
+            ++numFailures;
+        }
+
+        size_t numSelected = 0, numNearBoundary = 0, numMissing = 0;
+        for ( size_t i = 0 ; i < NUM_AU ; ++i ) {
+            for ( size_t j = 0 ; j < NUM_AU ; ++j ) {
+                ign::geometry::Envelope const au( ign::geometry::Point( i * AU_SIZE, j * AU_SIZE ), ign::geometry::Point( ( i + 1 ) * AU_SIZE, ( j + 1 ) * AU_SIZE ) );
+                bool const selected = isSelected( vEnvelopes, au );
+                if ( selected ) ++numSelected;
+                if ( !isNearBoundary( mls, au, SEARCH_DIST ) ) continue;
+                ++numNearBoundary;
+                if ( selected ) continue;
+                std::cerr << nbParts << " parts : unit (" << i << "," << j << ") near the boundary not selected" << std::endl;
+                ++numMissing;
+            }
+        }
+        numFailures += numMissing;
+
+        std::cout << "NoCoastEnvelopes : " << nbParts + 1 << " lines, " << vEnvelopes.size() << " envelopes, "
+            << numSelected << " selected, " << numNearBoundary << " near the boundary, " << NUM_AU * NUM_AU << " units ("
+            << 100. * numSelected / ( NUM_AU * NUM_AU ) << "% selected)" << std::endl;
+    }
+
+    if ( numFailures > 0 ) {
+        std::cerr << "NoCoastEnvelopes : " << numFailures << " failures" << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::cout << "NoCoastEnvelopes : OK" << std::endl;
+    return EXIT_SUCCESS;
+}